@@ -0,0 +1,79 @@
+#include <benchmark/benchmark.h>
+
+#include <Helpers/Delegate.hpp>
+
+using namespace acid;
+
+static void Delegate_Invoke(benchmark::State &state) {
+	Delegate<void(float)> delegate;
+	std::vector<std::unique_ptr<Observer>> observers;
+	float total = 0.0f;
+
+	// Half of the functions are tied to an observer, like components listening to input.
+	for (int64_t i = 0; i < state.range(0); i++) {
+		if (i % 2 == 0) {
+			observers.emplace_back(std::make_unique<Observer>());
+			delegate.Add([&total](float value) {
+				total += value;
+			}, observers.back().get());
+		} else {
+			delegate.Add([&total](float value) {
+				total -= value;
+			});
+		}
+	}
+
+	for (auto _ : state) {
+		delegate(1.0f);
+	}
+
+	benchmark::DoNotOptimize(total);
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(Delegate_Invoke)->Arg(1)->Arg(10)->Arg(1000);
+
+static void Delegate_InvokeExpired(benchmark::State &state) {
+	Delegate<void(float)> delegate;
+	std::vector<std::unique_ptr<Observer>> observers;
+	float total = 0.0f;
+
+	for (int64_t i = 0; i < state.range(0); i++) {
+		if (i % 2 == 0) {
+			observers.emplace_back(std::make_unique<Observer>());
+			delegate.Add([&total](float value) {
+				total += value;
+			}, observers.back().get());
+		} else {
+			delegate.Add([&total](float value) {
+				total -= value;
+			});
+		}
+	}
+
+	// Destroying every observer leaves half the functions expired, the first invoke compacts them.
+	observers.clear();
+
+	for (auto _ : state) {
+		delegate(1.0f);
+	}
+
+	benchmark::DoNotOptimize(total);
+	state.counters["remaining"] = static_cast<double>(delegate.GetSize());
+}
+BENCHMARK(Delegate_InvokeExpired)->Arg(1)->Arg(10)->Arg(1000);
+
+static void Delegate_Add(benchmark::State &state) {
+	for (auto _ : state) {
+		Delegate<void()> delegate;
+
+		for (int64_t i = 0; i < state.range(0); i++) {
+			delegate.Add([]() {
+			});
+		}
+
+		benchmark::DoNotOptimize(delegate.GetSize());
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(Delegate_Add)->Arg(1000);
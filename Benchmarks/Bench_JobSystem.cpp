@@ -0,0 +1,95 @@
+#include <benchmark/benchmark.h>
+
+#include <Helpers/JobSystem.hpp>
+
+using namespace acid;
+
+static void Fork(JobSystem &jobSystem, Job &parent, std::atomic<uint32_t> &leaves, uint32_t depth) {
+	if (depth == 0) {
+		leaves++;
+		return;
+	}
+
+	for (uint32_t i = 0; i < 2; i++) {
+		jobSystem.Run(jobSystem.CreateChild(parent, [&jobSystem, &leaves, depth](Job &job) {
+			Fork(jobSystem, job, leaves, depth - 1);
+		}));
+	}
+}
+
+static void JobSystem_Run(benchmark::State &state) {
+	JobSystem jobSystem;
+	std::atomic<uint64_t> count = 0;
+
+	for (auto _ : state) {
+		JobCounter counter;
+
+		for (int64_t i = 0; i < state.range(0); i++) {
+			jobSystem.Run([&count]() {
+				count++;
+			}, &counter);
+		}
+
+		jobSystem.Wait(counter);
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(JobSystem_Run)->Arg(1000)->UseRealTime();
+
+static void JobSystem_RunFromWorker(benchmark::State &state) {
+	JobSystem jobSystem;
+	std::atomic<uint64_t> count = 0;
+
+	// Submitting from a worker uses the lock-free deques instead of the shared queue.
+	for (auto _ : state) {
+		JobCounter counter;
+		jobSystem.Run([&](Job &parent) {
+			for (int64_t i = 0; i < state.range(0); i++) {
+				jobSystem.Run(jobSystem.CreateChild(parent, [&count]() {
+					count++;
+				}));
+			}
+		}, &counter);
+
+		jobSystem.Wait(counter);
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(JobSystem_RunFromWorker)->Arg(1000)->UseRealTime();
+
+static void JobSystem_ForkJoin(benchmark::State &state) {
+	JobSystem jobSystem;
+	std::atomic<uint32_t> leaves = 0;
+	auto depth = static_cast<uint32_t>(state.range(0));
+
+	for (auto _ : state) {
+		JobCounter counter;
+		jobSystem.Run([&](Job &job) {
+			Fork(jobSystem, job, leaves, depth);
+		}, &counter);
+
+		jobSystem.Wait(counter);
+	}
+
+	state.SetItemsProcessed(state.iterations() * (int64_t(1) << depth));
+}
+BENCHMARK(JobSystem_ForkJoin)->Arg(12)->UseRealTime();
+
+static void JobSystem_ParallelFor(benchmark::State &state) {
+	JobSystem jobSystem;
+	std::vector<float> values(static_cast<std::size_t>(state.range(0)), 1.0f);
+
+	for (auto _ : state) {
+		jobSystem.ParallelFor(static_cast<uint32_t>(values.size()), 4096, [&values](uint32_t begin, uint32_t end) {
+			for (auto i = begin; i < end; i++) {
+				values[i] = std::sqrt(values[i] * 2.0f);
+			}
+		});
+	}
+
+	benchmark::DoNotOptimize(values.data());
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(JobSystem_ParallelFor)->Arg(1 << 20)->UseRealTime();
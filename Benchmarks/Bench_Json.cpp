@@ -0,0 +1,52 @@
+#include <benchmark/benchmark.h>
+
+#include <Files/Json/Json.hpp>
+
+using namespace acid;
+
+/**
+ * Creates a document shaped like a saved scene, with a number of entities that each have a few components.
+ */
+static Json CreateDocument(uint32_t entities) {
+	Json json;
+
+	for (uint32_t i = 0; i < entities; i++) {
+		auto entity = json["entities"][i];
+		entity["name"] = "Entity " + std::to_string(i);
+		entity["transform"]["position"] = std::vector<float>{static_cast<float>(i), 2.0f, -3.5f};
+		entity["transform"]["rotation"] = std::vector<float>{0.0f, 1.57f, 0.0f};
+		entity["transform"]["scale"] = std::vector<float>{1.0f, 1.0f, 1.0f};
+		entity["rigidbody"]["mass"] = 1.5f;
+		entity["rigidbody"]["friction"] = 0.2f;
+		entity["mesh"]["filename"] = "Objects/Crate/Crate.obj";
+	}
+
+	return json;
+}
+
+static void Json_LoadString(benchmark::State &state) {
+	auto string = CreateDocument(static_cast<uint32_t>(state.range(0))).WriteString();
+
+	for (auto _ : state) {
+		Json json;
+		json.LoadString(string);
+		benchmark::DoNotOptimize(json.GetProperties().data());
+	}
+
+	state.SetBytesProcessed(state.iterations() * string.size());
+}
+BENCHMARK(Json_LoadString)->Arg(10)->Arg(1000);
+
+static void Json_WriteStream(benchmark::State &state) {
+	auto json = CreateDocument(static_cast<uint32_t>(state.range(0)));
+	std::ostringstream stream;
+
+	for (auto _ : state) {
+		stream.str({});
+		json.WriteStream(stream, Node::Format::Minified);
+		benchmark::DoNotOptimize(stream.tellp());
+	}
+
+	state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(stream.str().size()));
+}
+BENCHMARK(Json_WriteStream)->Arg(10)->Arg(1000);
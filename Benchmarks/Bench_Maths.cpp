@@ -0,0 +1,90 @@
+#include <benchmark/benchmark.h>
+
+#include <Maths/Matrix4.hpp>
+#include <Maths/Quaternion.hpp>
+#include <Maths/Transform.hpp>
+
+using namespace acid;
+
+static void Matrix4_Multiply(benchmark::State &state) {
+	auto a = Matrix4::TransformationMatrix({1.0f, 2.0f, 3.0f}, {0.1f, 0.2f, 0.3f}, {1.0f, 1.0f, 1.0f});
+	auto b = Matrix4::TransformationMatrix({-3.0f, 0.5f, 8.0f}, {0.7f, 0.0f, 1.1f}, {2.0f, 2.0f, 2.0f});
+
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(a = a * b);
+	}
+}
+BENCHMARK(Matrix4_Multiply);
+
+static void Matrix4_Inverse(benchmark::State &state) {
+	auto a = Matrix4::TransformationMatrix({1.0f, 2.0f, 3.0f}, {0.1f, 0.2f, 0.3f}, {1.0f, 2.0f, 1.0f});
+
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(a.Inverse());
+	}
+}
+BENCHMARK(Matrix4_Inverse);
+
+static void Matrix4_TransformationMatrix(benchmark::State &state) {
+	Vector3f translation(1.0f, 2.0f, 3.0f);
+
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(Matrix4::TransformationMatrix(translation, {0.1f, 0.2f, 0.3f}, {1.0f, 1.0f, 1.0f}));
+		translation.m_x += 0.001f;
+	}
+}
+BENCHMARK(Matrix4_TransformationMatrix);
+
+static void Quaternion_Multiply(benchmark::State &state) {
+	Quaternion a(Vector3f(0.1f, 0.2f, 0.3f));
+	Quaternion b(Vector3f(0.3f, -0.2f, 0.1f));
+
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(a = (a * b).Normalize());
+	}
+}
+BENCHMARK(Quaternion_Multiply);
+
+static void Quaternion_Slerp(benchmark::State &state) {
+	Quaternion a(Vector3f(0.1f, 0.2f, 0.3f));
+	Quaternion b(Vector3f(1.3f, -0.2f, 0.9f));
+	float progression = 0.0f;
+
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(a.Slerp(b, progression));
+		progression = std::fmod(progression + 0.01f, 1.0f);
+	}
+}
+BENCHMARK(Quaternion_Slerp);
+
+static void Quaternion_ToRotationMatrix(benchmark::State &state) {
+	Quaternion a(Vector3f(0.1f, 0.2f, 0.3f));
+
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(a.ToRotationMatrix());
+	}
+}
+BENCHMARK(Quaternion_ToRotationMatrix);
+
+static void Transform_GetWorldMatrix(benchmark::State &state) {
+	// A chain of transforms, moving the root each frame and reading every world matrix like a renderer would.
+	std::vector<std::unique_ptr<Transform>> chain;
+	Transform *parent = nullptr;
+
+	for (int64_t i = 0; i < state.range(0); i++) {
+		auto &transform = chain.emplace_back(std::make_unique<Transform>(Vector3f(1.0f, 0.0f, 0.0f), Vector3f(0.0f, 0.01f, 0.0f)));
+		transform->SetParent(parent);
+		parent = transform.get();
+	}
+
+	float x = 0.0f;
+
+	for (auto _ : state) {
+		chain.front()->SetLocalPosition({x += 0.001f, 0.0f, 0.0f});
+
+		for (const auto &transform : chain) {
+			benchmark::DoNotOptimize(transform->GetWorldMatrix());
+		}
+	}
+}
+BENCHMARK(Transform_GetWorldMatrix)->Arg(16)->Arg(256);
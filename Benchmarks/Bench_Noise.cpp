@@ -0,0 +1,43 @@
+#include <benchmark/benchmark.h>
+
+#include <Maths/Noise/Noise.hpp>
+
+using namespace acid;
+
+static void Noise_GetNoise(benchmark::State &state) {
+	Noise noise(1337, 0.01f, Noise::Interp::Quintic, static_cast<Noise::Type>(state.range(0)));
+	float x = 0.0f;
+
+	for (auto _ : state) {
+		for (uint32_t y = 0; y < 64; y++) {
+			benchmark::DoNotOptimize(noise.GetNoise(x, static_cast<float>(y)));
+		}
+
+		x += 1.0f;
+	}
+
+	state.SetItemsProcessed(state.iterations() * 64);
+}
+BENCHMARK(Noise_GetNoise)
+	->Arg(static_cast<int64_t>(Noise::Type::Value))
+	->Arg(static_cast<int64_t>(Noise::Type::Perlin))
+	->Arg(static_cast<int64_t>(Noise::Type::Simplex))
+	->Arg(static_cast<int64_t>(Noise::Type::SimplexFractal))
+	->Arg(static_cast<int64_t>(Noise::Type::Cellular))
+	->Arg(static_cast<int64_t>(Noise::Type::Cubic));
+
+static void Noise_GetNoise3d(benchmark::State &state) {
+	Noise noise(1337, 0.01f, Noise::Interp::Quintic, Noise::Type::PerlinFractal);
+	float x = 0.0f;
+
+	for (auto _ : state) {
+		for (uint32_t y = 0; y < 64; y++) {
+			benchmark::DoNotOptimize(noise.GetNoise(x, static_cast<float>(y), 0.5f));
+		}
+
+		x += 1.0f;
+	}
+
+	state.SetItemsProcessed(state.iterations() * 64);
+}
+BENCHMARK(Noise_GetNoise3d);
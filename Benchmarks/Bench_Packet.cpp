@@ -0,0 +1,48 @@
+#include <benchmark/benchmark.h>
+
+#include <Network/Packet.hpp>
+
+using namespace acid;
+
+static void Packet_Write(benchmark::State &state) {
+	std::string name = "Player";
+
+	for (auto _ : state) {
+		Packet packet;
+
+		for (uint32_t i = 0; i < 64; i++) {
+			packet << i << static_cast<float>(i) * 0.5f << static_cast<uint8_t>(i) << name;
+		}
+
+		benchmark::DoNotOptimize(packet.GetData());
+	}
+
+	state.SetItemsProcessed(state.iterations() * 64);
+}
+BENCHMARK(Packet_Write);
+
+static void Packet_Read(benchmark::State &state) {
+	Packet source;
+
+	for (uint32_t i = 0; i < 64; i++) {
+		source << i << static_cast<float>(i) * 0.5f << static_cast<uint8_t>(i) << std::string("Player");
+	}
+
+	for (auto _ : state) {
+		Packet packet;
+		packet.Append(source.GetData(), source.GetDataSize());
+		uint32_t index;
+		float value;
+		uint8_t flags;
+		std::string name;
+
+		for (uint32_t i = 0; i < 64; i++) {
+			packet >> index >> value >> flags >> name;
+		}
+
+		benchmark::DoNotOptimize(name.data());
+	}
+
+	state.SetItemsProcessed(state.iterations() * 64);
+}
+BENCHMARK(Packet_Read);
@@ -0,0 +1,27 @@
+#include <benchmark/benchmark.h>
+
+#include <Particles/Particles.hpp>
+
+using namespace acid;
+
+static void Particles_Update(benchmark::State &state) {
+	auto particles = Particles::Get();
+	auto particleType = ParticleType::Create(nullptr, 1, Colour::White, 2.0f);
+
+	for (auto _ : state) {
+		state.PauseTiming();
+		particles->Clear();
+
+		for (int64_t i = 0; i < state.range(0); i++) {
+			auto offset = static_cast<float>(i);
+			particles->AddParticle({particleType, {offset, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}, 2.0f, 1.0f, 0.0f, 1.0f, 0.5f});
+		}
+
+		state.ResumeTiming();
+		particles->Update();
+	}
+
+	particles->Clear();
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(Particles_Update)->Arg(1000)->Arg(10000);
@@ -0,0 +1,61 @@
+#include <benchmark/benchmark.h>
+
+#include <Resources/Resources.hpp>
+
+using namespace acid;
+
+/**
+ * Creates a node shaped like the ones image resources are found by.
+ */
+static Node CreateNode(uint32_t index) {
+	Node node;
+	node["filename"] = "Textures/Texture" + std::to_string(index) + ".png";
+	node["filter"] = 9729;
+	node["addressMode"] = 10497;
+	node["anisotropic"] = true;
+	node["mipmap"] = true;
+	return node;
+}
+
+static void Resources_Find(benchmark::State &state) {
+	Resources resources;
+	std::vector<Node> nodes;
+
+	for (uint32_t i = 0; i < static_cast<uint32_t>(state.range(0)); i++) {
+		nodes.emplace_back(CreateNode(i));
+		resources.Add(nodes.back(), std::make_shared<Resource>());
+	}
+
+	std::size_t index = 0;
+
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(resources.Find<Resource>(nodes[index]));
+		index = (index + 7919) % nodes.size();
+	}
+}
+BENCHMARK(Resources_Find)->Arg(10)->Arg(1000)->Arg(50000);
+
+static void Resources_FindLinear(benchmark::State &state) {
+	// How resources were found before they were hashed, comparing the node of every resource.
+	std::map<Node, std::shared_ptr<Resource>> resources;
+	std::vector<Node> nodes;
+
+	for (uint32_t i = 0; i < static_cast<uint32_t>(state.range(0)); i++) {
+		nodes.emplace_back(CreateNode(i));
+		resources.emplace(nodes.back(), std::make_shared<Resource>());
+	}
+
+	std::size_t index = 0;
+
+	for (auto _ : state) {
+		for (const auto &[key, resource] : resources) {
+			if (key == nodes[index]) {
+				benchmark::DoNotOptimize(resource);
+				break;
+			}
+		}
+
+		index = (index + 7919) % nodes.size();
+	}
+}
+BENCHMARK(Resources_FindLinear)->Arg(10)->Arg(1000)->Arg(50000);
@@ -0,0 +1,373 @@
+#include <benchmark/benchmark.h>
+
+#include <Files/File.hpp>
+#include <Files/Json/Json.hpp>
+#include <Lights/Light.hpp>
+#include <Maths/Transform.hpp>
+#include <Physics/Colliders/ColliderSphere.hpp>
+#include <Physics/Rigidbody.hpp>
+#include <Scenes/EntityPrefab.hpp>
+#include <Scenes/SceneSnapshot.hpp>
+#include <Scenes/SceneStructure.hpp>
+
+using namespace acid;
+
+static void SceneStructure_QueryComponents(benchmark::State &state) {
+	SceneStructure structure;
+
+	// Every entity has a transform, one in four also has a rigidbody.
+	for (int64_t i = 0; i < state.range(0); i++) {
+		auto entity = structure.CreateEntity();
+		entity->AddComponent<Transform>(Vector3f(static_cast<float>(i), 0.0f, 0.0f));
+
+		if (i % 4 == 0) {
+			entity->AddComponent<Rigidbody>();
+		}
+	}
+
+	for (auto _ : state) {
+		auto transforms = structure.QueryComponents<Transform>();
+		benchmark::DoNotOptimize(transforms.data());
+		auto rigidbodies = structure.QueryComponents<Rigidbody>();
+		benchmark::DoNotOptimize(rigidbodies.data());
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(SceneStructure_QueryComponents)->Arg(1000)->Arg(10000);
+
+static void SceneStructure_ForEach(benchmark::State &state) {
+	SceneStructure structure(static_cast<SceneStructure::Storage>(state.range(1)));
+
+	for (int64_t i = 0; i < state.range(0); i++) {
+		auto entity = structure.CreateEntity();
+		entity->AddComponent<Transform>(Vector3f(static_cast<float>(i), 0.0f, 0.0f));
+	}
+
+	for (auto _ : state) {
+		structure.ForEach<Transform>([](Transform &transform) {
+			transform.SetLocalPosition(transform.GetLocalPosition() + Vector3f(1.0f, 0.0f, 0.0f));
+		});
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(SceneStructure_ForEach)->ArgNames({"entities", "pooled"})->Args({10000, 0})->Args({10000, 1})->Args({100000, 0})->Args({100000, 1});
+
+static void Entity_GetComponent(benchmark::State &state) {
+	SceneStructure structure;
+	auto entity = structure.CreateEntity();
+	entity->AddComponent<Rigidbody>();
+	entity->AddComponent<Transform>();
+
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(entity->GetComponent<Transform>());
+	}
+}
+BENCHMARK(Entity_GetComponent);
+
+namespace {
+/**
+ * A behaviour that only changes itself, so it can be updated in parallel.
+ */
+class Oscillator : public Component::Registrar<Oscillator> {
+public:
+	void Update() override {
+		for (int32_t i = 0; i < 64; i++) {
+			m_phase = std::fmod(m_phase + std::sin(m_phase) * 0.01f + 0.001f, 6.2831853f);
+		}
+	}
+
+	bool IsThreadSafe() const override { return m_threadSafe; }
+
+	bool m_threadSafe = false;
+	float m_phase = 0.0f;
+};
+}
+
+static void SceneStructure_Update(benchmark::State &state) {
+	SceneStructure structure;
+
+	for (int64_t i = 0; i < state.range(0); i++) {
+		auto oscillator = structure.CreateEntity()->AddComponent<Oscillator>();
+		oscillator->m_threadSafe = state.range(1) != 0;
+		oscillator->m_phase = static_cast<float>(i % 100) * 0.01f;
+	}
+
+	for (auto _ : state) {
+		structure.Update();
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(SceneStructure_Update)->ArgNames({"entities", "parallel"})->Args({10000, 0})->Args({10000, 1})->Args({100000, 0})->Args({100000, 1})
+	->UseRealTime();
+
+static void SceneStructure_Despawn(benchmark::State &state) {
+	for (auto _ : state) {
+		state.PauseTiming();
+		SceneStructure structure;
+		std::vector<Entity *> entities;
+		entities.reserve(state.range(0));
+
+		for (int64_t i = 0; i < state.range(0); i++) {
+			auto entity = structure.CreateEntity();
+			entity->AddComponent<Transform>();
+			entities.emplace_back(entity);
+		}
+
+		state.ResumeTiming();
+
+		// Despawns half of the entities in one frame.
+		for (std::size_t i = 0; i < entities.size(); i += 2) {
+			structure.GetCommands().Destroy(entities[i]);
+		}
+
+		structure.Flush();
+
+		state.PauseTiming();
+		structure.Clear();
+		state.ResumeTiming();
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0) / 2);
+}
+BENCHMARK(SceneStructure_Despawn)->Arg(10000)->Arg(100000)->Unit(benchmark::kMillisecond);
+
+static void SceneStructure_GetEntity(benchmark::State &state) {
+	SceneStructure structure;
+	std::vector<EntityHandle> handles;
+
+	for (int64_t i = 0; i < state.range(0); i++) {
+		auto entity = structure.CreateEntity();
+		entity->SetName("Entity" + std::to_string(i));
+		handles.emplace_back(entity->GetHandle());
+	}
+
+	const auto name = "Entity" + std::to_string(state.range(0) - 1);
+	std::size_t i = 0;
+
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(structure.GetEntity(name));
+		benchmark::DoNotOptimize(structure.GetEntity(handles[i++ % handles.size()]));
+	}
+}
+BENCHMARK(SceneStructure_GetEntity)->Arg(1000)->Arg(100000);
+
+static void CreateScattered(SceneStructure &structure, int64_t count) {
+	// Unit boxes spread over a square a kilometre wide.
+	uint32_t seed = 1;
+
+	for (int64_t i = 0; i < count; i++) {
+		seed = seed * 1664525u + 1013904223u;
+		auto x = static_cast<float>(seed % 1000) - 500.0f;
+		auto z = static_cast<float>((seed / 1000) % 1000) - 500.0f;
+		auto entity = structure.CreateEntity();
+		entity->AddComponent<Transform>(Vector3f(x, 0.0f, z))->SetLocalBounds(Vector3f(-0.5f), Vector3f(0.5f));
+	}
+
+	structure.UpdateBounds();
+}
+
+static void SceneStructure_QueryFrustum(benchmark::State &state) {
+	SceneStructure structure;
+	CreateScattered(structure, state.range(0));
+
+	Frustum frustum;
+	frustum.Update(Matrix4::ViewMatrix({}, {}), Matrix4::PerspectiveMatrix(Maths::Radians(70.0f), 1.5f, 0.1f, 100.0f));
+	std::size_t found = 0;
+
+	for (auto _ : state) {
+		if (state.range(1)) {
+			found = structure.QueryFrustum(frustum).size();
+		} else {
+			// The linear path, testing every entity's bounds.
+			std::vector<Entity *> entities;
+			structure.ForEach<Transform>([&](Transform &transform) {
+				if (frustum.CubeInFrustum(transform.GetWorldMin(), transform.GetWorldMax())) {
+					entities.emplace_back(transform.GetEntity());
+				}
+			});
+			found = entities.size();
+		}
+
+		FrameAllocator::NextFrame();
+	}
+
+	state.counters["found"] = static_cast<double>(found);
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(SceneStructure_QueryFrustum)->ArgNames({"entities", "tree"})->Args({10000, 0})->Args({10000, 1})->Args({100000, 0})->Args({100000, 1});
+
+static void SceneStructure_QuerySphere(benchmark::State &state) {
+	SceneStructure structure;
+	CreateScattered(structure, state.range(0));
+
+	Vector3f centre(20.0f, 0.0f, -40.0f);
+	auto radius = 25.0f;
+	std::size_t found = 0;
+
+	for (auto _ : state) {
+		if (state.range(1)) {
+			found = structure.QuerySphere(centre, radius).size();
+		} else {
+			std::vector<Entity *> entities;
+			structure.ForEach<Transform>([&](Transform &transform) {
+				auto closest = centre.Max(transform.GetWorldMin()).Min(transform.GetWorldMax());
+
+				if (centre.DistanceSquared(closest) <= radius * radius) {
+					entities.emplace_back(transform.GetEntity());
+				}
+			});
+			found = entities.size();
+		}
+
+		FrameAllocator::NextFrame();
+	}
+
+	state.counters["found"] = static_cast<double>(found);
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(SceneStructure_QuerySphere)->ArgNames({"entities", "tree"})->Args({10000, 0})->Args({10000, 1})->Args({100000, 0})->Args({100000, 1});
+
+static void SceneStructure_UpdateBounds(benchmark::State &state) {
+	SceneStructure structure;
+	CreateScattered(structure, state.range(0));
+	auto moving = structure.QueryComponents<Transform>();
+	float offset = 0.0f;
+
+	// One in ten entities moves each frame, most stay inside their grown boxes.
+	for (auto _ : state) {
+		offset = offset > 0.0f ? -0.05f : 0.05f;
+
+		for (std::size_t i = 0; i < moving.size(); i += 10) {
+			moving[i]->SetLocalPosition(moving[i]->GetLocalPosition() + Vector3f(offset, 0.0f, 0.0f));
+		}
+
+		structure.UpdateBounds();
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(SceneStructure_UpdateBounds)->Arg(10000)->Arg(100000);
+
+static void SceneStructure_Instantiate(benchmark::State &state) {
+	auto filename = std::filesystem::temp_directory_path() / "Bench_EntityPrefab.json";
+	{
+		auto node = std::make_unique<Json>();
+		(*node)["transform"] << Transform(Vector3f(1.0f, 2.0f, 3.0f));
+		(*node)["light"] << Light(Colour::Red, 4.0f);
+		File(filename, std::move(node)).Write();
+	}
+
+	EntityPrefab prefab(filename);
+	std::vector<Transform> transforms(static_cast<std::size_t>(state.range(0)));
+
+	for (auto _ : state) {
+		SceneStructure structure;
+
+		if (state.range(1)) {
+			benchmark::DoNotOptimize(structure.Instantiate(prefab, transforms.size(), transforms.data()).data());
+		} else {
+			// Decoding each component from the prefab's node for every entity.
+			for (const auto &transform : transforms) {
+				auto entity = structure.CreateEntity();
+
+				for (const auto &property : prefab.GetParent()->GetProperties()) {
+					if (auto component = Component::Create(property.GetName())) {
+						property >> *component;
+						entity->AddComponent(std::move(component));
+					}
+				}
+
+				*entity->GetComponent<Transform>() = transform;
+			}
+		}
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+	std::filesystem::remove(filename);
+}
+BENCHMARK(SceneStructure_Instantiate)->ArgNames({"entities", "batched"})->Args({1000, 0})->Args({1000, 1})->Args({10000, 0})->Args({10000, 1})
+	->Unit(benchmark::kMillisecond);
+
+static void SceneSnapshot_Load(benchmark::State &state) {
+	SceneStructure source;
+
+	for (int64_t i = 0; i < state.range(0); i++) {
+		auto entity = source.CreateEntity();
+		entity->SetName("Light" + std::to_string(i % 100));
+		entity->AddComponent<Transform>(Vector3f(static_cast<float>(i), 0.0f, 0.0f));
+		entity->AddComponent<Light>(Colour::Red, 4.0f);
+	}
+
+	auto buffer = SceneSnapshot(source).Encode();
+
+	// The same scene as a JSON document, with a child per entity.
+	Json json;
+	uint32_t index = 0;
+
+	for (auto entity : source.QueryAll()) {
+		auto &child = json.AddProperty(std::to_string(index++));
+		child["name"] = entity->GetName();
+		child["transform"] << *entity->GetComponent<Transform>();
+		child["light"] << *entity->GetComponent<Light>();
+	}
+
+	std::stringstream stream;
+	json.WriteStream(stream);
+	auto string = stream.str();
+
+	for (auto _ : state) {
+		SceneStructure structure;
+
+		if (state.range(1)) {
+			SceneSnapshot::Load(structure, buffer.data(), buffer.size());
+		} else {
+			Json loaded;
+			loaded.LoadString(string);
+
+			for (const auto &child : loaded.GetProperties()) {
+				auto entity = structure.CreateEntity();
+				entity->SetName(child["name"].Get<std::string>());
+
+				for (const auto &property : child.GetProperties()) {
+					if (property.GetName() == "name") {
+						continue;
+					}
+
+					if (auto component = Component::Create(property.GetName())) {
+						property >> *component;
+						entity->AddComponent(std::move(component));
+					}
+				}
+			}
+		}
+
+		benchmark::DoNotOptimize(structure.GetSize());
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+	state.counters["bytes"] = static_cast<double>(state.range(1) ? buffer.size() : string.size());
+}
+BENCHMARK(SceneSnapshot_Load)->ArgNames({"entities", "snapshot"})->Args({1000, 0})->Args({1000, 1})->Args({10000, 0})->Args({10000, 1})
+	->Unit(benchmark::kMillisecond);
+
+static void SceneSnapshot_Capture(benchmark::State &state) {
+	SceneStructure structure;
+
+	for (int64_t i = 0; i < state.range(0); i++) {
+		auto entity = structure.CreateEntity();
+		entity->AddComponent<Transform>(Vector3f(static_cast<float>(i), 0.0f, 0.0f));
+		entity->AddComponent<Light>(Colour::Red, 4.0f);
+		entity->AddComponent<Rigidbody>(std::make_unique<ColliderSphere>(), 2.0f);
+	}
+
+	for (auto _ : state) {
+		SceneSnapshot snapshot(structure);
+		benchmark::DoNotOptimize(snapshot.GetEntityCount());
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(SceneSnapshot_Capture)->ArgName("entities")->Arg(1000)->Arg(10000)->Unit(benchmark::kMillisecond);
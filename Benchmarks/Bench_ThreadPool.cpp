@@ -0,0 +1,29 @@
+#include <benchmark/benchmark.h>
+
+#include <Helpers/ThreadPool.hpp>
+
+using namespace acid;
+
+static void ThreadPool_Enqueue(benchmark::State &state) {
+	ThreadPool threadPool;
+	std::vector<std::future<void>> futures;
+	futures.reserve(static_cast<std::size_t>(state.range(0)));
+	std::atomic<uint64_t> count = 0;
+
+	for (auto _ : state) {
+		for (int64_t i = 0; i < state.range(0); i++) {
+			futures.emplace_back(threadPool.Enqueue([&count]() {
+				count++;
+			}));
+		}
+
+		for (auto &future : futures) {
+			future.wait();
+		}
+
+		futures.clear();
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(ThreadPool_Enqueue)->Arg(1000)->UseRealTime();
@@ -0,0 +1,109 @@
+#include <benchmark/benchmark.h>
+
+#include <Timers/Timers.hpp>
+
+using namespace acid;
+
+static void Timers_Every(benchmark::State &state) {
+	for (auto _ : state) {
+		Timers timers;
+		std::vector<TimerHandle> handles;
+		handles.reserve(static_cast<std::size_t>(state.range(0)));
+
+		// Intervals are spread from 10ms to 1s, like many gameplay timers of different periods.
+		for (int64_t i = 0; i < state.range(0); i++) {
+			handles.emplace_back(timers.Every(Time::Milliseconds(10 + i % 991), []() {
+			}));
+		}
+
+		state.PauseTiming();
+
+		for (auto &handle : handles) {
+			handle.Cancel();
+		}
+
+		state.ResumeTiming();
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(Timers_Every)->Arg(100000)->Unit(benchmark::kMillisecond);
+
+static void Timers_CancelAndDrain(benchmark::State &state) {
+	for (auto _ : state) {
+		state.PauseTiming();
+		Timers timers;
+		std::vector<TimerHandle> handles;
+		handles.reserve(static_cast<std::size_t>(state.range(0)));
+
+		for (int64_t i = 0; i < state.range(0); i++) {
+			handles.emplace_back(timers.Every(Time::Milliseconds(10 + i % 991), []() {
+			}));
+		}
+
+		state.ResumeTiming();
+
+		for (auto &handle : handles) {
+			handle.Cancel();
+		}
+
+		while (timers.GetTimerCount() != 0) {
+			std::this_thread::yield();
+		}
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(Timers_CancelAndDrain)->Arg(100000)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+static void Timers_Once(benchmark::State &state) {
+	std::atomic<int64_t> maxLate = 0;
+
+	for (auto _ : state) {
+		Timers timers;
+		std::atomic<int64_t> ticks = 0;
+		auto start = Time::Now();
+
+		// Scheduled in a random order over 50ms, the whole run waits for every timer to expire.
+		for (int64_t i = 0; i < state.range(0); i++) {
+			auto delay = Time::Microseconds(100 + (i * 7919) % 50000);
+			timers.Once(delay, [&ticks, &maxLate, deadline = start + delay]() {
+				auto late = (Time::Now() - deadline).AsMicroseconds();
+
+				for (auto current = maxLate.load(); late > current && !maxLate.compare_exchange_weak(current, late);) {
+				}
+
+				ticks++;
+			});
+		}
+
+		while (ticks != state.range(0)) {
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+	state.counters["maxLateUs"] = static_cast<double>(maxLate.load());
+}
+BENCHMARK(Timers_Once)->Arg(100000)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+static void Timers_MainDelivery(benchmark::State &state) {
+	for (auto _ : state) {
+		Timers timers;
+		std::atomic<int64_t> ticks = 0;
+
+		for (int64_t i = 0; i < state.range(0); i++) {
+			timers.Once(Timer::Delivery::Main, Time::Milliseconds(1), [&ticks]() {
+				ticks++;
+			});
+		}
+
+		// Stands in for the engine's Post stage updates on the main thread.
+		while (ticks != state.range(0)) {
+			timers.Update();
+		}
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(Timers_MainDelivery)->Arg(100000)->Unit(benchmark::kMillisecond)->UseRealTime();
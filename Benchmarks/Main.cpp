@@ -0,0 +1,29 @@
+#include <benchmark/benchmark.h>
+
+#include <Engine/Engine.hpp>
+
+int main(int argc, char **argv) {
+	std::vector<char *> arguments(argv, argv + argc);
+	std::string out = "--benchmark_out=Benchmarks.json";
+	std::string outFormat = "--benchmark_out_format=json";
+
+	// Results are always written as JSON so they can be tracked across releases, unless another output is given.
+	if (std::none_of(arguments.begin(), arguments.end(), [](const char *argument) {
+		return std::string_view(argument).rfind("--benchmark_out=", 0) == 0;
+	})) {
+		arguments.emplace_back(out.data());
+		arguments.emplace_back(outFormat.data());
+	}
+
+	auto argumentCount = static_cast<int>(arguments.size());
+	::benchmark::Initialize(&argumentCount, arguments.data());
+
+	if (::benchmark::ReportUnrecognizedArguments(argumentCount, arguments.data())) {
+		return EXIT_FAILURE;
+	}
+
+	// A headless engine provides the modules benchmarked, without a window or audio device.
+	acid::Engine engine(argv[0], false, true);
+	::benchmark::RunSpecifiedBenchmarks();
+	return EXIT_SUCCESS;
+}
@@ -33,6 +33,8 @@
 #include "Engine/Engine.hpp"
 #include "Engine/Log.hpp"
 #include "Engine/Module.hpp"
+#include "Engine/ModuleGraph.hpp"
+#include "Engine/Profiler.hpp"
 #include "Files/File.hpp"
 #include "Files/FileObserver.hpp"
 #include "Files/Files.hpp"
@@ -86,13 +88,16 @@
 #include "Helpers/Delegate.hpp"
 #include "Helpers/EnumClass.hpp"
 #include "Helpers/Factory.hpp"
+#include "Helpers/FrameAllocator.hpp"
 #include "Helpers/Future.hpp"
+#include "Helpers/JobSystem.hpp"
 #include "Helpers/NonCopyable.hpp"
 #include "Helpers/RingBuffer.hpp"
 #include "Helpers/StreamFactory.hpp"
 #include "Helpers/String.hpp"
 #include "Helpers/ThreadPool.hpp"
 #include "Helpers/TypeInfo.hpp"
+#include "Helpers/WorkStealingQueue.hpp"
 #include "Inputs/Axes/Axis.hpp"
 #include "Inputs/Axes/AxisButton.hpp"
 #include "Inputs/Axes/AxisCompound.hpp"
@@ -211,15 +216,23 @@
 #include "Post/PostFilter.hpp"
 #include "Post/PostPipeline.hpp"
 #include "Resources/Resource.hpp"
+#include "Resources/ResourceHandle.hpp"
 #include "Resources/Resources.hpp"
+#include "Scenes/Archetype.hpp"
 #include "Scenes/Camera.hpp"
 #include "Scenes/Component.hpp"
+#include "Scenes/ComponentPool.hpp"
 #include "Scenes/Entity.hpp"
+#include "Scenes/EntityCommandBuffer.hpp"
+#include "Scenes/EntityHandle.hpp"
 #include "Scenes/EntityPrefab.hpp"
 #include "Scenes/Scene.hpp"
 #include "Scenes/ScenePhysics.hpp"
 #include "Scenes/Scenes.hpp"
+#include "Scenes/SceneSnapshot.hpp"
 #include "Scenes/SceneStructure.hpp"
+#include "Scenes/SpatialTree.hpp"
+#include "Scenes/View.hpp"
 #include "Shadows/ShadowBox.hpp"
 #include "Shadows/ShadowRender.hpp"
 #include "Shadows/Shadows.hpp"
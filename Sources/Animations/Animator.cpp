@@ -21,25 +21,25 @@ void Animator::IncreaseAnimationTime() {
 	}
 }
 
-std::map<std::string, Matrix4> Animator::CalculateCurrentAnimationPose() const {
+Animator::Pose Animator::CalculateCurrentAnimationPose() const {
 	auto [frame0, frame1] = GetPreviousAndNextFrames();
-	auto progression = CalculateProgression(frame0, frame1);
-	return InterpolatePoses(frame0, frame1, progression);
+	auto progression = CalculateProgression(*frame0, *frame1);
+	return InterpolatePoses(*frame0, *frame1, progression);
 }
 
-std::pair<Keyframe, Keyframe> Animator::GetPreviousAndNextFrames() const {
-	auto allFrames = m_currentAnimation->GetKeyframes();
-	auto previousFrame = allFrames[0];
-	auto nextFrame = allFrames[0];
+std::pair<const Keyframe *, const Keyframe *> Animator::GetPreviousAndNextFrames() const {
+	const auto &allFrames = m_currentAnimation->GetKeyframes();
+	auto previousFrame = &allFrames[0];
+	auto nextFrame = &allFrames[0];
 
 	for (uint32_t i = 1; i < allFrames.size(); i++) {
-		nextFrame = allFrames[i];
+		nextFrame = &allFrames[i];
 
-		if (nextFrame.GetTimeStamp() > m_animationTime) {
+		if (nextFrame->GetTimeStamp() > m_animationTime) {
 			break;
 		}
 
-		previousFrame = allFrames[i];
+		previousFrame = &allFrames[i];
 	}
 
 	return {previousFrame, nextFrame};
@@ -51,12 +51,12 @@ float Animator::CalculateProgression(const Keyframe &previousFrame, const Keyfra
 	return static_cast<float>(currentTime / totalTime);
 }
 
-std::map<std::string, Matrix4> Animator::InterpolatePoses(const Keyframe &previousFrame, const Keyframe &nextFrame, float progression) const {
-	std::map<std::string, Matrix4> currentPose;
+Animator::Pose Animator::InterpolatePoses(const Keyframe &previousFrame, const Keyframe &nextFrame, float progression) const {
+	Pose currentPose(&FrameAllocator::Get());
 
 	for (const auto &[name, joint] : previousFrame.GetPose()) {
-		auto previousTransform = previousFrame.GetPose().find(name)->second;
-		auto nextTransform = nextFrame.GetPose().find(name)->second;
+		const auto &previousTransform = joint;
+		const auto &nextTransform = nextFrame.GetPose().find(name)->second;
 		auto currentTransform = JointTransform::Interpolate(previousTransform, nextTransform, progression);
 		currentPose.emplace(name, currentTransform.GetLocalTransform());
 	}
@@ -64,7 +64,7 @@ std::map<std::string, Matrix4> Animator::InterpolatePoses(const Keyframe &previo
 	return currentPose;
 }
 
-void Animator::CalculateJointPose(const std::map<std::string, Matrix4> &currentPose, const Joint &joint, const Matrix4 &parentTransform, std::vector<Matrix4> &jointMatrices) {
+void Animator::CalculateJointPose(const Pose &currentPose, const Joint &joint, const Matrix4 &parentTransform, std::vector<Matrix4> &jointMatrices) {
 	auto currentLocalTransform = currentPose.find(joint.GetName())->second;
 	auto currentTransform = parentTransform * currentLocalTransform;
 
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "Helpers/FrameAllocator.hpp"
 #include "Maths/Time.hpp"
 #include "Animation/Animation.hpp"
 #include "Skeleton/Joint.hpp"
@@ -19,6 +20,9 @@ namespace acid {
  **/
 class ACID_EXPORT Animator {
 public:
+	/// Local-space joint transforms indexed by joint name, allocated from the frame allocator and keyed by names owned by the animation.
+	using Pose = std::pmr::map<std::string_view, Matrix4>;
+
 	/**
 	 * This method should be called each frame to update the animation currently being played. This increases the animation time (and loops it back to zero if necessary),
 	 * finds the pose that the entity should be in at that time of the animation, and then applied that pose to all the entity's joints.
@@ -50,7 +54,7 @@ public:
 	 * @return The current pose as a map of the desired local-space transforms for all the joints.
 	 * The transforms are indexed by the name ID of the joint that they should be applied to. </returns>
 	 **/
-	std::map<std::string, Matrix4> CalculateCurrentAnimationPose() const;
+	Pose CalculateCurrentAnimationPose() const;
 
 	/**
 	 * Finds the previous keyframe in the animation and the next keyframe in the animation, and returns them in an array of length 2.
@@ -58,7 +62,7 @@ public:
 	 * then the next keyframe is used as both the previous and next keyframe. The reverse happens if there is no next keyframe.
 	 * @return The previous and next keyframes, in an array which therefore will always have a length of 2.
 	 **/
-	std::pair<Keyframe, Keyframe> GetPreviousAndNextFrames() const;
+	std::pair<const Keyframe *, const Keyframe *> GetPreviousAndNextFrames() const;
 
 	/**
 	 * Calculates how far between the previous and next keyframe the current animation time is, and returns it as a value between 0 and 1.
@@ -79,7 +83,7 @@ public:
 	 * @return The local-space transforms for all the joints for the desired current pose.
 	 * They are returned in a map, indexed by the name of the joint to which they should be applied. </returns>
 	 **/
-	std::map<std::string, Matrix4> InterpolatePoses(const Keyframe &previousFrame, const Keyframe &nextFrame, float progression) const;
+	Pose InterpolatePoses(const Keyframe &previousFrame, const Keyframe &nextFrame, float progression) const;
 
 	/**
 	 * This method applies the current pose to a given joint, and all of its descendants.
@@ -105,7 +109,7 @@ public:
 	 * @param parentTransform The desired model-space transform of the parent joint for the pose.
 	 * @param jointMatrices The transforms that get loaded up to the shader and is used to deform the vertices of the "skin".
 	 **/
-	static void CalculateJointPose(const std::map<std::string, Matrix4> &currentPose, const Joint &joint, const Matrix4 &parentTransform, std::vector<Matrix4> &jointMatrices);
+	static void CalculateJointPose(const Pose &currentPose, const Joint &joint, const Matrix4 &parentTransform, std::vector<Matrix4> &jointMatrices);
 
 	const Animation *GetCurrentAnimation() const { return m_currentAnimation; }
 
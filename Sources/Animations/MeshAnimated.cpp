@@ -18,6 +18,19 @@ MeshAnimated::MeshAnimated(std::filesystem::path filename, std::unique_ptr<Mater
 	m_filename(std::move(filename)) {
 }
 
+std::unique_ptr<Component> MeshAnimated::Clone() const {
+	std::unique_ptr<Material> material;
+
+	if (m_material && !(material = m_material->Clone())) {
+		return nullptr;
+	}
+
+	// The model and animation are loaded from the file when the copy starts.
+	auto meshAnimated = std::make_unique<MeshAnimated>(m_filename, std::move(material));
+	meshAnimated->SetEnabled(IsEnabled());
+	return meshAnimated;
+}
+
 void MeshAnimated::Start() {
 	if (m_material)
 		m_material->CreatePipeline(GetVertexInput(), true);
@@ -20,6 +20,8 @@ public:
 	 */
 	explicit MeshAnimated(std::filesystem::path filename = "", std::unique_ptr<Material> &&material = nullptr);
 
+	std::unique_ptr<Component> Clone() const override;
+
 	void Start() override;
 	void Update() override;
 
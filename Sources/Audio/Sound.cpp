@@ -16,31 +16,42 @@ Sound::Sound(const std::string &filename, const Audio::Type &type, bool begin, b
 	m_type(type),
 	m_gain(gain),
 	m_pitch(pitch) {
-	alGenSources(1, &m_source);
-	alSourcei(m_source, AL_BUFFER, m_buffer->GetBuffer());
-
-	Audio::CheckAl(alGetError());
+	// Headless engines have no audio context, the sound keeps its state but never plays.
+	if (!Audio::Get()) {
+		return;
+	}
 
-	SetGain(gain);
-	SetPitch(pitch);
+	CreateSource();
 
 	if (begin) {
 		Play(loop);
 	}
-
-	Audio::Get()->OnGain().Add([this](Audio::Type type, float volume) {
-		if (type == m_type) {
-			SetGain(m_gain);
-		}
-	}, this);
 }
 
 Sound::~Sound() {
+	if (!m_source) {
+		return;
+	}
+
 	alDeleteSources(1, &m_source);
 	Audio::CheckAl(alGetError());
 }
 
+std::unique_ptr<Component> Sound::Clone() const {
+	auto sound = std::make_unique<Sound>();
+	sound->SetEnabled(IsEnabled());
+	sound->m_buffer = m_buffer;
+	sound->m_type = m_type;
+	sound->m_gain = m_gain;
+	sound->m_pitch = m_pitch;
+	return sound;
+}
+
 void Sound::Start() {
+	// Copies and decoded sounds get their source when started, so copies that are never added to a scene cost no audio calls.
+	if (!m_source && m_buffer && Audio::Get()) {
+		CreateSource();
+	}
 }
 
 void Sound::Update() {
@@ -50,6 +61,10 @@ void Sound::Update() {
 }
 
 void Sound::Play(bool loop) {
+	if (!m_source) {
+		return;
+	}
+
 	alSourcei(m_source, AL_LOOPING, loop);
 	alSourcePlay(m_source);
 	Audio::CheckAl(alGetError());
@@ -87,6 +102,10 @@ void Sound::Stop() {
 }
 
 bool Sound::IsPlaying() const {
+	if (!m_source) {
+		return false;
+	}
+
 	ALenum state;
 	alGetSourcei(m_source, AL_SOURCE_STATE, &state);
 	return state == AL_PLAYING;
@@ -94,34 +113,75 @@ bool Sound::IsPlaying() const {
 
 void Sound::SetPosition(const Vector3f &position) {
 	m_position = position;
+
+	if (!m_source) {
+		return;
+	}
+
 	alSource3f(m_source, AL_POSITION, m_position.m_x, m_position.m_y, m_position.m_z);
 	Audio::CheckAl(alGetError());
 }
 
 void Sound::SetDirection(const Vector3f &direction) {
 	m_direction = direction;
+
+	if (!m_source) {
+		return;
+	}
+
 	alSource3f(m_source, AL_DIRECTION, m_direction.m_x, m_direction.m_y, m_direction.m_z);
 	Audio::CheckAl(alGetError());
 }
 
 void Sound::SetVelocity(const Vector3f &velocity) {
 	m_velocity = velocity;
+
+	if (!m_source) {
+		return;
+	}
+
 	alSource3f(m_source, AL_VELOCITY, m_velocity.m_x, m_velocity.m_y, m_velocity.m_z);
 	Audio::CheckAl(alGetError());
 }
 
 void Sound::SetGain(float gain) {
 	m_gain = gain;
+
+	if (!m_source) {
+		return;
+	}
+
 	alSourcef(m_source, AL_GAIN, m_gain * Audio::Get()->GetGain(m_type));
 	Audio::CheckAl(alGetError());
 }
 
 void Sound::SetPitch(float pitch) {
 	m_pitch = pitch;
+
+	if (!m_source) {
+		return;
+	}
+
 	alSourcef(m_source, AL_PITCH, m_pitch);
 	Audio::CheckAl(alGetError());
 }
 
+void Sound::CreateSource() {
+	alGenSources(1, &m_source);
+	alSourcei(m_source, AL_BUFFER, m_buffer->GetBuffer());
+
+	Audio::CheckAl(alGetError());
+
+	SetGain(m_gain);
+	SetPitch(m_pitch);
+
+	Audio::Get()->OnGain().Add([this](Audio::Type type, float volume) {
+		if (type == m_type) {
+			SetGain(m_gain);
+		}
+	}, this);
+}
+
 const Node &operator>>(const Node &node, Sound &sound) {
 	node["buffer"].Get(sound.m_buffer);
 	node["type"].Get(sound.m_type);
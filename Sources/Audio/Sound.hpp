@@ -17,6 +17,8 @@ public:
 
 	~Sound();
 
+	std::unique_ptr<Component> Clone() const override;
+
 	void Start() override;
 	void Update() override;
 
@@ -44,6 +46,11 @@ public:
 	friend Node &operator<<(Node &node, const Sound &sound);
 
 private:
+	/**
+	 * Creates the source that plays the buffer, and keeps its gain following the volume of its type.
+	 */
+	void CreateSource();
+
 	static bool registered;
 	
 	std::shared_ptr<SoundBuffer> m_buffer;
@@ -10,12 +10,16 @@
 
 namespace acid {
 std::shared_ptr<SoundBuffer> SoundBuffer::Create(const Node &node) {
-	if (auto resource = Resources::Get()->Find(node)) {
-		return std::dynamic_pointer_cast<SoundBuffer>(resource);
+	if (auto resource = Resources::Get()->Find<SoundBuffer>(node)) {
+		return resource;
 	}
 
 	auto result = std::make_shared<SoundBuffer>("");
-	Resources::Get()->Add(node, std::dynamic_pointer_cast<Resource>(result));
+
+	if (auto resource = Resources::Get()->FindOrAdd(node, result); resource != result) {
+		return resource;
+	}
+
 	node >> *result;
 	result->Load();
 	return result;
@@ -28,6 +32,10 @@ std::shared_ptr<SoundBuffer> SoundBuffer::Create(const std::filesystem::path &fi
 	return Create(node);
 }
 
+std::shared_ptr<SoundBuffer> SoundBuffer::CreatePlaceholder() {
+	return std::make_shared<SoundBuffer>("", false);
+}
+
 SoundBuffer::SoundBuffer(std::filesystem::path filename, bool load) :
 	m_filename(std::move(filename)) {
 	if (load) {
@@ -36,13 +44,21 @@ SoundBuffer::SoundBuffer(std::filesystem::path filename, bool load) :
 }
 
 SoundBuffer::~SoundBuffer() {
-	alDeleteBuffers(1, &m_buffer);
+	if (m_buffer) {
+		alDeleteBuffers(1, &m_buffer);
+	}
 }
 
 void SoundBuffer::SetBuffer(uint32_t buffer) {
 	if (buffer)
 		alDeleteBuffers(1, &m_buffer);
 	m_buffer = buffer;
+
+	// OpenAL keeps buffer data in system memory.
+	ALint size = 0;
+	if (m_buffer)
+		alGetBufferi(m_buffer, AL_SIZE, &size);
+	m_cpuSize = static_cast<std::size_t>(size);
 }
 
 const Node &operator>>(const Node &node, SoundBuffer &soundBuffer) {
@@ -56,7 +72,9 @@ Node &operator<<(Node &node, const SoundBuffer &soundBuffer) {
 }
 
 void SoundBuffer::Load() {
-	if (m_filename.empty()) {
+	ACID_PROFILE_SCOPE("SoundBuffer::Load");
+
+	if (m_filename.empty() || !Audio::Get()) {
 		return;
 	}
 
@@ -48,6 +48,12 @@ public:
 	 */
 	static std::shared_ptr<SoundBuffer> Create(const std::filesystem::path &filename);
 
+	/**
+	 * Creates the sound buffer used while a sound buffer is loading, it has no samples so plays silence.
+	 * @return The placeholder sound buffer.
+	 */
+	static std::shared_ptr<SoundBuffer> CreatePlaceholder();
+
 	/**
 	 * Creates a new sound buffer.
 	 * @param filename The file to load the sound buffer from.
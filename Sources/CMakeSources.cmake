@@ -36,6 +36,8 @@ set(_temp_acid_headers
 		Engine/Engine.hpp
 		Engine/Log.hpp
 		Engine/Module.hpp
+		Engine/ModuleGraph.hpp
+		Engine/Profiler.hpp
 		Files/File.hpp
 		Files/FileObserver.hpp
 		Files/Files.hpp
@@ -65,6 +67,7 @@ set(_temp_acid_headers
 		Graphics/Commands/CommandBuffer.hpp
 		Graphics/Commands/CommandPool.hpp
 		Graphics/Descriptors/Descriptor.hpp
+		Graphics/Descriptors/DescriptorPool.hpp
 		Graphics/Descriptors/DescriptorSet.hpp
 		Graphics/Descriptors/DescriptorsHandler.hpp
 		Graphics/Graphics.hpp
@@ -89,13 +92,16 @@ set(_temp_acid_headers
 		Helpers/Delegate.hpp
 		Helpers/EnumClass.hpp
 		Helpers/Factory.hpp
+		Helpers/FrameAllocator.hpp
 		Helpers/Future.hpp
+		Helpers/JobSystem.hpp
 		Helpers/NonCopyable.hpp
 		Helpers/RingBuffer.hpp
 		Helpers/StreamFactory.hpp
 		Helpers/String.hpp
 		Helpers/ThreadPool.hpp
 		Helpers/TypeInfo.hpp
+		Helpers/WorkStealingQueue.hpp
 		Inputs/Axes/Axis.hpp
 		Inputs/Axes/AxisButton.hpp
 		Inputs/Axes/AxisCompound.hpp
@@ -214,15 +220,23 @@ set(_temp_acid_headers
 		Post/PostFilter.hpp
 		Post/PostPipeline.hpp
 		Resources/Resource.hpp
+		Resources/ResourceHandle.hpp
 		Resources/Resources.hpp
+		Scenes/Archetype.hpp
 		Scenes/Camera.hpp
 		Scenes/Component.hpp
+		Scenes/ComponentPool.hpp
 		Scenes/Entity.hpp
+		Scenes/EntityCommandBuffer.hpp
+		Scenes/EntityHandle.hpp
 		Scenes/EntityPrefab.hpp
 		Scenes/Scene.hpp
 		Scenes/ScenePhysics.hpp
 		Scenes/Scenes.hpp
+		Scenes/SceneSnapshot.hpp
 		Scenes/SceneStructure.hpp
+		Scenes/SpatialTree.hpp
+		Scenes/View.hpp
 		Shadows/ShadowBox.hpp
 		Shadows/ShadowRender.hpp
 		Shadows/Shadows.hpp
@@ -277,6 +291,8 @@ set(_temp_acid_sources
 		Devices/Window.cpp
 		Engine/Engine.cpp
 		Engine/Log.cpp
+		Engine/ModuleGraph.cpp
+		Engine/Profiler.cpp
 		Files/File.cpp
 		Files/FileObserver.cpp
 		Files/Files.cpp
@@ -304,6 +320,7 @@ set(_temp_acid_sources
 		Graphics/Buffers/UniformHandler.cpp
 		Graphics/Commands/CommandBuffer.cpp
 		Graphics/Commands/CommandPool.cpp
+		Graphics/Descriptors/DescriptorPool.cpp
 		Graphics/Descriptors/DescriptorSet.cpp
 		Graphics/Descriptors/DescriptorsHandler.cpp
 		Graphics/Graphics.cpp
@@ -321,6 +338,8 @@ set(_temp_acid_sources
 		Graphics/SubrenderHolder.cpp
 		Guis/Gui.cpp
 		Guis/SubrenderGuis.cpp
+		Helpers/FrameAllocator.cpp
+		Helpers/JobSystem.cpp
 		Helpers/String.cpp
 		Helpers/ThreadPool.cpp
 		Inputs/Axes/AxisButton.cpp
@@ -426,11 +445,15 @@ set(_temp_acid_sources
 		Post/Pipelines/PipelineBlur.cpp
 		Post/PostFilter.cpp
 		Resources/Resources.cpp
+		Scenes/Archetype.cpp
 		Scenes/Entity.cpp
+		Scenes/EntityCommandBuffer.cpp
 		Scenes/EntityPrefab.cpp
 		Scenes/ScenePhysics.cpp
 		Scenes/Scenes.cpp
+		Scenes/SceneSnapshot.cpp
 		Scenes/SceneStructure.cpp
+		Scenes/SpatialTree.cpp
 		Shadows/ShadowBox.cpp
 		Shadows/ShadowRender.cpp
 		Shadows/Shadows.cpp
@@ -30,6 +30,12 @@ public:
 	uint32_t GetComputeFamily() const { return m_computeFamily; }
 	uint32_t GetTransferFamily() const { return m_transferFamily; }
 
+	/**
+	 * Gets the mutex held while submitting to or waiting on a queue, as queues may be used by the main thread and by resources loading on workers.
+	 * @return The queue mutex.
+	 */
+	std::mutex &GetQueueMutex() const { return m_queueMutex; }
+
 private:
 	void CreateQueueIndices();
 	void CreateLogicalDevice();
@@ -51,5 +57,6 @@ private:
 	VkQueue m_presentQueue = VK_NULL_HANDLE;
 	VkQueue m_computeQueue = VK_NULL_HANDLE;
 	VkQueue m_transferQueue = VK_NULL_HANDLE;
+	mutable std::mutex m_queueMutex;
 };
 }
@@ -3,6 +3,7 @@
 #include "Maths/Maths.hpp"
 
 #include "Audio/Audio.hpp"
+#include "Audio/SoundBuffer.hpp"
 #include "Devices/Joysticks.hpp"
 #include "Devices/Keyboard.hpp"
 #include "Devices/Mouse.hpp"
@@ -12,6 +13,8 @@
 #include "Inputs/Input.hpp"
 #include "Particles/Particles.hpp"
 #include "Graphics/Graphics.hpp"
+#include "Graphics/Images/Image2d.hpp"
+#include "Models/Model.hpp"
 #include "Resources/Resources.hpp"
 #include "Scenes/Scenes.hpp"
 #include "Shadows/Shadows.hpp"
@@ -22,15 +25,20 @@
 namespace acid {
 Engine *Engine::Instance = nullptr;
 
-Engine::Engine(std::string argv0, bool emptyRegister) :
+Engine::Engine(std::string argv0, bool emptyRegister, bool headless) :
 	m_argv0(std::move(argv0)),
 	m_version{ACID_VERSION_MAJOR, ACID_VERSION_MINOR, ACID_VERSION_PATCH},
+	m_headless(headless),
 	m_fpsLimit(-1.0f),
 	m_running(true),
 	m_elapsedUpdate(15.77ms),
-	m_elapsedRender(-1s) {
+	m_elapsedRender(-1s),
+	m_fixedTimestep(false),
+	m_maxUpdateSteps(5),
+	m_alpha(1.0f) {
 	Instance = this;
 	Log::OpenLog(Time::GetDateTime("Logs/%Y%m%d%H%M%S.txt"));
+	Log::InstallCrashHandler();
 
 #if defined(ACID_DEBUG)
 	Log::Out("Version: ", ACID_VERSION, '\n');
@@ -38,7 +46,15 @@ Engine::Engine(std::string argv0, bool emptyRegister) :
 	Log::Out("Compiled on: ", ACID_COMPILED_SYSTEM, " from: ", ACID_COMPILED_GENERATOR, " with: ", ACID_COMPILED_COMPILER, "\n\n");
 #endif
 
-	if (!emptyRegister) {
+	if (!emptyRegister && headless) {
+		Files::Register(Module::Stage::Post);
+		Timers::Register(Module::Stage::Post);
+		Resources::Register(Module::Stage::Post);
+
+		Input::Register(Module::Stage::Normal, Module::Access().MainThread());
+		Scenes::Register(Module::Stage::Normal, Module::Access().Reads<Input>().Writes<Particles>().MainThread());
+		Particles::Register(Module::Stage::Normal, Module::Access().Reads<Scenes>().MainThread());
+	} else if (!emptyRegister) {
 		Files::Register(Module::Stage::Post);
 		Timers::Register(Module::Stage::Post);
 		Resources::Register(Module::Stage::Post);
@@ -50,13 +66,21 @@ Engine::Engine(std::string argv0, bool emptyRegister) :
 		Mouse::Register(Module::Stage::Pre);
 		Graphics::Register(Module::Stage::Render);
 
-		Input::Register(Module::Stage::Normal);
-		Scenes::Register(Module::Stage::Normal);
-		Gizmos::Register(Module::Stage::Normal);
-		Particles::Register(Module::Stage::Normal);
-		Shadows::Register(Module::Stage::Normal);
-		Uis::Register(Module::Stage::Normal);
+		Input::Register(Module::Stage::Normal, Module::Access().MainThread());
+		Scenes::Register(Module::Stage::Normal, Module::Access().Reads<Input>().Writes<Gizmos, Particles>().MainThread());
+		// Gizmos, particles and shadows read entities, cameras and the window without locks, so they stay on the main thread.
+		Gizmos::Register(Module::Stage::Normal, Module::Access().Reads<Scenes>().MainThread());
+		Particles::Register(Module::Stage::Normal, Module::Access().Reads<Scenes>().MainThread());
+		Shadows::Register(Module::Stage::Normal, Module::Access().Reads<Scenes>().MainThread());
+		Uis::Register(Module::Stage::Normal, Module::Access().Reads<Scenes>().MainThread());
+
+		// Unused images, models and sounds stay cached until their type is over budget.
+		Resources::Get()->SetBudget<Image2d>(Resources::Budget{std::numeric_limits<std::size_t>::max(), 512 * 1024 * 1024});
+		Resources::Get()->SetBudget<Model>(Resources::Budget{std::numeric_limits<std::size_t>::max(), 256 * 1024 * 1024});
+		Resources::Get()->SetBudget<SoundBuffer>(Resources::Budget{128 * 1024 * 1024, std::numeric_limits<std::size_t>::max()});
 	}
+
+	BuildStageGraphs();
 }
 
 Engine::~Engine() {
@@ -80,7 +104,9 @@ int32_t Engine::Run() {
 		// Always-Update.
 		UpdateStage(Module::Stage::Always);
 
-		if (m_elapsedUpdate.GetElapsed() != 0) {
+		if (m_fixedTimestep) {
+			UpdateFixed();
+		} else if (m_elapsedUpdate.GetElapsed() != 0) {
 			// Resets the timer.
 			m_ups.Update(Time::Now());
 
@@ -109,6 +135,10 @@ int32_t Engine::Run() {
 
 			// Render
 			UpdateStage(Module::Stage::Render);
+			ACID_PROFILE_FRAME();
+
+			// Releases every thread's transient memory from this frame.
+			FrameAllocator::NextFrame();
 
 			// Updates the render delta, and render time extension.
 			m_deltaRender.Update();
@@ -118,10 +148,73 @@ int32_t Engine::Run() {
 	return EXIT_SUCCESS;
 }
 
+void Engine::SetFixedTimestep(bool fixedTimestep) {
+	if (m_fixedTimestep == fixedTimestep) {
+		return;
+	}
+
+	m_fixedTimestep = fixedTimestep;
+	m_accumulator = 0s;
+	m_lastFrame = Time::Now();
+	m_alpha = 1.0f;
+}
+
+void Engine::UpdateFixed() {
+	auto interval = m_elapsedUpdate.GetInterval();
+	auto now = Time::Now();
+	m_accumulator += now - m_lastFrame;
+	m_lastFrame = now;
+
+	uint32_t steps = 0;
+
+	while (m_accumulator >= interval && steps < m_maxUpdateSteps) {
+		m_ups.Update(Time::Now());
+
+		// Every step sees the same delta, so the simulation doesn't depend on frame times.
+		m_deltaUpdate.m_lastFrameTime = m_deltaUpdate.m_currentFrameTime;
+		m_deltaUpdate.m_currentFrameTime += interval;
+		m_deltaUpdate.m_change = interval;
+
+		UpdateStage(Module::Stage::Pre);
+		UpdateStage(Module::Stage::Normal);
+		UpdateStage(Module::Stage::Post);
+
+		m_accumulator -= interval;
+		steps++;
+	}
+
+	// Hit the catch-up limit, the simulation falls behind real time instead of spiralling.
+	if (m_accumulator >= interval) {
+		m_accumulator = 0s;
+	}
+
+	m_alpha = static_cast<float>(m_accumulator / interval);
+}
+
 void Engine::UpdateStage(Module::Stage stage) {
+#if defined(ACID_PROFILING)
+	static constexpr std::array<const char *, 6> StageNames = {"Stage Never", "Stage Always", "Stage Pre", "Stage Normal", "Stage Post", "Stage Render"};
+	ACID_PROFILE_SCOPE(StageNames[static_cast<std::size_t>(stage)]);
+#endif
+
+	if (m_registryVersion != Module::RegistryVersion()) {
+		BuildStageGraphs();
+	}
+
+	m_stageGraphs[stage].Update(m_jobSystem);
+}
+
+void Engine::BuildStageGraphs() {
+	std::map<Module::Stage, std::vector<Module *>> stages;
+
 	for (auto &[stageIndex, module] : Module::Registry()) {
-		if (stageIndex.first == stage)
-			module->Update();
+		stages[stageIndex.first].emplace_back(module.get());
 	}
+
+	for (auto stage : {Module::Stage::Never, Module::Stage::Always, Module::Stage::Pre, Module::Stage::Normal, Module::Stage::Post, Module::Stage::Render}) {
+		m_stageGraphs[stage].Build(stages[stage]);
+	}
+
+	m_registryVersion = Module::RegistryVersion();
 }
 }
@@ -1,11 +1,15 @@
 #pragma once
 
+#include "Helpers/FrameAllocator.hpp"
+#include "Helpers/JobSystem.hpp"
 #include "Helpers/NonCopyable.hpp"
 #include "Maths/ElapsedTime.hpp"
 #include "Maths/Time.hpp"
 #include "Module.hpp"
+#include "ModuleGraph.hpp"
 #include "App.hpp"
 #include "Log.hpp"
+#include "Profiler.hpp"
 
 namespace acid {
 class ACID_EXPORT Delta {
@@ -53,8 +57,9 @@ public:
 	 * Carries out the setup for basic engine components and the engine. Call {@link Engine#Run} after creating a instance.
 	 * @param argv0 The first argument passed to main.
 	 * @param emptyRegister If the module register will start empty.
+	 * @param headless If the engine runs without a window, graphics, audio or input devices, only simulation modules will be registered.
 	 */
-	explicit Engine(std::string argv0, bool emptyRegister = false);
+	explicit Engine(std::string argv0, bool emptyRegister = false, bool headless = false);
 
 	~Engine();
 
@@ -70,6 +75,13 @@ public:
 	 */
 	const std::string &GetArgv0() const { return m_argv0; };
 
+	/**
+	 * Gets if the engine was created without a window, graphics, audio or input devices.
+	 * Rendering and audio only components and resources become no-ops when headless.
+	 * @return If the engine is headless.
+	 */
+	bool IsHeadless() const { return m_headless; }
+
 	/**
 	 * Gets the engine's version.
 	 * @return The engine's version.
@@ -100,6 +112,49 @@ public:
 	 */
 	void SetFpsLimit(float fpsLimit) { m_fpsLimit = fpsLimit; }
 
+	/**
+	 * Gets the time between updates, the step used by the fixed timestep.
+	 * @return The update interval.
+	 */
+	const Time &GetUpdateInterval() const { return m_elapsedUpdate.GetInterval(); }
+
+	/**
+	 * Sets the time between updates.
+	 * @param updateInterval The new update interval.
+	 */
+	void SetUpdateInterval(const Time &updateInterval) { m_elapsedUpdate.SetInterval(updateInterval); }
+
+	/**
+	 * Gets if updates are run with a fixed timestep.
+	 * @return If the fixed timestep is used.
+	 */
+	bool IsFixedTimestep() const { return m_fixedTimestep; }
+
+	/**
+	 * Sets if updates are run with a fixed timestep. When enabled time is accumulated each frame and consumed in steps of
+	 * exactly the update interval, {@link Engine#GetDelta} is always the interval and rendering interpolates between the last two steps.
+	 * @param fixedTimestep If the fixed timestep will be used.
+	 */
+	void SetFixedTimestep(bool fixedTimestep);
+
+	/**
+	 * Gets the most steps run in a single frame by the fixed timestep.
+	 * @return The max catch-up steps.
+	 */
+	uint32_t GetMaxUpdateSteps() const { return m_maxUpdateSteps; }
+
+	/**
+	 * Sets the most steps run in a single frame by the fixed timestep, time past this limit is dropped so a slow frame can't snowball.
+	 * @param maxUpdateSteps The new max catch-up steps.
+	 */
+	void SetMaxUpdateSteps(uint32_t maxUpdateSteps) { m_maxUpdateSteps = std::max(maxUpdateSteps, 1u); }
+
+	/**
+	 * Gets how far rendering is between the previous and the last fixed step, from 0 to 1. Always 1 without the fixed timestep.
+	 * @return The interpolation alpha.
+	 */
+	float GetAlpha() const { return m_alpha; }
+
 	/**
 	 * Gets if the engine is running.
 	 * @return If the engine is running.
@@ -135,13 +190,34 @@ public:
 	 */
 	void RequestClose() { m_running = false; }
 
+	/**
+	 * Gets the job system shared by the engine, used to update modules in parallel.
+	 * @return The job system.
+	 */
+	JobSystem &GetJobSystem() { return m_jobSystem; }
+
+	/**
+	 * Gets the module graph for a stage, holding timings from the last time the stage was updated.
+	 * @param stage The stage.
+	 * @return The stage's module graph.
+	 */
+	const ModuleGraph &GetStageGraph(Module::Stage stage) const { return m_stageGraphs.at(stage); }
+
 private:
 	void UpdateStage(Module::Stage stage);
+	void UpdateFixed();
+	void BuildStageGraphs();
 	
 	static Engine *Instance;
 
 	std::string m_argv0;
 	Version m_version;
+	bool m_headless;
+
+	// Constructed before and destroyed after any module.
+	JobSystem m_jobSystem;
+	std::map<Module::Stage, ModuleGraph> m_stageGraphs;
+	std::size_t m_registryVersion = 0;
 
 	std::unique_ptr<App> m_app;
 
@@ -153,6 +229,12 @@ private:
 	ElapsedTime m_elapsedUpdate;
 	ElapsedTime m_elapsedRender;
 
+	bool m_fixedTimestep;
+	uint32_t m_maxUpdateSteps;
+	Time m_accumulator;
+	Time m_lastFrame;
+	float m_alpha;
+
 	ChangePerSecond m_ups, m_fps;
 };
 }
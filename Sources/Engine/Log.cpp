@@ -1,18 +1,435 @@
 #include "Log.hpp"
 
+#include <condition_variable>
+#include <csignal>
+#include <thread>
+#include <fcntl.h>
+#if defined(ACID_BUILD_WINDOWS)
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
 namespace acid {
-std::mutex Log::WriteMutex;
-std::ofstream Log::FileStream;
+namespace {
+#if defined(ACID_BUILD_WINDOWS)
+constexpr int OutDescriptor = 1;
+#else
+constexpr int OutDescriptor = STDOUT_FILENO;
+#endif
+
+/**
+ * Writes bytes to a file descriptor with only system calls, so it can be used from a signal handler.
+ */
+void WriteDescriptor(int fd, const char *data, std::size_t size) {
+	while (size > 0) {
+#if defined(ACID_BUILD_WINDOWS)
+		auto written = _write(fd, data, static_cast<unsigned int>(size));
+#else
+		auto written = write(fd, data, size);
+#endif
+
+		if (written <= 0) {
+			return;
+		}
+
+		data += written;
+		size -= static_cast<std::size_t>(written);
+	}
+}
+
+/**
+ * A single producer single consumer byte ring owned by one thread, records are a header followed by the message bytes.
+ */
+struct Queue {
+	struct Header {
+		uint64_t m_sequence;
+		uint32_t m_size;
+	};
+
+	std::unique_ptr<char[]> m_data = std::make_unique<char[]>(Log::QueueCapacity);
+	alignas(64) std::atomic<uint64_t> m_head = 0;
+	alignas(64) std::atomic<uint64_t> m_tail = 0;
+
+	void Copy(uint64_t position, const void *src, std::size_t size) {
+		auto offset = position % Log::QueueCapacity;
+		auto first = std::min(size, Log::QueueCapacity - offset);
+		std::memcpy(&m_data[offset], src, first);
+		std::memcpy(&m_data[0], static_cast<const char *>(src) + first, size - first);
+	}
+
+	void Read(uint64_t position, void *dst, std::size_t size) const {
+		auto offset = position % Log::QueueCapacity;
+		auto first = std::min(size, Log::QueueCapacity - offset);
+		std::memcpy(dst, &m_data[offset], first);
+		std::memcpy(static_cast<char *>(dst) + first, &m_data[0], size - first);
+	}
+
+	void Write(int fd, uint64_t position, std::size_t size) const {
+		auto offset = position % Log::QueueCapacity;
+		auto first = std::min(size, Log::QueueCapacity - offset);
+		WriteDescriptor(fd, &m_data[offset], first);
+		WriteDescriptor(fd, &m_data[0], size - first);
+	}
+};
+
+/**
+ * Formats messages into a reused string instead of allocating a new stream per message.
+ */
+class MessageBuffer : public std::streambuf {
+public:
+	std::string m_message;
+
+protected:
+	int_type overflow(int_type c) override {
+		if (c != traits_type::eof()) {
+			m_message.push_back(static_cast<char>(c));
+		}
+
+		return c;
+	}
+
+	std::streamsize xsputn(const char *s, std::streamsize n) override {
+		m_message.append(s, static_cast<std::size_t>(n));
+		return n;
+	}
+};
+
+struct ThreadMessage {
+	MessageBuffer m_buffer;
+	std::ostream m_stream{&m_buffer};
+	std::ios_base::fmtflags m_flags = m_stream.flags();
+};
+
+class Logger {
+public:
+	Logger() :
+		m_thread(&Logger::Run, this) {
+		Instance = this;
+	}
+
+	~Logger() {
+		// Anything logged from here on is written directly.
+		Destroyed = true;
+		Instance = nullptr;
+
+		{
+			std::unique_lock<std::mutex> lock(m_wakeMutex);
+			m_stop = true;
+		}
+
+		m_wake.notify_one();
+		m_thread.join();
+	}
+
+	static Logger &Get() {
+		static Logger logger;
+		return logger;
+	}
+
+	Queue &GetQueue() {
+		thread_local std::shared_ptr<Queue> queue = [this]() {
+			auto queue = std::make_shared<Queue>();
+			std::unique_lock<std::mutex> lock(m_queuesMutex);
+			m_queues.emplace_back(queue);
+			return queue;
+		}();
+		return *queue;
+	}
+
+	void Push(const std::string &message) {
+		auto &queue = GetQueue();
+		auto size = sizeof(Queue::Header) + message.size();
+		m_messages.fetch_add(1, std::memory_order_relaxed);
+
+		if (size > Log::QueueCapacity) {
+			m_overflowed.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+
+		auto tail = queue.m_tail.load(std::memory_order_relaxed);
+
+		if (tail + size - queue.m_head.load(std::memory_order_acquire) > Log::QueueCapacity) {
+			m_dropped.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+
+		Queue::Header header = {m_sequence.fetch_add(1, std::memory_order_relaxed), static_cast<uint32_t>(message.size())};
+		queue.Copy(tail, &header, sizeof(header));
+		queue.Copy(tail + sizeof(header), message.data(), message.size());
+		queue.m_tail.store(tail + size, std::memory_order_release);
+
+		// Wakes the writer early when a queue is filling up faster than it is drained.
+		if (tail + size - queue.m_head.load(std::memory_order_relaxed) > Log::QueueCapacity / 2) {
+			m_wake.notify_one();
+		}
+	}
+
+	void Drain() {
+		std::vector<std::shared_ptr<Queue>> queues;
+
+		{
+			std::unique_lock<std::mutex> lock(m_queuesMutex);
+
+			// Queues of threads that have exited are dropped once empty.
+			m_queues.erase(std::remove_if(m_queues.begin(), m_queues.end(), [](const std::shared_ptr<Queue> &queue) {
+				return queue.use_count() == 1 && queue->m_head.load(std::memory_order_relaxed) == queue->m_tail.load(std::memory_order_acquire);
+			}), m_queues.end());
+			queues = m_queues;
+		}
+
+		m_records.clear();
+		m_text.clear();
+
+		for (auto &queue : queues) {
+			auto head = queue->m_head.load(std::memory_order_relaxed);
+			auto tail = queue->m_tail.load(std::memory_order_acquire);
+
+			while (head != tail) {
+				Queue::Header header;
+				queue->Read(head, &header, sizeof(header));
+				auto offset = m_text.size();
+				m_text.resize(offset + header.m_size);
+				queue->Read(head + sizeof(header), &m_text[offset], header.m_size);
+				m_records.push_back({header.m_sequence, offset, header.m_size});
+				head += sizeof(header) + header.m_size;
+			}
+
+			queue->m_head.store(head, std::memory_order_release);
+		}
+
+		if (m_records.empty()) {
+			return;
+		}
+
+		// Messages from different threads are written in the order they were logged.
+		std::sort(m_records.begin(), m_records.end(), [](const Record &a, const Record &b) {
+			return a.m_sequence < b.m_sequence;
+		});
+
+		m_batch.clear();
+
+		for (const auto &record : m_records) {
+			m_batch.append(m_text, record.m_offset, record.m_size);
+		}
+
+		std::cout.write(m_batch.data(), static_cast<std::streamsize>(m_batch.size()));
+		std::cout.flush();
+
+		if (m_file.is_open()) {
+			m_file.write(m_batch.data(), static_cast<std::streamsize>(m_batch.size()));
+			m_file.flush();
+		}
+	}
+
+	/**
+	 * Writes the queued messages straight from the queues with only system calls, so it can be used from a signal handler.
+	 * Threads are written one after another instead of in the order they logged, and nothing is written if another thread holds a lock.
+	 */
+	void DrainRaw() {
+		if (!m_drainMutex.try_lock()) {
+			return;
+		}
+
+		if (!m_queuesMutex.try_lock()) {
+			m_drainMutex.unlock();
+			return;
+		}
+
+		for (const auto &queue : m_queues) {
+			auto head = queue->m_head.load(std::memory_order_relaxed);
+			auto tail = queue->m_tail.load(std::memory_order_acquire);
+
+			while (head != tail) {
+				Queue::Header header;
+				queue->Read(head, &header, sizeof(header));
+				queue->Write(OutDescriptor, head + sizeof(header), header.m_size);
+
+				if (m_fileDescriptor >= 0) {
+					queue->Write(m_fileDescriptor, head + sizeof(header), header.m_size);
+				}
+
+				head += sizeof(header) + header.m_size;
+			}
+
+			queue->m_head.store(head, std::memory_order_release);
+		}
+
+		m_queuesMutex.unlock();
+		m_drainMutex.unlock();
+	}
+
+	std::mutex &GetDrainMutex() { return m_drainMutex; }
+
+	void OpenFile(const std::filesystem::path &filepath) {
+		m_file.open(filepath);
+#if defined(ACID_BUILD_WINDOWS)
+		m_fileDescriptor = _wopen(filepath.c_str(), _O_WRONLY | _O_APPEND);
+#else
+		m_fileDescriptor = open(filepath.c_str(), O_WRONLY | O_APPEND | O_CLOEXEC);
+#endif
+	}
+
+	void CloseFile() {
+		m_file.close();
+
+		if (m_fileDescriptor >= 0) {
+#if defined(ACID_BUILD_WINDOWS)
+			_close(m_fileDescriptor);
+#else
+			close(m_fileDescriptor);
+#endif
+			m_fileDescriptor = -1;
+		}
+	}
+
+	Log::Stats GetStats() const {
+		return {m_messages.load(std::memory_order_relaxed), m_dropped.load(std::memory_order_relaxed), m_overflowed.load(std::memory_order_relaxed)};
+	}
+
+	static inline std::atomic<bool> Destroyed = false;
+	// Read from signal handlers, which can't start the logger.
+	static inline std::atomic<Logger *> Instance = nullptr;
+
+private:
+	struct Record {
+		uint64_t m_sequence;
+		std::size_t m_offset;
+		std::size_t m_size;
+	};
+
+	void Run() {
+		while (true) {
+			{
+				std::unique_lock<std::mutex> lock(m_wakeMutex);
+				m_wake.wait_for(lock, std::chrono::milliseconds(10), [this]() { return m_stop; });
+			}
+
+			std::unique_lock<std::mutex> lock(m_drainMutex);
+			Drain();
+
+			if (m_stop) {
+				return;
+			}
+		}
+	}
+
+	std::mutex m_queuesMutex;
+	std::vector<std::shared_ptr<Queue>> m_queues;
+
+	std::atomic<uint64_t> m_sequence = 0;
+	std::atomic<uint64_t> m_messages = 0;
+	std::atomic<uint64_t> m_dropped = 0;
+	std::atomic<uint64_t> m_overflowed = 0;
+
+	// Only touched while holding the drain mutex.
+	std::mutex m_drainMutex;
+	std::ofstream m_file;
+	// The log file opened again for appending, written by signal handlers that can't use the stream.
+	int m_fileDescriptor = -1;
+	std::vector<Record> m_records;
+	std::string m_text;
+	std::string m_batch;
+
+	std::mutex m_wakeMutex;
+	std::condition_variable m_wake;
+	bool m_stop = false;
+	std::thread m_thread;
+};
+
+ThreadMessage &GetThreadMessage() {
+	thread_local ThreadMessage message;
+	return message;
+}
+
+std::terminate_handler PreviousTerminate = nullptr;
+
+void FlushOnSignal(int signal) {
+	// Best effort, the queues may be in any state if the crash happened inside the logger.
+	if (auto logger = Logger::Instance.load()) {
+		logger->DrainRaw();
+	}
+
+	std::signal(signal, SIG_DFL);
+	std::raise(signal);
+}
+}
+
+std::ostream &Log::BeginMessage() {
+	auto &message = GetThreadMessage();
+	message.m_buffer.m_message.clear();
+	message.m_stream.flags(message.m_flags);
+	return message.m_stream;
+}
+
+void Log::EndMessage() {
+	auto &message = GetThreadMessage().m_buffer.m_message;
+
+	// Messages during static destruction, after the logger thread is gone, are written directly.
+	if (Logger::Destroyed) {
+		std::cout << message;
+		return;
+	}
+
+	Logger::Get().Push(message);
+}
+
+const std::string &Log::GetTimestamp() {
+	thread_local std::time_t lastTime = -1;
+	thread_local std::string timestamp;
+
+	if (auto now = std::time(nullptr); now != lastTime) {
+		lastTime = now;
+		timestamp = Time::GetDateTime(TimestampFormat);
+	}
+
+	return timestamp;
+}
+
+void Log::Flush() {
+	auto &logger = Logger::Get();
+	std::unique_lock<std::mutex> lock(logger.GetDrainMutex());
+	logger.Drain();
+}
+
+Log::Stats Log::GetStats() {
+	return Logger::Get().GetStats();
+}
+
+void Log::InstallCrashHandler() {
+	for (auto signal : {SIGSEGV, SIGABRT, SIGFPE, SIGILL}) {
+		std::signal(signal, FlushOnSignal);
+	}
+
+	PreviousTerminate = std::set_terminate([]() {
+		// The terminating thread may already hold the lock, such as when a write to the log file throws.
+		if (auto logger = Logger::Instance.load(); logger && logger->GetDrainMutex().try_lock()) {
+			logger->Drain();
+			logger->GetDrainMutex().unlock();
+		}
+
+		if (PreviousTerminate) {
+			PreviousTerminate();
+		}
+
+		std::abort();
+	});
+}
 
 void Log::OpenLog(const std::filesystem::path &filepath) {
-	//std::unique_lock<std::mutex> lock(WriteMutex);
 	if (auto parentPath = filepath.parent_path(); !parentPath.empty()) {
 		std::filesystem::create_directories(parentPath);
 	}
-	FileStream.open(filepath);
+
+	auto &logger = Logger::Get();
+	std::unique_lock<std::mutex> lock(logger.GetDrainMutex());
+	logger.OpenFile(filepath);
 }
 
 void Log::CloseLog() {
-	FileStream.close();
+	auto &logger = Logger::Get();
+	std::unique_lock<std::mutex> lock(logger.GetDrainMutex());
+	logger.Drain();
+	logger.CloseFile();
 }
 }
@@ -2,12 +2,41 @@
 
 #include "Maths/Time.hpp"
 
+/**
+ * The lowest severity compiled into log calls, 0 debug, 1 info, 2 warning, 3 error. Calls below it compile to nothing.
+ */
+#if !defined(ACID_LOG_LEVEL)
+#  if defined(ACID_DEBUG)
+#    define ACID_LOG_LEVEL 0
+#  else
+#    define ACID_LOG_LEVEL 1
+#  endif
+#endif
+
 namespace acid {
 /**
  * @brief A logging class used in Acid, will write output to the standard stream and into a file.
+ * Messages are formatted on the calling thread into a bounded per-thread queue, and a background thread writes them out in batches.
  */
 class ACID_EXPORT Log {
 public:
+	/// The number of bytes each thread can have queued, messages that don't fit are dropped.
+	static constexpr std::size_t QueueCapacity = 64 * 1024;
+
+	enum class Level : uint8_t { Debug, Info, Warning, Error };
+
+	/**
+	 * @brief Counters of the messages passed to the logger since it started.
+	 */
+	struct Stats {
+		/// The number of messages logged, including dropped ones.
+		uint64_t m_messages = 0;
+		/// The number of messages dropped because their thread's queue was full.
+		uint64_t m_dropped = 0;
+		/// The number of messages dropped because they were larger than a whole queue.
+		uint64_t m_overflowed = 0;
+	};
+
 	class Style {
 	public:
 		static constexpr std::string_view Default = "\033[0m";
@@ -71,9 +100,9 @@ public:
 	 */
 	template<typename ... Args>
 	static void Debug(Args ... args) {
-#ifdef ACID_DEBUG
-		Out(Style::Default, Colour::LightBlue, args...);
-#endif
+		if constexpr (ACID_LOG_LEVEL <= static_cast<int32_t>(Level::Debug)) {
+			Out(Style::Default, Colour::LightBlue, args...);
+		}
 	}
 
 	/**
@@ -83,7 +112,9 @@ public:
 	 */
 	template<typename ... Args>
 	static void Info(Args ... args) {
-		Out(Style::Default, Colour::Green, args...);
+		if constexpr (ACID_LOG_LEVEL <= static_cast<int32_t>(Level::Info)) {
+			Out(Style::Default, Colour::Green, args...);
+		}
 	}
 
 	/**
@@ -93,7 +124,9 @@ public:
 	 */
 	template<typename ... Args>
 	static void Warning(Args ... args) {
-		Out(Style::Default, Colour::Yellow, args...);
+		if constexpr (ACID_LOG_LEVEL <= static_cast<int32_t>(Level::Warning)) {
+			Out(Style::Default, Colour::Yellow, args...);
+		}
 	}
 
 	/**
@@ -103,7 +136,9 @@ public:
 	 */
 	template<typename ... Args>
 	static void Error(Args ... args) {
-		Out(Style::Default, Colour::Red, args...);
+		if constexpr (ACID_LOG_LEVEL <= static_cast<int32_t>(Level::Error)) {
+			Out(Style::Default, Colour::Red, args...);
+		}
 	}
 
 	/**
@@ -120,34 +155,60 @@ public:
 		}
 	}
 
+	/**
+	 * Gets if messages of a severity are compiled in, set by {@code ACID_LOG_LEVEL}.
+	 * @param level The severity.
+	 * @return If the severity is logged.
+	 */
+	static constexpr bool IsEnabled(Level level) { return static_cast<int32_t>(level) >= ACID_LOG_LEVEL; }
+
+	/**
+	 * Gets the current time formatted with {@link Log#TimestampFormat}, only rebuilt once a second per thread.
+	 * @return The timestamp.
+	 */
+	static const std::string &GetTimestamp();
+
+	/**
+	 * Blocks until every message queued before this call has been written.
+	 */
+	static void Flush();
+
+	/**
+	 * Gets the logger's message and drop counters.
+	 * @return The logger stats.
+	 */
+	static Stats GetStats();
+
+	/**
+	 * Installs signal and terminate handlers that flush queued messages before the process dies.
+	 * Signal handlers only write the already formatted messages with system calls, and neither handler waits for a lock.
+	 */
+	static void InstallCrashHandler();
+
 	static void OpenLog(const std::filesystem::path &filepath);
 	static void CloseLog();
 
 private:
-	// TODO: Only use mutex in synced writes (where output order must be the same).
-	static std::mutex WriteMutex;
-	static std::ofstream FileStream;
+	static std::ostream &BeginMessage();
+	static void EndMessage();
 
 	/**
-	 * A internal method used to write values to the out stream and to a file.
+	 * A internal method used to queue values to be written to the out stream and to a file.
 	 * @tparam Args The value types to write.
 	 * @param args The values to write.
 	 */
 	template<typename ... Args>
 	static void Write(Args ... args) {
-		std::unique_lock<std::mutex> lock(WriteMutex);
-		
-		((std::cout << std::forward<Args>(args)), ...);
-		if (FileStream.is_open()) {
-			((FileStream << std::forward<Args>(args)), ...);
-		}
+		auto &stream = BeginMessage();
+		((stream << std::forward<Args>(args)), ...);
+		EndMessage();
 	}
 };
 
 template<typename T>
 class Loggable {
 protected:
-#define MESSAGE_PREFIX Time::GetDateTime(Log::TimestampFormat), " [", typeid(T).name(), "]"
+#define MESSAGE_PREFIX Log::GetTimestamp(), " [", typeid(T).name(), "]"
 #define MESSAGE_PREFIX_THIS "(0x", std::hex, std::uppercase, reinterpret_cast<long>(this), ") ", std::dec
 
 	template<typename ... Args>
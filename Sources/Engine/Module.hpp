@@ -2,6 +2,7 @@
 
 #include "Helpers/NonCopyable.hpp"
 #include "Helpers/TypeInfo.hpp"
+#include "Maths/Time.hpp"
 
 namespace acid {
 template<typename Base>
@@ -27,6 +28,93 @@ public:
 		return ++id;
 	}
 
+	/**
+	 * Gets a counter that changes every time a module is registered or deregistered.
+	 * @return The registry version.
+	 */
+	static std::size_t &RegistryVersion() {
+		static std::size_t version = 0;
+		return version;
+	}
+
+	/**
+	 * @brief Declares what a module reads and writes in <seealso cref="Module#Update()"/>, so modules in the same stage that don't conflict can update in parallel.
+	 * A module always writes to itself.
+	 */
+	class Access {
+	public:
+		/**
+		 * Creates a access that conflicts with every other module in the stage and runs on the main thread, used when none is declared.
+		 * @return The exclusive access.
+		 */
+		static Access Exclusive() {
+			Access access;
+			access.m_exclusive = true;
+			access.m_mainThread = true;
+			return access;
+		}
+
+		/**
+		 * Declares modules this module reads from, this module will be updated after them.
+		 * @tparam Ts The module types.
+		 * @return This access.
+		 */
+		template<typename... Ts>
+		Access &Reads() {
+			(m_reads.emplace_back(TypeInfo<Base>::template GetTypeId<Ts>()), ...);
+			return *this;
+		}
+
+		/**
+		 * Declares modules this module writes to, this module will be updated after them.
+		 * @tparam Ts The module types.
+		 * @return This access.
+		 */
+		template<typename... Ts>
+		Access &Writes() {
+			(m_writes.emplace_back(TypeInfo<Base>::template GetTypeId<Ts>()), ...);
+			return *this;
+		}
+
+		/**
+		 * Declares that this module must be updated on the main thread, for windowing and other thread bound APIs.
+		 * @return This access.
+		 */
+		Access &MainThread() {
+			m_mainThread = true;
+			return *this;
+		}
+
+		/**
+		 * Gets if a module with this access must be updated before or after another, registered later in the same stage.
+		 * @param other The access of the later module.
+		 * @return If the two accesses conflict.
+		 */
+		bool ConflictsWith(const Access &other) const {
+			if (m_exclusive || other.m_exclusive) {
+				return true;
+			}
+
+			auto intersects = [](const std::vector<TypeId> &a, const std::vector<TypeId> &b) {
+				return std::find_first_of(a.begin(), a.end(), b.begin(), b.end()) != a.end();
+			};
+			return intersects(m_writes, other.m_writes) || intersects(m_writes, other.m_reads) || intersects(m_reads, other.m_writes);
+		}
+
+		const std::vector<TypeId> &GetReads() const { return m_reads; }
+		const std::vector<TypeId> &GetWrites() const { return m_writes; }
+		bool IsMainThread() const { return m_mainThread; }
+		bool IsExclusive() const { return m_exclusive; }
+
+	private:
+		friend class ModuleFactory;
+
+		std::vector<TypeId> m_reads;
+		std::vector<TypeId> m_writes;
+		bool m_mainThread = false;
+		bool m_exclusive = false;
+	};
+
 	template<typename T>
 	class Registrar : public Base {
 	public:
@@ -38,12 +126,26 @@ public:
 
 		/**
 		 * Creates a new module singleton instance and registers into the module registry map.
+		 * The module will be updated alone on the main thread, in registration order.
 		 * @param stage The stage where <seealso cref="Module#Update()"/> will be called from the engine.
 		 * @return A dummy value in static initialization.
 		 */
 		static bool Register(Stage stage) {
+			return Register(stage, Access::Exclusive());
+		}
+
+		/**
+		 * Creates a new module singleton instance and registers into the module registry map.
+		 * @param stage The stage where <seealso cref="Module#Update()"/> will be called from the engine.
+		 * @param access What the module reads and writes, used to update non-conflicting modules in parallel.
+		 * @return A dummy value in static initialization.
+		 */
+		static bool Register(Stage stage, Access access) {
+			access.m_writes.emplace_back(TypeInfo<Base>::template GetTypeId<T>());
 			auto it = Registry().insert({StageIndex(stage, GetNextId()), std::make_unique<T>()});
+			it->second->m_access = std::move(access);
 			ModuleInstance = dynamic_cast<T *>(it->second.get());
+			++RegistryVersion();
 			return true;
 		}
 
@@ -60,6 +162,7 @@ public:
 				}
 			}
 			ModuleInstance = nullptr;
+			++RegistryVersion();
 			return true;
 		}
 		
@@ -73,6 +176,8 @@ public:
  * @brief A interface used for defining engine modules.
  */
 class ACID_EXPORT Module : public ModuleFactory<Module>, public virtual NonCopyable {
+	friend class ModuleFactory<Module>;
+	friend class ModuleGraph;
 public:
 	virtual ~Module() = default;
 
@@ -80,5 +185,21 @@ public:
 	 * The update function for the module.
 	 */
 	virtual void Update() = 0;
+
+	/**
+	 * Gets what this module declared it reads and writes when it was registered.
+	 * @return The module access.
+	 */
+	const Access &GetAccess() const { return m_access; }
+
+	/**
+	 * Gets how long the last call to <seealso cref="Module#Update()"/> took.
+	 * @return The last update time.
+	 */
+	const Time &GetUpdateTime() const { return m_updateTime; }
+
+private:
+	Access m_access = Access::Exclusive();
+	Time m_updateTime;
 };
 }
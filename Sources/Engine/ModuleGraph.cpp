@@ -0,0 +1,130 @@
+#include "ModuleGraph.hpp"
+
+#include "Profiler.hpp"
+
+namespace acid {
+void ModuleGraph::Build(const std::vector<Module *> &modules) {
+	m_nodes.clear();
+	m_nodes.reserve(modules.size());
+	m_serial = true;
+
+	for (auto module : modules) {
+		auto &node = m_nodes.emplace_back(std::make_unique<Node>());
+		node->m_module = module;
+
+		if (!module->GetAccess().IsMainThread()) {
+			m_serial = false;
+		}
+	}
+
+	// Registration order is a valid topological order, so edges only ever point forward.
+	for (uint32_t i = 0; i < m_nodes.size(); i++) {
+		for (uint32_t j = i + 1; j < m_nodes.size(); j++) {
+			if (m_nodes[i]->m_module->GetAccess().ConflictsWith(m_nodes[j]->m_module->GetAccess())) {
+				m_nodes[i]->m_dependents.emplace_back(j);
+				m_nodes[j]->m_dependencies++;
+			}
+		}
+	}
+
+	if (m_nodes.size() <= 1) {
+		m_serial = true;
+	}
+}
+
+void ModuleGraph::Update(JobSystem &jobSystem) {
+	auto start = Time::Now();
+
+	if (m_serial) {
+		for (auto &node : m_nodes) {
+			UpdateModule(*node->m_module);
+		}
+	} else {
+		m_completed.store(0, std::memory_order_relaxed);
+
+		for (auto &node : m_nodes) {
+			node->m_remaining.store(node->m_dependencies, std::memory_order_relaxed);
+		}
+
+		for (uint32_t i = 0; i < m_nodes.size(); i++) {
+			if (m_nodes[i]->m_dependencies == 0) {
+				Schedule(i, jobSystem);
+			}
+		}
+
+		auto count = static_cast<uint32_t>(m_nodes.size());
+
+		while (m_completed.load(std::memory_order_acquire) != count) {
+			std::optional<uint32_t> index;
+
+			{
+				std::unique_lock<std::mutex> lock(m_mainMutex);
+
+				if (!m_mainReady.empty()) {
+					index = m_mainReady.back();
+					m_mainReady.pop_back();
+				}
+			}
+
+			if (index) {
+				UpdateModule(*m_nodes[*index]->m_module);
+				Complete(*index, jobSystem);
+			} else if (!jobSystem.RunPending()) {
+				std::this_thread::yield();
+			}
+		}
+	}
+
+	m_elapsed = Time::Now() - start;
+	UpdateTimings();
+}
+
+void ModuleGraph::Schedule(uint32_t index, JobSystem &jobSystem) {
+	if (m_nodes[index]->m_module->GetAccess().IsMainThread()) {
+		std::unique_lock<std::mutex> lock(m_mainMutex);
+		m_mainReady.emplace_back(index);
+		return;
+	}
+
+	jobSystem.Run([this, &jobSystem, index]() {
+		UpdateModule(*m_nodes[index]->m_module);
+		Complete(index, jobSystem);
+	});
+}
+
+void ModuleGraph::Complete(uint32_t index, JobSystem &jobSystem) {
+	for (auto dependent : m_nodes[index]->m_dependents) {
+		if (m_nodes[dependent]->m_remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+			Schedule(dependent, jobSystem);
+		}
+	}
+
+	m_completed.fetch_add(1, std::memory_order_release);
+}
+
+void ModuleGraph::UpdateTimings() {
+	m_serialTime = 0s;
+	m_criticalPath = 0s;
+
+	// The longest path ending at each node, nodes are already in topological order.
+	std::vector<Time> paths(m_nodes.size());
+
+	for (uint32_t i = 0; i < m_nodes.size(); i++) {
+		auto &updateTime = m_nodes[i]->m_module->GetUpdateTime();
+		m_serialTime += updateTime;
+		paths[i] += updateTime;
+		m_criticalPath = std::max(m_criticalPath, paths[i]);
+
+		for (auto dependent : m_nodes[i]->m_dependents) {
+			paths[dependent] = std::max(paths[dependent], paths[i]);
+		}
+	}
+}
+
+void ModuleGraph::UpdateModule(Module &module) {
+	ACID_PROFILE_SCOPE(typeid(module).name());
+	auto start = Time::Now();
+	module.Update();
+	module.m_updateTime = Time::Now() - start;
+}
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "Helpers/JobSystem.hpp"
+#include "Module.hpp"
+
+namespace acid {
+/**
+ * @brief A dependency graph of the modules in one stage. Modules that don't conflict are updated in parallel on the job system,
+ * modules bound to the main thread are updated by the thread calling {@link ModuleGraph#Update}.
+ */
+class ACID_EXPORT ModuleGraph : public virtual NonCopyable {
+public:
+	ModuleGraph() = default;
+
+	/**
+	 * Rebuilds the graph, a module depends on every module registered before it in the stage that it conflicts with.
+	 * @param modules The modules in the stage, in registration order.
+	 */
+	void Build(const std::vector<Module *> &modules);
+
+	/**
+	 * Updates every module in the graph, returning once they have all finished.
+	 * @param jobSystem The job system to run worker modules on.
+	 */
+	void Update(JobSystem &jobSystem);
+
+	/**
+	 * Gets the wall time the last update of this graph took.
+	 * @return The elapsed time.
+	 */
+	const Time &GetElapsed() const { return m_elapsed; }
+
+	/**
+	 * Gets the sum of every module's update time in the last update, the time a serial update would have taken.
+	 * @return The serial time.
+	 */
+	const Time &GetSerialTime() const { return m_serialTime; }
+
+	/**
+	 * Gets the time of the longest dependency chain in the last update, the best case for a parallel update.
+	 * @return The critical path time.
+	 */
+	const Time &GetCriticalPath() const { return m_criticalPath; }
+
+	bool IsEmpty() const { return m_nodes.empty(); }
+
+private:
+	struct Node {
+		Module *m_module = nullptr;
+		std::vector<uint32_t> m_dependents;
+		uint32_t m_dependencies = 0;
+		std::atomic<uint32_t> m_remaining = 0;
+	};
+
+	void Schedule(uint32_t index, JobSystem &jobSystem);
+	void Complete(uint32_t index, JobSystem &jobSystem);
+	void UpdateTimings();
+
+	static void UpdateModule(Module &module);
+
+	std::vector<std::unique_ptr<Node>> m_nodes;
+	bool m_serial = true;
+
+	std::atomic<uint32_t> m_completed = 0;
+	std::mutex m_mainMutex;
+	std::vector<uint32_t> m_mainReady;
+
+	Time m_elapsed;
+	Time m_serialTime;
+	Time m_criticalPath;
+};
+}
@@ -0,0 +1,237 @@
+#include "Profiler.hpp"
+
+#include <mutex>
+#include <thread>
+#if defined(ACID_BUILD_GNU) || defined(ACID_BUILD_CLANG)
+#include <cxxabi.h>
+#endif
+
+namespace acid {
+namespace {
+struct Event {
+	const char *m_name;
+	Time m_start;
+	Time m_end;
+};
+
+// A event in a ring buffer, fields are atomic as the writer may overwrite a slot while a trace copies it.
+struct EventSlot {
+	std::atomic<const char *> m_name;
+	std::atomic<int64_t> m_start;
+	std::atomic<int64_t> m_end;
+};
+
+struct ThreadBuffer {
+	uint32_t m_id = 0;
+	std::string m_name;
+	std::unique_ptr<EventSlot[]> m_events = std::make_unique<EventSlot[]>(Profiler::EventCapacity);
+	/// The number of events the owning thread has started writing.
+	std::atomic<uint64_t> m_claimed = 0;
+	/// The number of events completely written, a trace only reads events below this.
+	std::atomic<uint64_t> m_written = 0;
+	/// The first event written by the thread that currently owns this buffer.
+	uint64_t m_first = 0;
+	bool m_free = false;
+};
+
+// Buffers are shared so zones recorded by a thread can still be written after it exits,
+// a exited thread's buffer is handed to the next new thread so memory is bounded by the peak thread count.
+std::mutex BuffersMutex;
+std::vector<std::shared_ptr<ThreadBuffer>> Buffers;
+uint32_t NextThreadId = 0;
+
+std::array<std::atomic<int64_t>, Profiler::FrameCapacity> Frames;
+std::atomic<uint64_t> FrameCount = 0;
+
+class ThreadBufferOwner {
+public:
+	ThreadBufferOwner() {
+		std::unique_lock<std::mutex> lock(BuffersMutex);
+		auto it = std::find_if(Buffers.begin(), Buffers.end(), [](const auto &buffer) {
+			return buffer->m_free;
+		});
+
+		if (it != Buffers.end()) {
+			m_buffer = *it;
+			m_buffer->m_free = false;
+			m_buffer->m_first = m_buffer->m_written.load(std::memory_order_relaxed);
+		} else {
+			m_buffer = Buffers.emplace_back(std::make_shared<ThreadBuffer>());
+		}
+
+		m_buffer->m_id = NextThreadId++;
+		m_buffer->m_name = "Thread " + std::to_string(m_buffer->m_id);
+	}
+
+	~ThreadBufferOwner() {
+		std::unique_lock<std::mutex> lock(BuffersMutex);
+		m_buffer->m_free = true;
+	}
+
+	ThreadBuffer &GetBuffer() const { return *m_buffer; }
+
+private:
+	std::shared_ptr<ThreadBuffer> m_buffer;
+};
+
+ThreadBuffer &GetThreadBuffer() {
+	thread_local ThreadBufferOwner owner;
+	return owner.GetBuffer();
+}
+
+std::string Demangle(const char *name) {
+#if defined(ACID_BUILD_GNU) || defined(ACID_BUILD_CLANG)
+	// Only type names from typeid are mangled, they start with a length or a nested name.
+	if (std::isdigit(name[0]) || (name[0] == 'N' && std::isdigit(name[1]))) {
+		int32_t status = 0;
+
+		if (auto demangled = abi::__cxa_demangle(name, nullptr, nullptr, &status); status == 0) {
+			std::string result(demangled);
+			std::free(demangled);
+			return result;
+		}
+	}
+#endif
+	return name;
+}
+
+void WriteEscaped(std::ostream &stream, const std::string &string) {
+	for (auto c : string) {
+		if (c == '"' || c == '\\') {
+			stream << '\\';
+		}
+
+		stream << c;
+	}
+}
+}
+
+#if defined(ACID_PROFILING)
+std::atomic<bool> Profiler::Enabled = true;
+#else
+std::atomic<bool> Profiler::Enabled = false;
+#endif
+
+void Profiler::SetThreadName(const std::string &name) {
+	auto &buffer = GetThreadBuffer();
+	std::unique_lock<std::mutex> lock(BuffersMutex);
+	buffer.m_name = name;
+}
+
+void Profiler::Record(const char *name, const Time &start, const Time &end) {
+	auto &buffer = GetThreadBuffer();
+	auto written = buffer.m_written.load(std::memory_order_relaxed);
+	// The claim is ordered before the slot changes, so a trace that reads any of the new fields also sees the slot was overwritten.
+	buffer.m_claimed.store(written + 1, std::memory_order_relaxed);
+
+	auto &slot = buffer.m_events[written & (EventCapacity - 1)];
+	slot.m_name.store(name, std::memory_order_release);
+	slot.m_start.store(start.AsMicroseconds(), std::memory_order_release);
+	slot.m_end.store(end.AsMicroseconds(), std::memory_order_release);
+	buffer.m_written.store(written + 1, std::memory_order_release);
+}
+
+void Profiler::MarkFrame() {
+	auto count = FrameCount.load(std::memory_order_relaxed);
+	Frames[count % FrameCapacity].store(Time::Now().AsMicroseconds(), std::memory_order_relaxed);
+	FrameCount.store(count + 1, std::memory_order_release);
+}
+
+void Profiler::WriteTrace(const std::filesystem::path &filename, uint32_t frames) {
+	// Finds the start of the oldest frame to write.
+	int64_t from = 0;
+	auto frameCount = FrameCount.load(std::memory_order_acquire);
+	frames = static_cast<uint32_t>(std::min<uint64_t>({frames, frameCount, FrameCapacity - 1}));
+
+	// Frame marks are at the end of each frame, so the frame before the oldest marks where it starts.
+	if (frames < frameCount) {
+		from = Frames[(frameCount - frames - 1) % FrameCapacity].load(std::memory_order_relaxed);
+	}
+
+	struct BufferView {
+		std::shared_ptr<ThreadBuffer> m_buffer;
+		uint32_t m_id;
+		std::string m_name;
+		uint64_t m_first;
+	};
+
+	std::vector<BufferView> buffers;
+
+	{
+		std::unique_lock<std::mutex> lock(BuffersMutex);
+
+		for (const auto &buffer : Buffers) {
+			buffers.push_back({buffer, buffer->m_id, buffer->m_name, buffer->m_first});
+		}
+	}
+
+	if (auto parentPath = filename.parent_path(); !parentPath.empty()) {
+		std::filesystem::create_directories(parentPath);
+	}
+
+	std::ofstream stream(filename);
+	stream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+	auto first = true;
+	std::unordered_map<const char *, std::string> demangled;
+
+	auto separator = [&]() {
+		if (!first) {
+			stream << ",\n";
+		}
+
+		first = false;
+	};
+
+	for (const auto &view : buffers) {
+		auto &buffer = *view.m_buffer;
+		separator();
+		stream << R"({"name":"thread_name","ph":"M","pid":0,"tid":)" << view.m_id << R"(,"args":{"name":")";
+		WriteEscaped(stream, view.m_name);
+		stream << "\"}}";
+
+		// Copies out the events, the owning thread may keep writing while we read.
+		// Events from before the buffer was reused belong to a exited thread and are dropped.
+		auto written = buffer.m_written.load(std::memory_order_acquire);
+		auto begin = std::max(written > EventCapacity ? written - EventCapacity : 0, std::min(view.m_first, written));
+		std::vector<Event> events;
+		events.reserve(written - begin);
+
+		for (auto j = begin; j < written; j++) {
+			auto &slot = buffer.m_events[j & (EventCapacity - 1)];
+			events.push_back({slot.m_name.load(std::memory_order_acquire), Time::Microseconds(slot.m_start.load(std::memory_order_acquire)),
+				Time::Microseconds(slot.m_end.load(std::memory_order_acquire))});
+		}
+
+		// Any event the writer may have started overwriting during the copy is dropped.
+		auto claimed = buffer.m_claimed.load(std::memory_order_relaxed);
+		auto valid = claimed > EventCapacity ? claimed - EventCapacity : 0;
+
+		for (auto j = std::max(begin, valid); j < written; j++) {
+			auto &event = events[j - begin];
+
+			if (event.m_end.AsMicroseconds() < from) {
+				continue;
+			}
+
+			auto it = demangled.find(event.m_name);
+
+			if (it == demangled.end()) {
+				it = demangled.emplace(event.m_name, Demangle(event.m_name)).first;
+			}
+
+			separator();
+			stream << R"({"name":")";
+			WriteEscaped(stream, it->second);
+			stream << R"(","ph":"X","pid":0,"tid":)" << view.m_id << ",\"ts\":" << event.m_start.AsMicroseconds() << ",\"dur\":"
+				<< (event.m_end - event.m_start).AsMicroseconds() << '}';
+		}
+	}
+
+	for (auto i = frameCount - frames; i < frameCount; i++) {
+		separator();
+		stream << R"({"name":"Frame","ph":"i","s":"g","pid":0,"tid":0,"ts":)" << Frames[i % FrameCapacity].load(std::memory_order_relaxed) << '}';
+	}
+
+	stream << "]}\n";
+}
+}
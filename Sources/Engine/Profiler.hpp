@@ -0,0 +1,96 @@
+#pragma once
+
+#include <atomic>
+#include "Maths/Time.hpp"
+
+namespace acid {
+/**
+ * @brief A CPU profiler that records named zones into a lock-free ring buffer per thread, and can write the last frames as a Chrome trace.
+ * Zones are recorded with {@link ACID_PROFILE_SCOPE}, which compiles to nothing unless {@code ACID_PROFILING} is defined.
+ */
+class ACID_EXPORT Profiler {
+public:
+	/// The number of zones kept per thread, older zones are overwritten.
+	static constexpr std::size_t EventCapacity = 1 << 15;
+	/// The number of frame boundaries kept.
+	static constexpr std::size_t FrameCapacity = 1024;
+
+	/**
+	 * Enables or disables recording at runtime.
+	 * @param enabled If zones will be recorded.
+	 */
+	static void SetEnabled(bool enabled) { Enabled.store(enabled, std::memory_order_relaxed); }
+
+	/**
+	 * Gets if zones are being recorded.
+	 * @return If the profiler is enabled.
+	 */
+	static bool IsEnabled() { return Enabled.load(std::memory_order_relaxed); }
+
+	/**
+	 * Sets the name the calling thread is shown with in traces.
+	 * @param name The thread name.
+	 */
+	static void SetThreadName(const std::string &name);
+
+	/**
+	 * Records a zone for the calling thread.
+	 * @param name The zone name, must have static storage duration.
+	 * @param start The zone start time.
+	 * @param end The zone end time.
+	 */
+	static void Record(const char *name, const Time &start, const Time &end);
+
+	/**
+	 * Marks the boundary between two frames, called by the engine after each render.
+	 */
+	static void MarkFrame();
+
+	/**
+	 * Writes every zone recorded in the last frames as a Chrome trace JSON file, that can be opened in chrome://tracing or Perfetto.
+	 * @param filename The file to write to.
+	 * @param frames The number of frames to write.
+	 */
+	static void WriteTrace(const std::filesystem::path &filename, uint32_t frames = 60);
+
+private:
+	static std::atomic<bool> Enabled;
+};
+
+/**
+ * @brief Records a profiler zone from construction until it goes out of scope.
+ */
+class ACID_EXPORT ProfileScope {
+public:
+	explicit ProfileScope(const char *name) :
+		m_name(Profiler::IsEnabled() ? name : nullptr) {
+		if (m_name) {
+			m_start = Time::Now();
+		}
+	}
+
+	~ProfileScope() {
+		if (m_name) {
+			Profiler::Record(m_name, m_start, Time::Now());
+		}
+	}
+
+	ProfileScope(const ProfileScope &) = delete;
+	ProfileScope &operator=(const ProfileScope &) = delete;
+
+private:
+	const char *m_name;
+	Time m_start;
+};
+}
+
+#define ACID_PROFILE_CONCAT_IMPL(a, b) a##b
+#define ACID_PROFILE_CONCAT(a, b) ACID_PROFILE_CONCAT_IMPL(a, b)
+
+#if defined(ACID_PROFILING)
+#  define ACID_PROFILE_SCOPE(name) acid::ProfileScope ACID_PROFILE_CONCAT(profileScope, __LINE__)(name)
+#  define ACID_PROFILE_FRAME() acid::Profiler::MarkFrame()
+#else
+#  define ACID_PROFILE_SCOPE(name)
+#  define ACID_PROFILE_FRAME()
+#endif
@@ -27,6 +27,8 @@ File::File(std::filesystem::path filename, std::unique_ptr<Node> &&node) :
 }
 
 void File::Load(const std::filesystem::path &filename) {
+	ACID_PROFILE_SCOPE("File::Load");
+
 #if defined(ACID_DEBUG)
 	auto debugStart = Time::Now();
 #endif
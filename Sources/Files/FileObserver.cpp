@@ -1,21 +1,73 @@
 #include "FileObserver.hpp"
 
+#if defined(ACID_BUILD_LINUX)
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+#include "Engine/Log.hpp"
+
 namespace acid {
+/**
+ * @brief The changes found in a burst, merged so a file written many times or replaced by a rename is reported once, in the order first changed.
+ */
+class FileObserver::Changes {
+public:
+	void Add(const std::filesystem::path &path, Status status) {
+		auto [it, inserted] = m_indices.try_emplace(path.string(), m_changes.size());
+
+		if (inserted) {
+			m_changes.emplace_back(path, status);
+			return;
+		}
+
+		auto &change = m_changes[it->second].second;
+
+		if (!change) {
+			change = status;
+		} else if (*change == Status::Created) {
+			// Created and erased within the burst, so it is never reported.
+			if (status == Status::Erased) {
+				change = std::nullopt;
+			}
+		} else if (*change == Status::Modified) {
+			if (status == Status::Erased) {
+				change = Status::Erased;
+			}
+		} else if (status != Status::Erased) {
+			// Erased and created again, such as a file saved by renaming a new file over it.
+			change = Status::Modified;
+		}
+	}
+
+	void Dispatch(Delegate<void(std::filesystem::path, Status)> &onChange) {
+		for (const auto &[path, status] : m_changes) {
+			if (status) {
+				onChange(path, *status);
+			}
+		}
+
+		m_changes.clear();
+		m_indices.clear();
+	}
+
+	bool IsEmpty() const { return m_changes.empty(); }
+
+private:
+	std::vector<std::pair<std::filesystem::path, std::optional<Status>>> m_changes;
+	std::unordered_map<std::string, std::size_t> m_indices;
+};
+
 FileObserver::FileObserver(std::filesystem::path path, const Time &delay) :
 	m_path(std::move(path)),
-	m_delay(delay),
-	m_running(true),
-	m_thread(&FileObserver::QueueLoop, this) {
-	DoWithFilesInPath([this](const std::filesystem::path &file) {
-		m_paths[file.string()] = std::filesystem::last_write_time(file);
-	});
+	m_delay(delay) {
+	Start();
 }
 
 FileObserver::~FileObserver() {
-	if (m_thread.joinable()) {
-		m_running = false;
-		m_thread.join();
-	}
+	Stop();
 }
 
 void FileObserver::DoWithFilesInPath(const std::function<void(std::filesystem::path)> &f) const {
@@ -28,10 +80,75 @@ void FileObserver::DoWithFilesInPath(const std::function<void(std::filesystem::p
 	}
 }
 
+void FileObserver::SetPath(const std::filesystem::path &path) {
+	Stop();
+	m_path = path;
+	Start();
+}
+
+void FileObserver::Start() {
+	m_running = true;
+
+#if defined(ACID_BUILD_LINUX)
+	m_watchesExhausted = false;
+
+	if (StartNotify()) {
+		m_thread = std::thread(&FileObserver::NotifyLoop, this);
+		return;
+	}
+#endif
+
+	// The known paths are found before the thread starts, so the first check only reports changes made since.
+	FindPaths();
+	m_thread = std::thread(&FileObserver::QueueLoop, this);
+}
+
+void FileObserver::Stop() {
+	if (!m_thread.joinable()) {
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(m_runningMutex);
+		m_running = false;
+	}
+
+	m_runningCondition.notify_all();
+
+#if defined(ACID_BUILD_LINUX)
+	if (m_notifying) {
+		uint64_t wake = 1;
+		[[maybe_unused]] auto written = write(m_wake, &wake, sizeof(wake));
+	}
+#endif
+
+	m_thread.join();
+
+#if defined(ACID_BUILD_LINUX)
+	if (m_notifying) {
+		close(m_notify);
+		close(m_wake);
+		m_notify = -1;
+		m_wake = -1;
+		m_watches.clear();
+		m_notifying = false;
+	}
+#endif
+}
+
 void FileObserver::QueueLoop() {
 	while (m_running) {
-		// Wait for "delay" milliseconds
-		std::this_thread::sleep_for(std::chrono::microseconds(m_delay));
+		// Wait for "delay" milliseconds, or until stopped.
+		{
+			std::unique_lock<std::mutex> lock(m_runningMutex);
+			m_runningCondition.wait_for(lock, std::chrono::microseconds(m_delay), [this]() {
+				return !m_running;
+			});
+		}
+
+		if (!m_running) {
+			break;
+		}
 
 		// Check if one of the old files was erased
 		for (auto it = m_paths.begin(); it != m_paths.end();) {
@@ -43,7 +160,7 @@ void FileObserver::QueueLoop() {
 
 			++it;
 		}
-		
+
 		// Check if a file was created or modified
 		DoWithFilesInPath([&](const std::filesystem::path &file) {
 			auto lastWriteTime = std::filesystem::last_write_time(file);
@@ -63,9 +180,208 @@ void FileObserver::QueueLoop() {
 	}
 }
 
+void FileObserver::FindPaths() {
+	m_paths.clear();
+	DoWithFilesInPath([this](const std::filesystem::path &file) {
+		m_paths[file.string()] = std::filesystem::last_write_time(file);
+	});
+}
+
 bool FileObserver::Contains(const std::string &key) const {
 	// TODO C++20: Remove method
 	auto el = m_paths.find(key);
 	return el != m_paths.end();
 }
+
+#if defined(ACID_BUILD_LINUX)
+// Written files are reported once closed, so a file is not reloaded while it is half written.
+constexpr uint32_t NotifyMask = IN_CREATE | IN_CLOSE_WRITE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_ONLYDIR;
+
+bool FileObserver::StartNotify() {
+	// Only directories are watched with notifications, a single file is polled.
+	if (!std::filesystem::is_directory(m_path)) {
+		return false;
+	}
+
+	m_notify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+
+	if (m_notify < 0) {
+		Log::Warning("Could not create inotify instance, polling ", m_path, ": ", std::strerror(errno), '\n');
+		return false;
+	}
+
+	m_wake = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+	AddWatches(m_path, nullptr);
+
+	if (m_wake < 0 || m_watches.empty() || m_watchesExhausted) {
+		if (!m_watchesExhausted) {
+			Log::Warning("Could not watch ", m_path, " with inotify, polling instead\n");
+		}
+
+		if (m_wake >= 0) {
+			close(m_wake);
+		}
+
+		close(m_notify);
+		m_notify = -1;
+		m_wake = -1;
+		m_watches.clear();
+		return false;
+	}
+
+	m_notifying = true;
+	return true;
+}
+
+void FileObserver::NotifyLoop() {
+	pollfd fds[2] = {{m_notify, POLLIN, 0}, {m_wake, POLLIN, 0}};
+	Changes changes;
+	Time firstChange;
+
+	while (m_running) {
+		// Sleeps until a change when there are none waiting, otherwise until the burst has settled.
+		auto timeout = -1;
+
+		if (!changes.IsEmpty()) {
+			timeout = std::max((CoalesceDelay - (Time::Now() - firstChange)).AsMilliseconds<int>(), 0);
+		}
+
+		if (poll(fds, 2, timeout) < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+
+			Log::Error("Could not poll inotify for ", m_path, ": ", std::strerror(errno), '\n');
+			break;
+		}
+
+		if (fds[1].revents & POLLIN) {
+			break;
+		}
+
+		if (fds[0].revents & POLLIN) {
+			if (changes.IsEmpty()) {
+				firstChange = Time::Now();
+			}
+
+			ReadNotify(changes);
+		}
+
+		// A new directory could not be watched, changes inside it would be missed.
+		if (m_watchesExhausted) {
+			changes.Dispatch(m_onChange);
+			break;
+		}
+
+		if (!changes.IsEmpty() && Time::Now() - firstChange >= CoalesceDelay) {
+			changes.Dispatch(m_onChange);
+		}
+	}
+
+	// The inotify instance is closed when stopped, as the stopping thread may be waking it.
+	if (m_running && m_watchesExhausted) {
+		FindPaths();
+		QueueLoop();
+	}
+}
+
+void FileObserver::ReadNotify(Changes &changes) {
+	alignas(inotify_event) char buffer[16384];
+
+	while (true) {
+		auto length = read(m_notify, buffer, sizeof(buffer));
+
+		if (length <= 0) {
+			return;
+		}
+
+		for (auto ptr = buffer; ptr < buffer + length;) {
+			auto event = reinterpret_cast<const inotify_event *>(ptr);
+			ptr += sizeof(inotify_event) + event->len;
+
+			if (event->mask & IN_Q_OVERFLOW) {
+				Log::Warning("Changes in ", m_path, " were missed, the inotify queue overflowed\n");
+				continue;
+			}
+
+			auto watch = m_watches.find(event->wd);
+
+			if (watch == m_watches.end()) {
+				continue;
+			}
+
+			// The watch was removed, by the directory being erased or by RemoveWatches.
+			if (event->mask & IN_IGNORED) {
+				m_watches.erase(watch);
+				continue;
+			}
+
+			auto path = event->len > 0 ? watch->second / event->name : watch->second;
+
+			if (event->mask & (IN_CREATE | IN_MOVED_TO)) {
+				changes.Add(path, Status::Created);
+
+				// Files added to a new directory before it is watched are found when watching it.
+				if (event->mask & IN_ISDIR) {
+					AddWatches(path, &changes);
+				}
+			} else if (event->mask & IN_CLOSE_WRITE) {
+				changes.Add(path, Status::Modified);
+			} else if (event->mask & (IN_DELETE | IN_MOVED_FROM)) {
+				// A erased directory's watch is removed by the system, a moved one is still watched at its new path.
+				if (event->mask & IN_MOVED_FROM && event->mask & IN_ISDIR) {
+					RemoveWatches(path);
+				}
+
+				changes.Add(path, Status::Erased);
+			}
+		}
+	}
+}
+
+void FileObserver::AddWatches(const std::filesystem::path &directory, Changes *changes) {
+	if (m_watchesExhausted) {
+		return;
+	}
+
+	auto wd = inotify_add_watch(m_notify, directory.c_str(), NotifyMask);
+
+	if (wd < 0) {
+		// Out of watches or memory, every directory after this one would fail too.
+		if (errno == ENOSPC || errno == ENOMEM) {
+			Log::Warning("Ran out of inotify watches at ", directory, ", polling ", m_path, " instead: ", std::strerror(errno), '\n');
+			m_watchesExhausted = true;
+			return;
+		}
+
+		Log::Warning("Could not watch ", directory, ": ", std::strerror(errno), '\n');
+		return;
+	}
+
+	m_watches[wd] = directory;
+
+	std::error_code ec;
+
+	for (const auto &entry : std::filesystem::directory_iterator(directory, ec)) {
+		if (changes) {
+			changes->Add(entry.path(), Status::Created);
+		}
+
+		if (entry.is_directory(ec) && !entry.is_symlink(ec)) {
+			AddWatches(entry.path(), changes);
+		}
+	}
+}
+
+void FileObserver::RemoveWatches(const std::filesystem::path &directory) {
+	auto prefix = directory.string() + std::filesystem::path::preferred_separator;
+
+	for (const auto &[wd, path] : m_watches) {
+		if (path == directory || path.string().compare(0, prefix.size(), prefix) == 0) {
+			// Erased from the watches when the matching IN_IGNORED event is read.
+			inotify_rm_watch(m_notify, wd);
+		}
+	}
+}
+#endif
 }
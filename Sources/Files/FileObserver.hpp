@@ -1,5 +1,6 @@
 #pragma once
 
+#include <condition_variable>
 #include <thread>
 
 #include "Maths/Time.hpp"
@@ -8,15 +9,21 @@
 namespace acid {
 /**
  * @brief Class that can listen to file changes on a path recursively.
+ * On Linux the path is watched with inotify, the thread sleeps until a change and bursts of changes are reported together once settled.
+ * If the path cannot be watched, or on other platforms, the path is polled instead. Watching falls back to polling if the system runs out of
+ * watches, even after it has started, so directories that could not be watched are not missed.
  */
 class ACID_EXPORT FileObserver {
 public:
 	enum class Status { Created, Modified, Erased };
 
+	/// How long changes are gathered for after the first change of a burst, before they are reported.
+	static constexpr Time CoalesceDelay = 50ms;
+
 	/**
 	 * Creates a new file watcher.
 	 * @param path The path to watch recursively.
-	 * @param delay How frequently to check for changes.
+	 * @param delay How frequently to check for changes when polling.
 	 */
 	explicit FileObserver(std::filesystem::path path, const Time &delay = 5s);
 
@@ -24,29 +31,61 @@ public:
 
 	void DoWithFilesInPath(const std::function<void(std::filesystem::path)> &f) const;
 
+	/**
+	 * Gets if changes are found by being notified by the system rather than by polling the path.
+	 * @return If the path is watched by notifications.
+	 */
+	bool IsNotifying() const { return m_notifying && !m_watchesExhausted; }
+
 	const std::filesystem::path &GetPath() const { return m_path; }
-	void SetPath(const std::filesystem::path &path) { m_path = path; }
+	void SetPath(const std::filesystem::path &path);
 
 	const Time &GetDelay() const { return m_delay; }
 	void SetDelay(const Time &delay) { m_delay = delay; }
 
 	/**
-	 * Called when a file or directory has changed.
+	 * Called from the watching thread when a file or directory has changed.
 	 * @return The delegate.
 	 */
 	Delegate<void(std::filesystem::path, Status)> &OnChange() { return m_onChange; }
 
 private:
+	class Changes;
+
+	void Start();
+	void Stop();
+
 	void QueueLoop();
+	void FindPaths();
 
 	bool Contains(const std::string &key) const;
 
+#if defined(ACID_BUILD_LINUX)
+	bool StartNotify();
+	void NotifyLoop();
+	void ReadNotify(Changes &changes);
+	void AddWatches(const std::filesystem::path &directory, Changes *changes);
+	void RemoveWatches(const std::filesystem::path &directory);
+#endif
+
 	std::filesystem::path m_path;
 	Time m_delay;
 	Delegate<void(std::filesystem::path, Status)> m_onChange;
 
-	bool m_running;
+	std::atomic<bool> m_running = false;
+	std::mutex m_runningMutex;
+	std::condition_variable m_runningCondition;
 	std::thread m_thread;
 	std::unordered_map<std::string, std::filesystem::file_time_type> m_paths;
+
+	bool m_notifying = false;
+	// Set when the system has no watches or memory left for a directory, the path is then polled instead.
+	std::atomic<bool> m_watchesExhausted = false;
+#if defined(ACID_BUILD_LINUX)
+	int m_notify = -1;
+	// Written to wake the watching thread when stopping.
+	int m_wake = -1;
+	std::unordered_map<int, std::filesystem::path> m_watches;
+#endif
 };
 }
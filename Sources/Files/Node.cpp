@@ -1,5 +1,7 @@
 #include "Node.hpp"
 
+#include "Maths/Maths.hpp"
+
 namespace acid {
 static const Node NullNode = Node("null", Node::Type::Null);
 
@@ -165,4 +167,15 @@ bool Node::operator<(const Node &other) const {
 	
 	return false;
 }
+
+std::size_t Node::GetHash() const {
+	// Names and types are left out, as they are not compared by operator==.
+	auto seed = std::hash<std::string>()(m_value);
+
+	for (const auto &property : m_properties) {
+		Maths::HashCombine(seed, property);
+	}
+
+	return seed;
+}
 }
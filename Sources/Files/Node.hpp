@@ -93,6 +93,12 @@ public:
 	bool operator!=(const Node &other) const;
 	bool operator<(const Node &other) const;
 
+	/**
+	 * Gets a hash of the value and properties of this node and its children, equal nodes have equal hashes.
+	 * @return The hash.
+	 **/
+	std::size_t GetHash() const;
+
 	const std::vector<Node> &GetProperties() const { return m_properties; }
 	std::vector<Node> &GetProperties() { return m_properties; }
 
@@ -126,3 +132,12 @@ protected:
 
 #include "Node.inl"
 #include "NodeReturn.inl"
+
+namespace std {
+template<>
+struct hash<acid::Node> {
+	size_t operator()(const acid::Node &node) const {
+		return node.GetHash();
+	}
+};
+}
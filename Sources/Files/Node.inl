@@ -142,8 +142,8 @@ const Node &operator>>(const Node &node, std::unique_ptr<T> &object) {
 	return node;
 }
 
-template<typename T>
-Node &operator<<(Node &node, const std::unique_ptr<T> &object) {
+template<typename T, typename D>
+Node &operator<<(Node &node, const std::unique_ptr<T, D> &object) {
 	if (object == nullptr) {
 		return node << nullptr;
 	}
@@ -5,12 +5,16 @@
 
 namespace acid {
 std::shared_ptr<FontType> FontType::Create(const Node &node) {
-	if (auto resource = Resources::Get()->Find(node)) {
-		return std::dynamic_pointer_cast<FontType>(resource);
+	if (auto resource = Resources::Get()->Find<FontType>(node)) {
+		return resource;
 	}
 
 	auto result = std::make_shared<FontType>("", "");
-	Resources::Get()->Add(node, std::dynamic_pointer_cast<Resource>(result));
+
+	if (auto resource = Resources::Get()->FindOrAdd(node, result); resource != result) {
+		return resource;
+	}
+
 	node >> *result;
 	result->Load();
 	return result;
@@ -44,6 +48,8 @@ Node &operator<<(Node &node, const FontType &fontType) {
 }
 
 void FontType::Load() {
+	ACID_PROFILE_SCOPE("FontType::Load");
+
 	if (m_filename.empty() || m_style.empty()) {
 		return;
 	}
@@ -5,6 +5,11 @@
 namespace acid {
 Buffer::Buffer(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties, const void *data) :
 	m_size(size) {
+	// Headless engines have no device, the buffer stays empty and is never bound.
+	if (!Graphics::Get()) {
+		return;
+	}
+
 	auto logicalDevice = Graphics::Get()->GetLogicalDevice();
 
 	auto graphicsFamily = logicalDevice->GetGraphicsFamily();
@@ -57,6 +62,10 @@ Buffer::Buffer(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlag
 }
 
 Buffer::~Buffer() {
+	if (!Graphics::Get()) {
+		return;
+	}
+
 	auto logicalDevice = Graphics::Get()->GetLogicalDevice();
 
 	vkDestroyBuffer(*logicalDevice, m_buffer, nullptr);
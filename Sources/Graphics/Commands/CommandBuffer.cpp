@@ -65,7 +65,10 @@ void CommandBuffer::SubmitIdle() {
 
 	Graphics::CheckVk(vkResetFences(*logicalDevice, 1, &fence));
 
-	Graphics::CheckVk(vkQueueSubmit(queueSelected, 1, &submitInfo, fence));
+	{
+		std::lock_guard<std::mutex> lock(logicalDevice->GetQueueMutex());
+		Graphics::CheckVk(vkQueueSubmit(queueSelected, 1, &submitInfo, fence));
+	}
 
 	Graphics::CheckVk(vkWaitForFences(*logicalDevice, 1, &fence, VK_TRUE, std::numeric_limits<uint64_t>::max()));
 
@@ -101,6 +104,7 @@ void CommandBuffer::Submit(const VkSemaphore &waitSemaphore, const VkSemaphore &
 	if (fence != VK_NULL_HANDLE)
 		Graphics::CheckVk(vkResetFences(*logicalDevice, 1, &fence));
 
+	std::lock_guard<std::mutex> lock(logicalDevice->GetQueueMutex());
 	Graphics::CheckVk(vkQueueSubmit(queueSelected, 1, &submitInfo, fence));
 }
 
@@ -56,5 +56,14 @@ public:
 	virtual ~Descriptor() = default;
 
 	virtual WriteDescriptorSet GetWriteDescriptor(uint32_t binding, VkDescriptorType descriptorType, const std::optional<OffsetSize> &offsetSize) const = 0;
+
+	/**
+	 * Gets a count of the times this descriptor was recreated in place, such as a image reloaded from a changed file. Sets that write it are rewritten when it changes.
+	 * @return The descriptor revision.
+	 */
+	uint32_t GetRevision() const { return m_revision; }
+
+protected:
+	uint32_t m_revision = 0;
 };
 }
@@ -0,0 +1,23 @@
+#include "DescriptorPool.hpp"
+
+#include "Graphics/Graphics.hpp"
+
+namespace acid {
+DescriptorPool::DescriptorPool(const std::vector<VkDescriptorPoolSize> &poolSizes) {
+	auto logicalDevice = Graphics::Get()->GetLogicalDevice();
+
+	VkDescriptorPoolCreateInfo descriptorPoolCreateInfo = {};
+	descriptorPoolCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+	descriptorPoolCreateInfo.flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT;
+	descriptorPoolCreateInfo.maxSets = 8192; // 16384;
+	descriptorPoolCreateInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
+	descriptorPoolCreateInfo.pPoolSizes = poolSizes.data();
+	Graphics::CheckVk(vkCreateDescriptorPool(*logicalDevice, &descriptorPoolCreateInfo, nullptr, &m_descriptorPool));
+}
+
+DescriptorPool::~DescriptorPool() {
+	auto logicalDevice = Graphics::Get()->GetLogicalDevice();
+
+	vkDestroyDescriptorPool(*logicalDevice, m_descriptorPool, nullptr);
+}
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include "StdAfx.hpp"
+
+namespace acid {
+/**
+ * @brief Class that represents a descriptor pool, shared by a pipeline and every descriptor set allocated from it so the pool outlives all of them.
+ */
+class ACID_EXPORT DescriptorPool {
+public:
+	explicit DescriptorPool(const std::vector<VkDescriptorPoolSize> &poolSizes);
+
+	~DescriptorPool();
+
+	operator const VkDescriptorPool &() const { return m_descriptorPool; }
+
+	const VkDescriptorPool &GetDescriptorPool() const { return m_descriptorPool; }
+
+private:
+	VkDescriptorPool m_descriptorPool = VK_NULL_HANDLE;
+};
+}
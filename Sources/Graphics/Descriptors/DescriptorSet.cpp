@@ -13,7 +13,7 @@ DescriptorSet::DescriptorSet(const Pipeline &pipeline) :
 
 	VkDescriptorSetAllocateInfo descriptorSetAllocateInfo = {};
 	descriptorSetAllocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-	descriptorSetAllocateInfo.descriptorPool = m_descriptorPool;
+	descriptorSetAllocateInfo.descriptorPool = *m_descriptorPool;
 	descriptorSetAllocateInfo.descriptorSetCount = 1;
 	descriptorSetAllocateInfo.pSetLayouts = layouts;
 	Graphics::CheckVk(vkAllocateDescriptorSets(*logicalDevice, &descriptorSetAllocateInfo, &m_descriptorSet));
@@ -22,7 +22,7 @@ DescriptorSet::DescriptorSet(const Pipeline &pipeline) :
 DescriptorSet::~DescriptorSet() {
 	auto logicalDevice = Graphics::Get()->GetLogicalDevice();
 
-	Graphics::CheckVk(vkFreeDescriptorSets(*logicalDevice, m_descriptorPool, 1, &m_descriptorSet));
+	Graphics::CheckVk(vkFreeDescriptorSets(*logicalDevice, *m_descriptorPool, 1, &m_descriptorSet));
 }
 
 void DescriptorSet::Update(const std::vector<VkWriteDescriptorSet> &descriptorWrites) {
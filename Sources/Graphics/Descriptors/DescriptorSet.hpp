@@ -21,7 +21,8 @@ public:
 private:
 	VkPipelineLayout m_pipelineLayout;
 	VkPipelineBindPoint m_pipelineBindPoint;
-	VkDescriptorPool m_descriptorPool;
+	// Shared with the pipeline, so the set can be freed into its pool after the pipeline is destroyed.
+	std::shared_ptr<DescriptorPool> m_descriptorPool;
 	VkDescriptorSet m_descriptorSet = VK_NULL_HANDLE;
 };
 }
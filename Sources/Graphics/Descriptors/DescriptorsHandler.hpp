@@ -27,8 +27,9 @@ public:
 		auto it = m_descriptors.find(descriptorName);
 
 		if (it != m_descriptors.end()) {
-			// If the descriptor and size have not changed then the write is not modified.
-			if (it->second.m_descriptor == ConstExpr::AsPtr(descriptor) && it->second.m_offsetSize == offsetSize) {
+			// If the descriptor, its revision, and size have not changed then the write is not modified.
+			if (it->second.m_descriptor == ConstExpr::AsPtr(descriptor) && it->second.m_revision == ConstExpr::AsPtr(descriptor)->GetRevision() &&
+				it->second.m_offsetSize == offsetSize) {
 				return;
 			}
 
@@ -66,7 +67,7 @@ public:
 
 		// Adds the new descriptor value.
 		auto writeDescriptor = ConstExpr::AsPtr(descriptor)->GetWriteDescriptor(*location, *descriptorType, offsetSize);
-		m_descriptors.emplace(descriptorName, DescriptorValue{ConstExpr::AsPtr(descriptor), std::move(writeDescriptor), offsetSize, *location});
+		m_descriptors.emplace(descriptorName, DescriptorValue{ConstExpr::AsPtr(descriptor), ConstExpr::AsPtr(descriptor)->GetRevision(), std::move(writeDescriptor), offsetSize, *location});
 		m_changed = true;
 	}
 
@@ -85,7 +86,7 @@ public:
 		auto location = m_shader->GetDescriptorLocation(descriptorName);
 		//auto descriptorType = m_shader->GetDescriptorType(*location);
 
-		m_descriptors.emplace(descriptorName, DescriptorValue{ConstExpr::AsPtr(descriptor), std::move(writeDescriptorSet), std::nullopt, *location});
+		m_descriptors.emplace(descriptorName, DescriptorValue{ConstExpr::AsPtr(descriptor), ConstExpr::AsPtr(descriptor)->GetRevision(), std::move(writeDescriptorSet), std::nullopt, *location});
 		m_changed = true;
 	}
 
@@ -102,6 +103,7 @@ public:
 private:
 	struct DescriptorValue {
 		const Descriptor *m_descriptor;
+		uint32_t m_revision;
 		WriteDescriptorSet m_writeDescriptor;
 		std::optional<OffsetSize> m_offsetSize;
 		uint32_t m_location;
@@ -19,8 +19,12 @@ Graphics::Graphics() :
 Graphics::~Graphics() {
 	auto graphicsQueue = m_logicalDevice->GetGraphicsQueue();
 
-	CheckVk(vkQueueWaitIdle(graphicsQueue));
+	{
+		std::lock_guard<std::mutex> lock(m_logicalDevice->GetQueueMutex());
+		CheckVk(vkQueueWaitIdle(graphicsQueue));
+	}
 
+	FreeDeferred(true);
 	glslang::FinalizeProcess();
 
 	vkDestroyPipelineCache(*m_logicalDevice, m_pipelineCache, nullptr);
@@ -57,6 +61,9 @@ void Graphics::Update() {
 		return;
 	}
 
+	// The fence waited on by the acquire signals that the frame this image was last used in has finished.
+	FreeDeferred(false);
+
 	Pipeline::Stage stage;
 
 	for (auto &renderStage : m_renderer->m_renderStages) {
@@ -85,6 +92,8 @@ void Graphics::Update() {
 
 	// Purges unused command pools.
 	if (m_elapsedPurge.GetElapsed() != 0) {
+		std::lock_guard<std::mutex> lock(m_commandPoolsMutex);
+
 		for (auto it = m_commandPools.begin(); it != m_commandPools.end();) {
 			if ((*it).second.use_count() <= 1) {
 				it = m_commandPools.erase(it);
@@ -161,6 +170,20 @@ void Graphics::CheckVk(const VkResult &result) {
 	throw std::runtime_error("Vulkan error: " + failure);
 }
 
+void Graphics::WaitIdle() const {
+	std::lock_guard<std::mutex> lock(m_logicalDevice->GetQueueMutex());
+	CheckVk(vkDeviceWaitIdle(*m_logicalDevice));
+}
+
+void Graphics::DestroyDeferred(std::shared_ptr<void> object) {
+	if (!object) {
+		return;
+	}
+
+	std::lock_guard<std::mutex> lock(m_deferredDestroysMutex);
+	m_deferredDestroys.emplace_back(m_frameNumber, std::move(object));
+}
+
 void Graphics::CaptureScreenshot(const std::filesystem::path &filename) const {
 #if defined(ACID_DEBUG)
 	auto debugStart = Time::Now();
@@ -217,7 +240,8 @@ const Descriptor *Graphics::GetAttachment(const std::string &name) const {
 	return it->second;
 }
 
-const std::shared_ptr<CommandPool> &Graphics::GetCommandPool(const std::thread::id &threadId) {
+std::shared_ptr<CommandPool> Graphics::GetCommandPool(const std::thread::id &threadId) {
+	std::lock_guard<std::mutex> lock(m_commandPoolsMutex);
 	auto it = m_commandPools.find(threadId);
 
 	if (it != m_commandPools.end()) {
@@ -249,7 +273,10 @@ void Graphics::ResetRenderStages() {
 }
 
 void Graphics::RecreateSwapchain() {
-	vkDeviceWaitIdle(*m_logicalDevice);
+	{
+		std::lock_guard<std::mutex> lock(m_logicalDevice->GetQueueMutex());
+		vkDeviceWaitIdle(*m_logicalDevice);
+	}
 
 	VkExtent2D displayExtent = {Window::Get()->GetSize().m_x, Window::Get()->GetSize().m_y};
 #if defined(ACID_DEBUG)
@@ -295,7 +322,10 @@ void Graphics::RecreatePass(RenderStage &renderStage) {
 
 	VkExtent2D displayExtent = {Window::Get()->GetSize().m_x, Window::Get()->GetSize().m_y};
 
-	CheckVk(vkQueueWaitIdle(graphicsQueue));
+	{
+		std::lock_guard<std::mutex> lock(m_logicalDevice->GetQueueMutex());
+		CheckVk(vkQueueWaitIdle(graphicsQueue));
+	}
 
 	if (renderStage.HasSwapchain() && (m_framebufferResized || !m_swapchain->IsSameExtent(displayExtent))) {
 		RecreateSwapchain();
@@ -368,7 +398,12 @@ void Graphics::EndRenderpass(RenderStage &renderStage) {
 	commandBuffer->End();
 	commandBuffer->Submit(m_presentCompletes[m_currentFrame], m_renderCompletes[m_currentFrame], m_flightFences[m_currentFrame]);
 
-	auto presentResult = m_swapchain->QueuePresent(presentQueue, m_renderCompletes[m_currentFrame]);
+	VkResult presentResult;
+	{
+		std::lock_guard<std::mutex> lock(m_logicalDevice->GetQueueMutex());
+		presentResult = m_swapchain->QueuePresent(presentQueue, m_renderCompletes[m_currentFrame]);
+	}
+
 	if (presentResult == VK_ERROR_OUT_OF_DATE_KHR || presentResult == VK_SUBOPTIMAL_KHR) { // || m_framebufferResized
 		m_framebufferResized = true; // false
 		//RecreateSwapchain();
@@ -378,5 +413,25 @@ void Graphics::EndRenderpass(RenderStage &renderStage) {
 	}
 
 	m_currentFrame = (m_currentFrame + 1) % m_swapchain->GetImageCount();
+	m_frameNumber++;
+}
+
+void Graphics::FreeDeferred(bool all) {
+	// Moved out and destroyed after unlocking, so destructors can defer more objects.
+	std::vector<std::shared_ptr<void>> freed;
+
+	{
+		std::lock_guard<std::mutex> lock(m_deferredDestroysMutex);
+		// A frame has finished once the frame a fence count later has waited on its fence.
+		auto it = std::stable_partition(m_deferredDestroys.begin(), m_deferredDestroys.end(), [&](const auto &deferred) {
+			return !all && m_frameNumber < deferred.first + m_flightFences.size();
+		});
+
+		for (auto free = it; free != m_deferredDestroys.end(); ++free) {
+			freed.emplace_back(std::move(free->second));
+		}
+
+		m_deferredDestroys.erase(it, m_deferredDestroys.end());
+	}
 }
 }
@@ -31,7 +31,24 @@ public:
 	 */
 	void CaptureScreenshot(const std::filesystem::path &filename) const;
 
-	const std::shared_ptr<CommandPool> &GetCommandPool(const std::thread::id &threadId = std::this_thread::get_id());
+	/**
+	 * Waits until the device has finished all submitted work, used before destroying objects that a frame in flight may still use.
+	 */
+	void WaitIdle() const;
+
+	/**
+	 * Keeps a object alive until every frame in flight that may be using it has finished on the device, then destroys it.
+	 * Used to replace pipelines and other device objects without waiting for the device to be idle.
+	 * @param object The object to destroy.
+	 */
+	void DestroyDeferred(std::shared_ptr<void> object);
+
+	/**
+	 * Gets the command pool of a thread, created the first time it is used. Resources loading on workers each record into their own pool.
+	 * @param threadId The thread.
+	 * @return The command pool.
+	 */
+	std::shared_ptr<CommandPool> GetCommandPool(const std::thread::id &threadId = std::this_thread::get_id());
 
 	/**
 	 * Gets the current renderer.
@@ -64,12 +81,14 @@ private:
 	void RecreateAttachmentsMap();
 	bool StartRenderpass(RenderStage &renderStage);
 	void EndRenderpass(RenderStage &renderStage);
+	void FreeDeferred(bool all);
 
 	std::unique_ptr<Renderer> m_renderer;
 	std::map<std::string, const Descriptor *> m_attachments;
 	std::unique_ptr<Swapchain> m_swapchain;
 
 	std::map<std::thread::id, std::shared_ptr<CommandPool>> m_commandPools;
+	std::mutex m_commandPoolsMutex;
 	ElapsedTime m_elapsedPurge;
 
 	VkPipelineCache m_pipelineCache = VK_NULL_HANDLE;
@@ -77,8 +96,13 @@ private:
 	std::vector<VkSemaphore> m_renderCompletes;
 	std::vector<VkFence> m_flightFences;
 	std::size_t m_currentFrame = 0;
+	uint64_t m_frameNumber = 0;
 	bool m_framebufferResized = false;
 
+	// Objects waiting for the frames that used them to finish, with the frame number they were destroyed in.
+	std::vector<std::pair<uint64_t, std::shared_ptr<void>>> m_deferredDestroys;
+	std::mutex m_deferredDestroysMutex;
+
 	std::vector<std::unique_ptr<CommandBuffer>> m_commandBuffers;
 
 	std::unique_ptr<Instance> m_instance;
@@ -21,6 +21,10 @@ Image::Image(const VkExtent3D &extent, VkImageType imageType, VkFormat format, V
 }
 
 Image::~Image() {
+	if (!Graphics::Get()) {
+		return;
+	}
+
 	auto logicalDevice = Graphics::Get()->GetLogicalDevice();
 
 	vkDestroyImageView(*logicalDevice, m_view, nullptr);
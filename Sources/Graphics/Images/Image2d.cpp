@@ -9,12 +9,16 @@
 
 namespace acid {
 std::shared_ptr<Image2d> Image2d::Create(const Node &node) {
-	if (auto resource = Resources::Get()->Find(node)) {
-		return std::dynamic_pointer_cast<Image2d>(resource);
+	if (auto resource = Resources::Get()->Find<Image2d>(node)) {
+		return resource;
 	}
 
 	auto result = std::make_shared<Image2d>("");
-	Resources::Get()->Add(node, std::dynamic_pointer_cast<Resource>(result));
+
+	if (auto resource = Resources::Get()->FindOrAdd(node, result); resource != result) {
+		return resource;
+	}
+
 	node >> *result;
 	result->Load();
 	return result;
@@ -27,6 +31,25 @@ std::shared_ptr<Image2d> Image2d::Create(const std::filesystem::path &filename,
 	return Create(node);
 }
 
+std::shared_ptr<Image2d> Image2d::CreatePlaceholder() {
+	auto bitmap = std::make_unique<Bitmap>(Vector2ui(8, 8));
+	auto pixels = bitmap->GetData().get();
+
+	for (uint32_t y = 0; y < 8; y++) {
+		for (uint32_t x = 0; x < 8; x++) {
+			auto pixel = pixels + (y * 8 + x) * 4;
+			auto magenta = (x + y) % 2 == 0;
+			pixel[0] = magenta ? 255 : 0;
+			pixel[1] = 0;
+			pixel[2] = magenta ? 255 : 0;
+			pixel[3] = 255;
+		}
+	}
+
+	return std::make_shared<Image2d>(std::move(bitmap), VK_FORMAT_R8G8B8A8_UNORM, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_IMAGE_USAGE_SAMPLED_BIT,
+		VK_FILTER_NEAREST, VK_SAMPLER_ADDRESS_MODE_REPEAT);
+}
+
 Image2d::Image2d(std::filesystem::path filename, VkFilter filter, VkSamplerAddressMode addressMode, bool anisotropic, bool mipmap, bool load) :
 	m_filename(std::move(filename)),
 	m_filter(filter),
@@ -73,12 +96,42 @@ Image2d::Image2d(std::unique_ptr<Bitmap> &&bitmap, VkFormat format, VkImageLayou
 }
 
 Image2d::~Image2d() {
+	if (!Graphics::Get()) {
+		return;
+	}
+
+	auto logicalDevice = Graphics::Get()->GetLogicalDevice();
+
+	vkDestroySampler(*logicalDevice, m_sampler, nullptr);
+	vkDestroyImageView(*logicalDevice, m_view, nullptr);
+	vkFreeMemory(*logicalDevice, m_memory, nullptr);
+	vkDestroyImage(*logicalDevice, m_image, nullptr);
+}
+
+void Image2d::Reload() {
+	if (m_filename.empty() || !Graphics::Get()) {
+		return;
+	}
+
+	// Decoded before the old image is destroyed, so a file that fails to load leaves the image as it was.
+	auto bitmap = std::make_unique<Bitmap>(m_filename);
+
+	if (!bitmap->GetData()) {
+		throw std::runtime_error("Could not decode image " + m_filename.string());
+	}
+
+	Graphics::Get()->WaitIdle();
 	auto logicalDevice = Graphics::Get()->GetLogicalDevice();
 
 	vkDestroySampler(*logicalDevice, m_sampler, nullptr);
 	vkDestroyImageView(*logicalDevice, m_view, nullptr);
 	vkFreeMemory(*logicalDevice, m_memory, nullptr);
 	vkDestroyImage(*logicalDevice, m_image, nullptr);
+
+	m_extent = bitmap->GetSize();
+	m_components = bitmap->GetBytesPerPixel();
+	Load(std::move(bitmap));
+	m_revision++;
 }
 
 WriteDescriptorSet Image2d::GetWriteDescriptor(uint32_t binding, VkDescriptorType descriptorType, const std::optional<OffsetSize> &offsetSize) const {
@@ -169,7 +222,18 @@ Node &operator<<(Node &node, const Image2d &image) {
 }
 
 void Image2d::Load(std::unique_ptr<Bitmap> loadBitmap) {
+	ACID_PROFILE_SCOPE("Image2d::Load");
+
+	// Headless engines have no device, images are never decoded or uploaded.
+	if (!Graphics::Get()) {
+		return;
+	}
+
 	if (!m_filename.empty() && !loadBitmap) {
+		if (auto resources = Resources::Get()) {
+			resources->AddDependency(*this, m_filename);
+		}
+
 		loadBitmap = std::make_unique<Bitmap>(m_filename);
 		m_extent = loadBitmap->GetSize();
 		m_components = loadBitmap->GetBytesPerPixel();
@@ -183,6 +247,9 @@ void Image2d::Load(std::unique_ptr<Bitmap> loadBitmap) {
 
 	Image::CreateImage(m_image, m_memory, {m_extent.m_x, m_extent.m_y, 1}, m_format, m_samples, VK_IMAGE_TILING_OPTIMAL, m_usage, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
 		m_mipLevels, 1, VK_IMAGE_TYPE_2D);
+	VkMemoryRequirements memoryRequirements;
+	vkGetImageMemoryRequirements(*Graphics::Get()->GetLogicalDevice(), m_image, &memoryRequirements);
+	m_gpuSize = static_cast<std::size_t>(memoryRequirements.size);
 	Image::CreateImageSampler(m_sampler, m_filter, m_addressMode, m_anisotropic, m_mipLevels);
 	Image::CreateImageView(m_image, m_view, VK_IMAGE_VIEW_TYPE_2D, m_format, VK_IMAGE_ASPECT_COLOR_BIT, m_mipLevels, 0, 1, 0);
 
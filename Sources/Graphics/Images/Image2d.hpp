@@ -30,6 +30,12 @@ public:
 	static std::shared_ptr<Image2d> Create(const std::filesystem::path &filename, VkFilter filter = VK_FILTER_LINEAR,
 		VkSamplerAddressMode addressMode = VK_SAMPLER_ADDRESS_MODE_REPEAT, bool anisotropic = true, bool mipmap = true);
 
+	/**
+	 * Creates the image used while a image is loading, a magenta and black checker.
+	 * @return The placeholder image.
+	 */
+	static std::shared_ptr<Image2d> CreatePlaceholder();
+
 	/**
 	 * Creates a new 2D image.
 	 * @param filename The file to load the image from.
@@ -78,6 +84,11 @@ public:
 
 	~Image2d();
 
+	/**
+	 * Reloads this image from its file, replacing the image on the device. Descriptor sets using it are rewritten when next pushed.
+	 */
+	void Reload() override;
+
 	WriteDescriptorSet GetWriteDescriptor(uint32_t binding, VkDescriptorType descriptorType, const std::optional<OffsetSize> &offsetSize) const override;
 	static VkDescriptorSetLayoutBinding GetDescriptorSetLayout(uint32_t binding, VkDescriptorType descriptorType, VkShaderStageFlags stage, uint32_t count);
 
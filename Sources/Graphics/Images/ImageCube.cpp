@@ -8,12 +8,16 @@
 
 namespace acid {
 std::shared_ptr<ImageCube> ImageCube::Create(const Node &node) {
-	if (auto resource = Resources::Get()->Find(node)) {
-		return std::dynamic_pointer_cast<ImageCube>(resource);
+	if (auto resource = Resources::Get()->Find<ImageCube>(node)) {
+		return resource;
 	}
 
 	auto result = std::make_shared<ImageCube>("");
-	Resources::Get()->Add(node, std::dynamic_pointer_cast<Resource>(result));
+
+	if (auto resource = Resources::Get()->FindOrAdd(node, result); resource != result) {
+		return resource;
+	}
+
 	node >> *result;
 	result->Load();
 	return result;
@@ -74,6 +78,10 @@ ImageCube::ImageCube(std::unique_ptr<Bitmap> &&bitmap, VkFormat format, VkImageL
 }
 
 ImageCube::~ImageCube() {
+	if (!Graphics::Get()) {
+		return;
+	}
+
 	auto logicalDevice = Graphics::Get()->GetLogicalDevice();
 
 	vkDestroyImageView(*logicalDevice, m_view, nullptr);
@@ -189,6 +197,13 @@ Node &operator<<(Node &node, const ImageCube &image) {
 }
 
 void ImageCube::Load(std::unique_ptr<Bitmap> loadBitmap) {
+	ACID_PROFILE_SCOPE("ImageCube::Load");
+
+	// Headless engines have no device, images are never decoded or uploaded.
+	if (!Graphics::Get()) {
+		return;
+	}
+
 	if (!m_filename.empty() && !loadBitmap) {
 		uint8_t *offset = nullptr;
 
@@ -2,6 +2,7 @@
 
 #include <vulkan/vulkan.h>
 #include "Graphics/Commands/CommandBuffer.hpp"
+#include "Graphics/Descriptors/DescriptorPool.hpp"
 #include "Shader.hpp"
 
 namespace acid {
@@ -26,7 +27,7 @@ public:
 	virtual const Shader *GetShader() const = 0;
 	virtual bool IsPushDescriptors() const = 0;
 	virtual const VkDescriptorSetLayout &GetDescriptorSetLayout() const = 0;
-	virtual const VkDescriptorPool &GetDescriptorPool() const = 0;
+	virtual const std::shared_ptr<DescriptorPool> &GetDescriptorPool() const = 0;
 	virtual const VkPipeline &GetPipeline() const = 0;
 	virtual const VkPipelineLayout &GetPipelineLayout() const = 0;
 	virtual const VkPipelineBindPoint &GetPipelineBindPoint() const = 0;
@@ -16,7 +16,7 @@ PipelineCompute::PipelineCompute(std::filesystem::path shaderStage, std::vector<
 
 	CreateShaderProgram();
 	CreateDescriptorLayout();
-	CreateDescriptorPool();
+	m_descriptorPool = std::make_shared<DescriptorPool>(m_shader->GetDescriptorPools());
 	CreatePipelineLayout();
 	CreatePipelineCompute();
 
@@ -31,7 +31,6 @@ PipelineCompute::~PipelineCompute() {
 	vkDestroyShaderModule(*logicalDevice, m_shaderModule, nullptr);
 
 	vkDestroyDescriptorSetLayout(*logicalDevice, m_descriptorSetLayout, nullptr);
-	vkDestroyDescriptorPool(*logicalDevice, m_descriptorPool, nullptr);
 	vkDestroyPipeline(*logicalDevice, m_pipeline, nullptr);
 	vkDestroyPipelineLayout(*logicalDevice, m_pipelineLayout, nullptr);
 }
@@ -79,20 +78,6 @@ void PipelineCompute::CreateDescriptorLayout() {
 	Graphics::CheckVk(vkCreateDescriptorSetLayout(*logicalDevice, &descriptorSetLayoutCreateInfo, nullptr, &m_descriptorSetLayout));
 }
 
-void PipelineCompute::CreateDescriptorPool() {
-	auto logicalDevice = Graphics::Get()->GetLogicalDevice();
-
-	auto descriptorPools = m_shader->GetDescriptorPools();
-
-	VkDescriptorPoolCreateInfo descriptorPoolCreateInfo = {};
-	descriptorPoolCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
-	descriptorPoolCreateInfo.flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT;
-	descriptorPoolCreateInfo.maxSets = 8192; // 16384;
-	descriptorPoolCreateInfo.poolSizeCount = static_cast<uint32_t>(descriptorPools.size());
-	descriptorPoolCreateInfo.pPoolSizes = descriptorPools.data();
-	Graphics::CheckVk(vkCreateDescriptorPool(*logicalDevice, &descriptorPoolCreateInfo, nullptr, &m_descriptorPool));
-}
-
 void PipelineCompute::CreatePipelineLayout() {
 	auto logicalDevice = Graphics::Get()->GetLogicalDevice();
 
@@ -29,7 +29,7 @@ PipelineGraphics::PipelineGraphics(Stage stage, std::vector<std::filesystem::pat
 	std::sort(m_vertexInputs.begin(), m_vertexInputs.end());
 	CreateShaderProgram();
 	CreateDescriptorLayout();
-	CreateDescriptorPool();
+	m_descriptorPool = std::make_shared<DescriptorPool>(m_shader->GetDescriptorPools());
 	CreatePipelineLayout();
 	CreateAttributes();
 
@@ -56,7 +56,6 @@ PipelineGraphics::~PipelineGraphics() {
 		vkDestroyShaderModule(*logicalDevice, shaderModule, nullptr);
 	}
 
-	vkDestroyDescriptorPool(*logicalDevice, m_descriptorPool, nullptr);
 	vkDestroyPipeline(*logicalDevice, m_pipeline, nullptr);
 	vkDestroyPipelineLayout(*logicalDevice, m_pipelineLayout, nullptr);
 	vkDestroyDescriptorSetLayout(*logicalDevice, m_descriptorSetLayout, nullptr);
@@ -116,20 +115,6 @@ void PipelineGraphics::CreateDescriptorLayout() {
 	Graphics::CheckVk(vkCreateDescriptorSetLayout(*logicalDevice, &descriptorSetLayoutCreateInfo, nullptr, &m_descriptorSetLayout));
 }
 
-void PipelineGraphics::CreateDescriptorPool() {
-	auto logicalDevice = Graphics::Get()->GetLogicalDevice();
-
-	auto descriptorPools = m_shader->GetDescriptorPools();
-
-	VkDescriptorPoolCreateInfo descriptorPoolCreateInfo = {};
-	descriptorPoolCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
-	descriptorPoolCreateInfo.flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT;
-	descriptorPoolCreateInfo.maxSets = 8192; // 16384;
-	descriptorPoolCreateInfo.poolSizeCount = static_cast<uint32_t>(descriptorPools.size());
-	descriptorPoolCreateInfo.pPoolSizes = descriptorPools.data();
-	Graphics::CheckVk(vkCreateDescriptorPool(*logicalDevice, &descriptorPoolCreateInfo, nullptr, &m_descriptorPool));
-}
-
 void PipelineGraphics::CreatePipelineLayout() {
 	auto logicalDevice = Graphics::Get()->GetLogicalDevice();
 
@@ -80,7 +80,7 @@ public:
 	bool IsPushDescriptors() const override { return m_pushDescriptors; }
 	const Shader *GetShader() const override { return m_shader.get(); }
 	const VkDescriptorSetLayout &GetDescriptorSetLayout() const override { return m_descriptorSetLayout; }
-	const VkDescriptorPool &GetDescriptorPool() const override { return m_descriptorPool; }
+	const std::shared_ptr<DescriptorPool> &GetDescriptorPool() const override { return m_descriptorPool; }
 	const VkPipeline &GetPipeline() const override { return m_pipeline; }
 	const VkPipelineLayout &GetPipelineLayout() const override { return m_pipelineLayout; }
 	const VkPipelineBindPoint &GetPipelineBindPoint() const override { return m_pipelineBindPoint; }
@@ -88,7 +88,6 @@ public:
 private:
 	void CreateShaderProgram();
 	void CreateDescriptorLayout();
-	void CreateDescriptorPool();
 	void CreatePipelineLayout();
 	void CreateAttributes();
 	void CreatePipeline();
@@ -115,7 +114,7 @@ private:
 	std::vector<VkPipelineShaderStageCreateInfo> m_stages;
 
 	VkDescriptorSetLayout m_descriptorSetLayout = VK_NULL_HANDLE;
-	VkDescriptorPool m_descriptorPool = VK_NULL_HANDLE;
+	std::shared_ptr<DescriptorPool> m_descriptorPool;
 
 	VkPipeline m_pipeline = VK_NULL_HANDLE;
 	VkPipelineLayout m_pipelineLayout = VK_NULL_HANDLE;
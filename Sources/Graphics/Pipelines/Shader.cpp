@@ -14,9 +14,14 @@ namespace acid {
 class ShaderIncluder :
 	public glslang::TShader::Includer {
 public:
+	explicit ShaderIncluder(std::vector<std::filesystem::path> &includes) :
+		m_includes(includes) {
+	}
+
 	IncludeResult *includeLocal(const char *headerName, const char *includerName, size_t inclusionDepth) override {
 		auto directory = std::filesystem::path(includerName).parent_path();
 		auto fileLoaded = Files::Read(directory / headerName);
+		m_includes.emplace_back(directory / headerName);
 
 		if (!fileLoaded) {
 			Log::Error("Shader Include could not be loaded: ", std::quoted(headerName), '\n');
@@ -30,6 +35,7 @@ public:
 
 	IncludeResult *includeSystem(const char *headerName, const char *includerName, size_t inclusionDepth) override {
 		auto fileLoaded = Files::Read(headerName);
+		m_includes.emplace_back(headerName);
 
 		if (!fileLoaded) {
 			Log::Error("Shader Include could not be loaded: ", std::quoted(headerName), '\n');
@@ -47,6 +53,9 @@ public:
 			delete result;
 		}
 	}
+
+private:
+	std::vector<std::filesystem::path> &m_includes;
 };
 
 Shader::Shader() {
@@ -343,7 +352,7 @@ VkShaderModule Shader::CreateShaderModule(const std::filesystem::path &moduleNam
 	shader.setEnvClient(glslang::EShClientVulkan, glslang::EShTargetVulkan_1_1);
 	shader.setEnvTarget(glslang::EShTargetSpv, glslang::EShTargetSpv_1_3);
 
-	ShaderIncluder includer;
+	ShaderIncluder includer(m_includes);
 
 	auto defaultVersion = glslang::EShTargetVulkan_1_1;
 
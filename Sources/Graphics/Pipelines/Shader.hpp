@@ -288,6 +288,8 @@ public:
 	void CreateReflection();
 
 	const std::filesystem::path &GetName() const { return m_stages.back(); }
+	const std::vector<std::filesystem::path> &GetStages() const { return m_stages; }
+	const std::vector<std::filesystem::path> &GetIncludes() const { return m_includes; }
 	uint32_t GetLastDescriptorBinding() const { return m_lastDescriptorBinding; }
 	const std::map<std::string, Uniform> &GetUniforms() const { return m_uniforms; };
 	const std::map<std::string, UniformBlock> &GetUniformBlocks() const { return m_uniformBlocks; };
@@ -309,6 +311,7 @@ private:
 	static int32_t ComputeSize(const glslang::TType *ttype);
 
 	std::vector<std::filesystem::path> m_stages;
+	std::vector<std::filesystem::path> m_includes;
 	std::map<std::string, Uniform> m_uniforms;
 	std::map<std::string, UniformBlock> m_uniformBlocks;
 	std::map<std::string, Attribute> m_attributes;
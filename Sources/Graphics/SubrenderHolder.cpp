@@ -1,5 +1,7 @@
 #include "SubrenderHolder.hpp"
 
+#include "Engine/Profiler.hpp"
+
 namespace acid {
 void SubrenderHolder::Clear() {
 	m_stages.clear();
@@ -23,6 +25,7 @@ void SubrenderHolder::RenderStage(const Pipeline::Stage &stage, const CommandBuf
 
 		if (auto &subrender = m_subrenders[typeId]) {
 			if (subrender->IsEnabled()) {
+				ACID_PROFILE_SCOPE(typeid(*subrender).name());
 				subrender->Render(commandBuffer);
 			}
 		}
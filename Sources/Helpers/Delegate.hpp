@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <mutex>
 #include "ConstExpr.hpp"
 #include "NonCopyable.hpp"
@@ -14,187 +15,463 @@ public:
 		m_valid(std::make_shared<bool>(true)) {
 	}
 
-	virtual ~Observer() = default;
-
-	std::shared_ptr<bool> m_valid;
-};
-
-template<typename TReturnType, typename ...TArgs>
-class Invoker {
-public:
-	using ReturnType = std::vector<TReturnType>;
-
-	static ReturnType Invoke(Delegate<TReturnType(TArgs ...)> &delegate, TArgs ... params) {
-		std::lock_guard<std::mutex> lock(delegate.m_mutex);
-		ReturnType returnValues;
-
-		for (auto it = delegate.m_functions.begin(); it != delegate.m_functions.end();) {
-			if (it->IsExpired()) {
-				it = delegate.m_functions.erase(it);
-				continue;
-			}
-
-			returnValues.emplace_back((*it->m_function)(params...));
-			++it;
-		}
-
-		return returnValues;
+	// Copies are separate observers, so functions tied to the original are not tied to the copy.
+	Observer(const Observer &) :
+		Observer() {
 	}
-};
-
-template<typename... TArgs>
-class Invoker<void, TArgs...> {
-public:
-	using ReturnType = void;
 
-	static void Invoke(Delegate<void(TArgs ...)> &delegate, TArgs ... params) {
-		std::lock_guard<std::mutex> lock(delegate.m_mutex);
-
-		if (delegate.m_functions.empty()) {
-			return;
-		}
+	virtual ~Observer() = default;
 
-		for (auto it = delegate.m_functions.begin(); it != delegate.m_functions.end();) {
-			if (it->IsExpired()) {
-				it = delegate.m_functions.erase(it);
-				continue;
-			}
+	Observer &operator=(const Observer &) { return *this; }
 
-			it->m_function(params...);
-			++it;
-		}
-	}
+	std::shared_ptr<bool> m_valid;
 };
 
+/**
+ * @brief A list of functions called together, that can be tied to the lifetime of observers.
+ * The function list is copy on write: adding or removing a function copies the list under a mutex, while invoking reads the current list
+ * without locking or allocating. Functions may add or remove functions on the delegate they are called from, changes apply to the next call.
+ * @tparam TReturnType The return type of the functions, if not void invoking returns a vector of every functions result.
+ * @tparam TArgs The arguments passed to the functions.
+ */
 template<typename TReturnType, typename ...TArgs>
 class Delegate<TReturnType(TArgs ...)> {
 public:
-	using Invoker = acid::Invoker<TReturnType, TArgs...>;
+	using ReturnType = std::conditional_t<std::is_void_v<TReturnType>, void, std::vector<TReturnType>>;
 	using FunctionType = std::function<TReturnType(TArgs ...)>;
 	using ObserversType = std::vector<std::weak_ptr<bool>>;
 
-	struct FunctionPair {
-		FunctionType m_function;
-		ObserversType m_observers;
+	/**
+	 * @brief A function in the list, the callable is stored inline in the same allocation.
+	 */
+	class Subscriber {
+	public:
+		Subscriber(const std::type_info &type, ObserversType &&observers) :
+			m_type(type),
+			m_observers(std::move(observers)) {
+		}
+
+		virtual ~Subscriber() = default;
 
+		virtual TReturnType Call(TArgs ... args) = 0;
+
+		/**
+		 * Gets if the function was removed or any of its observers has been destroyed, once expired it stays expired.
+		 * @return If the function expired.
+		 */
 		bool IsExpired() {
+			if (m_expired.load(std::memory_order_relaxed)) {
+				return true;
+			}
+
 			for (const auto &observer : m_observers) {
 				if (observer.expired()) {
+					m_expired.store(true, std::memory_order_relaxed);
 					return true;
 				}
 			}
 
 			return false;
 		}
+
+		const std::type_info &m_type;
+		ObserversType m_observers;
+		std::atomic<bool> m_expired = false;
 	};
 
+	using SubscribersType = std::vector<std::shared_ptr<Subscriber>>;
+
 	Delegate() = default;
 	virtual ~Delegate() = default;
 
-	template<typename ...KArgs>
-	void Add(FunctionType &&function, KArgs ...args) {
-		std::lock_guard<std::mutex> lock(m_mutex);
+	template<typename F, typename ...KArgs>
+	void Add(F &&function, KArgs ...args) {
 		ObserversType observers;
+		(observers.emplace_back(ConstExpr::AsPtr(args)->m_valid), ...);
+		std::shared_ptr<Subscriber> subscriber = std::make_shared<SubscriberFunction<std::decay_t<F>>>(std::forward<F>(function), std::move(observers));
 
-		if constexpr (sizeof...(args) != 0) {
-			for (const auto &arg : {args...}) {
-				observers.emplace_back(ConstExpr::AsPtr(arg)->m_valid);
-			}
-		}
-
-		m_functions.emplace_back(FunctionPair{std::move(function), observers});
+		Modify([&subscriber](SubscribersType &subscribers) {
+			subscribers.emplace_back(std::move(subscriber));
+		});
 	}
 
-	void Remove(const FunctionType &function) {
-		std::lock_guard<std::mutex> lock(m_mutex);
-		m_functions.erase(std::remove_if(m_functions.begin(), m_functions.end(), [function](FunctionPair &f) {
-			return Hash(f.m_function) == Hash(function);
-		}), m_functions.end());
+	/**
+	 * Removes every function with the same callable type as the function.
+	 * @param function The function to remove.
+	 */
+	template<typename F>
+	void Remove(const F &function) {
+		auto type = &TypeOf(function);
+
+		Modify([type](SubscribersType &subscribers) {
+			RemoveIf(subscribers, [type](Subscriber &subscriber) {
+				return subscriber.m_type == *type;
+			});
+		});
 	}
 
+	/**
+	 * Unties functions from observers, functions tied to other observers as well are kept and only removed once those have been destroyed.
+	 * Functions left with no observers are removed, functions not tied to any of the observers are left as they are.
+	 * @param args The observers to untie.
+	 */
 	template<typename ...KArgs>
 	void RemoveObservers(KArgs ...args) {
-		ObserversType removes;
+		std::vector<bool *> removes;
+		(removes.emplace_back(ConstExpr::AsPtr(args)->m_valid.get()), ...);
 
-		if constexpr (sizeof...(args) != 0) {
-			for (const auto &arg : {args...}) {
-				removes.emplace_back(ConstExpr::AsPtr(arg)->m_valid);
-			}
-		}
-		
-		for (auto it = m_functions.begin(); it != m_functions.end();) {
-			for (auto it1 = it->m_observers.begin(); it1 != it->m_observers.end();) {
-				bool erase = false;
-				auto opt = it1->lock();
-				for (const auto &remove : removes) {
-					auto ept = remove.lock();
-					if (opt.get() == ept.get())
-						erase = true;
+		Modify([&removes](SubscribersType &subscribers) {
+			for (auto &subscriber : subscribers) {
+				ObserversType observers;
+
+				for (const auto &observer : subscriber->m_observers) {
+					if (std::find(removes.begin(), removes.end(), observer.lock().get()) == removes.end()) {
+						observers.emplace_back(observer);
+					}
+				}
+
+				if (observers.size() == subscriber->m_observers.size()) {
+					continue;
+				}
+
+				if (observers.empty()) {
+					// Stops the function being called by invocations already reading the old list.
+					subscriber->m_expired.store(true, std::memory_order_relaxed);
+					subscriber = nullptr;
+				} else {
+					// Subscribers are shared with invocations reading the old list, so the remaining observers go in a new one.
+					subscriber = std::make_shared<SubscriberForward>(std::move(subscriber), std::move(observers));
 				}
-				if (erase)
-					it1 = it->m_observers.erase(it1);
-				else
-					++it1;
 			}
 
-			if (it->m_observers.empty())
-				it = m_functions.erase(it);
-			else
-				++it;
-		}
+			subscribers.erase(std::remove(subscribers.begin(), subscribers.end(), nullptr), subscribers.end());
+		});
 	}
 
+	/**
+	 * Moves every function from another delegate into this delegate.
+	 * @param from The delegate to take functions from.
+	 * @param exclude Functions observed by any of these are left in the other delegate.
+	 */
 	void MoveFunctions(Delegate &from, const ObserversType &exclude = {}) {
-		for (auto it = from.m_functions.begin(); it < from.m_functions.end();) {
-			bool move = true;
-			for (const auto &excluded : exclude) {
-				auto ept = excluded.lock();
-				for (const auto &observer : it->m_observers) {
-					auto opt = observer.lock();
-					if (opt.get() == ept.get())
-						move = false;
+		SubscribersType moved;
+
+		from.Modify([&moved, &exclude](SubscribersType &subscribers) {
+			auto it = std::stable_partition(subscribers.begin(), subscribers.end(), [&exclude](const std::shared_ptr<Subscriber> &subscriber) {
+				for (const auto &excluded : exclude) {
+					auto ept = excluded.lock();
+
+					for (const auto &observer : subscriber->m_observers) {
+						if (observer.lock() == ept) {
+							return true;
+						}
+					}
 				}
-			}
 
-			if (move) {
-				std::move(from.m_functions.begin(), it, std::back_inserter(m_functions));
-				it = from.m_functions.erase(from.m_functions.begin(), it);
-			} else {
-				++it;
-			}
-		}
+				return false;
+			});
+			moved.assign(std::make_move_iterator(it), std::make_move_iterator(subscribers.end()));
+			subscribers.erase(it, subscribers.end());
+		});
+
+		Modify([&moved](SubscribersType &subscribers) {
+			std::move(moved.begin(), moved.end(), std::back_inserter(subscribers));
+		});
 	}
 
 	void Clear() {
+		Modify([](SubscribersType &subscribers) {
+			for (auto &subscriber : subscribers) {
+				subscriber->m_expired.store(true, std::memory_order_relaxed);
+			}
+
+			subscribers.clear();
+		});
+	}
+
+	/**
+	 * Gets the number of functions in the list, including expired functions that have not been compacted yet.
+	 * @return The number of functions.
+	 */
+	std::size_t GetSize() {
+		ReadGuard guard(*this);
+		return guard.m_subscribers ? guard.m_subscribers->size() : 0;
+	}
+
+	/**
+	 * Gets the number of replaced function lists kept alive for invocations that may still be reading them.
+	 * @return The number of retired lists.
+	 */
+	std::size_t GetRetiredCount() {
 		std::lock_guard<std::mutex> lock(m_mutex);
-		m_functions.clear();
+		return m_retired[0].size() + m_retired[1].size();
 	}
 
-	typename Invoker::ReturnType Invoke(TArgs ... args) {
-		return Invoker::Invoke(*this, args...);
+	ReturnType Invoke(TArgs ... args) {
+		std::size_t expired = 0;
+		std::size_t size = 0;
+
+		if constexpr (std::is_void_v<TReturnType>) {
+			{
+				ReadGuard guard(*this);
+
+				if (!guard.m_subscribers) {
+					return;
+				}
+
+				for (const auto &subscriber : *guard.m_subscribers) {
+					if (subscriber->IsExpired()) {
+						expired++;
+						continue;
+					}
+
+					subscriber->Call(args...);
+				}
+
+				size = guard.m_subscribers->size();
+			}
+
+			Compact(expired, size);
+		} else {
+			ReturnType returnValues;
+
+			{
+				ReadGuard guard(*this);
+
+				if (!guard.m_subscribers) {
+					return returnValues;
+				}
+
+				returnValues.reserve(guard.m_subscribers->size());
+
+				for (const auto &subscriber : *guard.m_subscribers) {
+					if (subscriber->IsExpired()) {
+						expired++;
+						continue;
+					}
+
+					returnValues.emplace_back(subscriber->Call(args...));
+				}
+
+				size = guard.m_subscribers->size();
+			}
+
+			Compact(expired, size);
+			return returnValues;
+		}
 	}
 
-	Delegate &operator+=(FunctionType &&function) {
-		return Add(std::move(function));
+	template<typename F>
+	Delegate &operator+=(F &&function) {
+		Add(std::forward<F>(function));
+		return *this;
 	}
 
-	Delegate &operator-=(const FunctionType function) {
-		return Remove(function);
+	template<typename F>
+	Delegate &operator-=(const F &function) {
+		Remove(function);
+		return *this;
 	}
 
-	typename Invoker::ReturnType operator()(TArgs ... args) {
-		return Invoker::Invoke(*this, args...);
+	ReturnType operator()(TArgs ... args) {
+		return Invoke(args...);
 	}
 
 private:
-	friend Invoker;
+	/**
+	 * @brief Reads the current function list, counted as a reader of the epoch it started in.
+	 * Lists replaced in a epoch are kept alive until every reader that started in that epoch or before has finished.
+	 */
+	class ReadGuard {
+	public:
+		explicit ReadGuard(Delegate &delegate) :
+			m_delegate(delegate) {
+			// Retried if the epoch advanced before this reader was counted, so it is never counted in a epoch that is being drained.
+			while (true) {
+				auto epoch = m_delegate.m_epoch.load();
+				m_readers = &m_delegate.m_readers[epoch & 1];
+				m_readers->fetch_add(1);
+
+				if (m_delegate.m_epoch.load() == epoch) {
+					break;
+				}
+
+				m_readers->fetch_sub(1);
+			}
+
+			m_subscribers = m_delegate.m_subscribers.load();
+		}
+
+		~ReadGuard() {
+			m_readers->fetch_sub(1);
+		}
+
+		ReadGuard(const ReadGuard &) = delete;
+		ReadGuard &operator=(const ReadGuard &) = delete;
+
+		Delegate &m_delegate;
+		std::atomic<uint32_t> *m_readers;
+		const SubscribersType *m_subscribers;
+	};
+
+	template<typename F>
+	class SubscriberFunction : public Subscriber {
+	public:
+		template<typename G>
+		SubscriberFunction(G &&function, ObserversType &&observers) :
+			Subscriber(TypeOf(function), std::move(observers)),
+			m_function(std::forward<G>(function)) {
+		}
+
+		TReturnType Call(TArgs ... args) override {
+			return m_function(args...);
+		}
+
+	private:
+		F m_function;
+	};
+
+	/**
+	 * @brief A function tied to fewer observers than when it was added, calls the function of the subscriber it replaced.
+	 */
+	class SubscriberForward : public Subscriber {
+	public:
+		SubscriberForward(std::shared_ptr<Subscriber> &&subscriber, ObserversType &&observers) :
+			Subscriber(subscriber->m_type, std::move(observers)),
+			m_subscriber(std::move(subscriber)) {
+		}
+
+		TReturnType Call(TArgs ... args) override {
+			return m_subscriber->Call(args...);
+		}
+
+	private:
+		std::shared_ptr<Subscriber> m_subscriber;
+	};
+
+	/**
+	 * Gets the type used to find a function when removing it, a std::function is found by the type it wraps.
+	 * @param function The function.
+	 * @return The callable type.
+	 */
+	template<typename F>
+	static const std::type_info &TypeOf(const F &function) {
+		if constexpr (std::is_same_v<F, FunctionType>) {
+			return function.target_type();
+		} else {
+			return typeid(F);
+		}
+	}
 
-	static constexpr size_t Hash(const FunctionType &function) {
-		return function.target_type().hash_code();
+	template<typename Func>
+	static void RemoveIf(SubscribersType &subscribers, Func &&predicate) {
+		subscribers.erase(std::remove_if(subscribers.begin(), subscribers.end(), [&predicate](const std::shared_ptr<Subscriber> &subscriber) {
+			if (predicate(*subscriber)) {
+				// Stops the function being called by invocations already reading the old list.
+				subscriber->m_expired.store(true, std::memory_order_relaxed);
+				return true;
+			}
+
+			return false;
+		}), subscribers.end());
+	}
+
+	/**
+	 * Replaces the function list with a modified copy.
+	 * @param modify Modifies the copied list, expired functions have already been removed from it.
+	 */
+	template<typename Func>
+	void Modify(Func &&modify) {
+		std::lock_guard<std::mutex> lock(m_mutex);
+		ModifyLocked(std::forward<Func>(modify));
+	}
+
+	template<typename Func>
+	void ModifyLocked(Func &&modify) {
+		auto subscribers = std::make_unique<SubscribersType>();
+
+		if (m_current) {
+			subscribers->reserve(m_current->size() + 1);
+			std::copy_if(m_current->begin(), m_current->end(), std::back_inserter(*subscribers), [](const std::shared_ptr<Subscriber> &subscriber) {
+				return !subscriber->IsExpired();
+			});
+		}
+
+		modify(*subscribers);
+		m_subscribers.store(subscribers.get());
+
+		if (m_current) {
+			m_retired[m_epoch.load() & 1].emplace_back(std::move(m_current));
+		}
+
+		m_current = std::move(subscribers);
+		Reclaim();
+	}
+
+	/**
+	 * Frees retired lists that no reader can still see, and advances the epoch so lists retired in the current one can be freed once its
+	 * readers finish. Readers that keep overlapping each other still let the epoch advance, as new readers are counted in the next epoch.
+	 * Must be called with the mutex locked.
+	 */
+	void Reclaim() {
+		while (true) {
+			auto epoch = m_epoch.load();
+
+			// Readers of the previous epoch share a counter with the next, the epoch only advances once they have all finished.
+			if (m_readers[(epoch + 1) & 1].load() != 0) {
+				break;
+			}
+
+			// Lists retired in the previous epoch could only be seen by its readers.
+			m_retired[(epoch + 1) & 1].clear();
+
+			if (m_retired[epoch & 1].empty()) {
+				break;
+			}
+
+			// Readers that start after this can only see the current list.
+			m_epoch.store(epoch + 1);
+		}
+
+		m_hasRetired.store(!m_retired[0].empty() || !m_retired[1].empty(), std::memory_order_relaxed);
+	}
+
+	/**
+	 * Removes expired functions once they are at least half of the list, and frees replaced lists once nothing reads them.
+	 * Skipped if another thread is modifying the list.
+	 * @param expired The number of expired functions found while invoking.
+	 * @param size The size of the list that was invoked.
+	 */
+	void Compact(std::size_t expired, std::size_t size) {
+		if (expired == 0 || expired * 2 < size) {
+			// Frees lists that were replaced while being invoked.
+			if (m_hasRetired.load(std::memory_order_relaxed)) {
+				std::unique_lock<std::mutex> lock(m_mutex, std::try_to_lock);
+
+				if (lock.owns_lock()) {
+					Reclaim();
+				}
+			}
+
+			return;
+		}
+
+		std::unique_lock<std::mutex> lock(m_mutex, std::try_to_lock);
+
+		if (lock.owns_lock()) {
+			ModifyLocked([](SubscribersType &) {});
+		}
 	}
 
 	std::mutex m_mutex;
-	std::vector<FunctionPair> m_functions;
+	std::unique_ptr<SubscribersType> m_current;
+	// Lists replaced in even and odd epochs.
+	std::array<std::vector<std::unique_ptr<SubscribersType>>, 2> m_retired;
+	std::atomic<const SubscribersType *> m_subscribers = nullptr;
+	std::atomic<uint64_t> m_epoch = 0;
+	// Readers that started in even and odd epochs.
+	std::array<std::atomic<uint32_t>, 2> m_readers = {};
+	std::atomic<bool> m_hasRetired = false;
 };
 
 template<typename T>
@@ -209,7 +486,7 @@ public:
 
 	DelegateValue &operator=(T value) {
 		m_value = value;
-		Invoke(m_value);
+		Delegate<void(T)>::Invoke(m_value);
 		return *this;
 	}
 
@@ -0,0 +1,99 @@
+#include "FrameAllocator.hpp"
+
+namespace acid {
+namespace {
+std::atomic<uint64_t> CurrentFrame = 0;
+
+std::atomic<uint64_t> Allocations = 0;
+std::atomic<uint64_t> Bytes = 0;
+std::atomic<uint64_t> Blocks = 0;
+
+std::atomic<uint64_t> LastAllocations = 0;
+std::atomic<uint64_t> LastBytes = 0;
+std::atomic<uint64_t> LastBlocks = 0;
+}
+
+FrameAllocator &FrameAllocator::Get() {
+	thread_local FrameAllocator allocator;
+
+	// Blocks with live allocations are kept until those are released, a later call in the frame rewinds them.
+	if (auto frame = CurrentFrame.load(std::memory_order_acquire); allocator.m_frame != frame && allocator.m_live.load(std::memory_order_acquire) == 0) {
+		allocator.Reset();
+		allocator.m_frame = frame;
+	}
+
+	return allocator;
+}
+
+void FrameAllocator::NextFrame() {
+	LastAllocations.store(Allocations.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+	LastBytes.store(Bytes.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+	LastBlocks.store(Blocks.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+	CurrentFrame.fetch_add(1, std::memory_order_release);
+}
+
+FrameAllocator::Stats FrameAllocator::GetFrameStats() {
+	return {LastAllocations.load(std::memory_order_relaxed), LastBytes.load(std::memory_order_relaxed), LastBlocks.load(std::memory_order_relaxed)};
+}
+
+std::size_t FrameAllocator::GetCapacity() const {
+	std::size_t capacity = 0;
+
+	for (const auto &block : m_blocks) {
+		capacity += block.m_size;
+	}
+
+	return capacity;
+}
+
+void *FrameAllocator::do_allocate(std::size_t bytes, std::size_t alignment) {
+	while (true) {
+		if (m_block < m_blocks.size()) {
+			auto &block = m_blocks[m_block];
+			void *ptr = block.m_data.get() + m_offset;
+			auto space = block.m_size - m_offset;
+
+			if (std::align(alignment, bytes, ptr, space)) {
+				m_offset = block.m_size - space + bytes;
+				m_used += bytes;
+				m_live.fetch_add(1, std::memory_order_relaxed);
+				Allocations.fetch_add(1, std::memory_order_relaxed);
+				Bytes.fetch_add(bytes, std::memory_order_relaxed);
+				return ptr;
+			}
+
+			m_block++;
+			m_offset = 0;
+			continue;
+		}
+
+		// Each new block is at least as big as everything before it, so a frame needs few blocks even when it grows quickly.
+		auto size = std::max({BlockSize, GetCapacity(), bytes + alignment});
+		m_blocks.emplace_back(Block{std::unique_ptr<std::byte[]>(new std::byte[size]), size});
+		Blocks.fetch_add(1, std::memory_order_relaxed);
+	}
+}
+
+void FrameAllocator::do_deallocate(void *p, std::size_t bytes, std::size_t alignment) {
+	// Memory is only released when the frame ends, once nothing allocated is live.
+	m_live.fetch_sub(1, std::memory_order_release);
+}
+
+bool FrameAllocator::do_is_equal(const std::pmr::memory_resource &other) const noexcept {
+	return this == &other;
+}
+
+void FrameAllocator::Reset() {
+	// Merges the blocks used last frame into one, so the next frame fits without growing.
+	if (m_blocks.size() > 1) {
+		auto capacity = GetCapacity();
+		m_blocks.clear();
+		m_blocks.emplace_back(Block{std::unique_ptr<std::byte[]>(new std::byte[capacity]), capacity});
+		Blocks.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	m_block = 0;
+	m_offset = 0;
+	m_used = 0;
+}
+}
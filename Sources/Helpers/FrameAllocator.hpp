@@ -0,0 +1,91 @@
+#pragma once
+
+#include <atomic>
+#include <memory_resource>
+#include "StdAfx.hpp"
+
+namespace acid {
+/**
+ * @brief A per-thread linear allocator for memory that only lives until the end of the current frame.
+ * Allocations bump a pointer through blocks owned by the thread, deallocations only count down the live allocations, and everything is
+ * released at once when the thread first uses the allocator in a new frame. Use it through the {@code std::pmr} containers, for example
+ * {@code std::pmr::vector<T> values(&FrameAllocator::Get());}, and only for locals released before the frame ends.
+ * A thread's blocks are never rewound while anything allocated from them is live, so a container a job keeps across a frame boundary delays
+ * the rewind until it is released instead of being overwritten. Storage that lives longer than a frame belongs on the heap.
+ */
+class ACID_EXPORT FrameAllocator : public std::pmr::memory_resource {
+public:
+	/// The size of the first block each thread allocates.
+	static constexpr std::size_t BlockSize = 64 * 1024;
+
+	/**
+	 * @brief Counters of frame allocations made on every thread during a frame.
+	 */
+	struct Stats {
+		/// The number of allocations served from frame memory.
+		uint64_t m_allocations = 0;
+		/// The number of bytes served from frame memory.
+		uint64_t m_bytes = 0;
+		/// The number of blocks that had to be allocated from the heap, zero once every thread's arena has grown to fit a frame.
+		uint64_t m_blocks = 0;
+	};
+
+	FrameAllocator() = default;
+
+	/**
+	 * Gets the calling thread's frame allocator, rewinding it first if a new frame has started and none of its allocations are live.
+	 * @return The frame allocator.
+	 */
+	static FrameAllocator &Get();
+
+	/**
+	 * Ends the current frame, every thread's frame memory is released before its next allocation. Called by the engine after rendering.
+	 */
+	static void NextFrame();
+
+	/**
+	 * Gets the allocation counters of the last finished frame.
+	 * @return The frame stats.
+	 */
+	static Stats GetFrameStats();
+
+	/**
+	 * Gets the number of bytes the calling thread has allocated this frame.
+	 * @return The used bytes.
+	 */
+	std::size_t GetUsed() const { return m_used; }
+
+	/**
+	 * Gets the number of allocations from this allocator that have not been deallocated.
+	 * @return The live allocations.
+	 */
+	std::size_t GetLive() const { return m_live.load(std::memory_order_relaxed); }
+
+	/**
+	 * Gets the number of bytes reserved by this allocator's blocks.
+	 * @return The reserved bytes.
+	 */
+	std::size_t GetCapacity() const;
+
+protected:
+	void *do_allocate(std::size_t bytes, std::size_t alignment) override;
+	void do_deallocate(void *p, std::size_t bytes, std::size_t alignment) override;
+	bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override;
+
+private:
+	struct Block {
+		std::unique_ptr<std::byte[]> m_data;
+		std::size_t m_size;
+	};
+
+	void Reset();
+
+	std::vector<Block> m_blocks;
+	std::size_t m_block = 0;
+	std::size_t m_offset = 0;
+	std::size_t m_used = 0;
+	// Containers may be destroyed on another thread than the one that allocated them.
+	std::atomic<std::size_t> m_live = 0;
+	uint64_t m_frame = 0;
+};
+}
@@ -0,0 +1,275 @@
+#include "JobSystem.hpp"
+
+#include "Engine/Profiler.hpp"
+
+namespace acid {
+namespace {
+struct WorkerContext {
+	const JobSystem *m_system = nullptr;
+	uint32_t m_index = 0;
+	uint32_t m_random = 0x9E3779B9u;
+};
+
+thread_local WorkerContext CurrentWorker;
+
+uint32_t NextRandom(uint32_t &state) {
+	// Xorshift32, only used to pick a victim to steal from.
+	state ^= state << 13;
+	state ^= state >> 17;
+	state ^= state << 5;
+	return state;
+}
+}
+
+JobSystem::JobSystem(uint32_t threadCount, uint32_t jobCapacity) :
+	m_jobs(std::make_unique<Job[]>(jobCapacity)),
+	m_jobCapacity(jobCapacity) {
+	if (jobCapacity == 0) {
+		throw std::runtime_error("Job capacity must be non-zero");
+	}
+
+	// Builds the free list so job 0 is popped first.
+	for (uint32_t i = jobCapacity; i-- > 0;) {
+		m_jobs[i].m_nextFree.store(static_cast<uint32_t>(m_freeHead.load(std::memory_order_relaxed)), std::memory_order_relaxed);
+		m_freeHead.store(i + 1, std::memory_order_relaxed);
+	}
+
+	threadCount = std::max(threadCount, 1u);
+	m_workers.reserve(threadCount);
+
+	for (uint32_t i = 0; i < threadCount; ++i) {
+		m_workers.emplace_back(std::make_unique<Worker>());
+	}
+
+	// Threads are started after every worker exists, so thieves never see a partially built list.
+	for (uint32_t i = 0; i < threadCount; ++i) {
+		m_workers[i]->m_thread = std::thread(&JobSystem::WorkerRun, this, i);
+	}
+}
+
+JobSystem::~JobSystem() {
+	Wait();
+
+	{
+		std::unique_lock<std::mutex> lock(m_sleepMutex);
+		m_stop = true;
+	}
+
+	m_condition.notify_all();
+
+	for (auto &worker : m_workers) {
+		worker->m_thread.join();
+	}
+}
+
+void JobSystem::Run(Job *job) {
+	if (auto index = GetWorkerIndex(); index != NoWorker) {
+		if (!m_workers[index]->m_queue.Push(job)) {
+			// The deque is full, running inline keeps the worker making progress.
+			Execute(job);
+			return;
+		}
+	} else {
+		std::unique_lock<std::mutex> lock(m_injectedMutex);
+		m_injected.emplace_back(job);
+		m_injectedSize.fetch_add(1, std::memory_order_release);
+	}
+
+	Notify();
+}
+
+void JobSystem::Wait(const JobCounter &counter) {
+	while (!counter.IsDone()) {
+		if (!RunPending()) {
+			std::this_thread::yield();
+		}
+	}
+}
+
+void JobSystem::Wait() {
+	while (m_liveJobs.load(std::memory_order_acquire) != 0) {
+		if (!RunPending()) {
+			std::this_thread::yield();
+		}
+	}
+}
+
+bool JobSystem::RunPending() {
+	if (auto job = FindJob(GetWorkerIndex())) {
+		Execute(job);
+		return true;
+	}
+
+	return false;
+}
+
+bool JobSystem::IsWorkerThread() const {
+	return GetWorkerIndex() != NoWorker;
+}
+
+Job *JobSystem::AcquireJob() {
+	auto head = m_freeHead.load(std::memory_order_acquire);
+
+	while (true) {
+		auto index = static_cast<uint32_t>(head);
+
+		if (index == 0) {
+			// Every job is in flight, help drain them until one is released.
+			if (!RunPending()) {
+				std::this_thread::yield();
+			}
+
+			head = m_freeHead.load(std::memory_order_acquire);
+			continue;
+		}
+
+		auto job = &m_jobs[index - 1];
+		auto tag = (head >> 32) + 1;
+		auto next = (tag << 32) | job->m_nextFree.load(std::memory_order_relaxed);
+
+		if (m_freeHead.compare_exchange_weak(head, next, std::memory_order_acquire, std::memory_order_acquire)) {
+			m_liveJobs.fetch_add(1, std::memory_order_relaxed);
+			return job;
+		}
+	}
+}
+
+void JobSystem::ReleaseJob(Job *job) {
+	auto index = static_cast<uint64_t>(job - m_jobs.get()) + 1;
+	auto head = m_freeHead.load(std::memory_order_relaxed);
+
+	while (true) {
+		job->m_nextFree.store(static_cast<uint32_t>(head), std::memory_order_relaxed);
+		auto tag = (head >> 32) + 1;
+
+		if (m_freeHead.compare_exchange_weak(head, (tag << 32) | index, std::memory_order_release, std::memory_order_relaxed)) {
+			break;
+		}
+	}
+
+	m_liveJobs.fetch_sub(1, std::memory_order_release);
+}
+
+void JobSystem::WorkerRun(uint32_t index) {
+	CurrentWorker.m_system = this;
+	CurrentWorker.m_index = index;
+	CurrentWorker.m_random ^= (index + 1) * 0x85EBCA6Bu;
+	Profiler::SetThreadName("Job Worker " + std::to_string(index));
+
+	while (true) {
+		if (auto job = FindJob(index)) {
+			Execute(job);
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock(m_sleepMutex);
+
+		if (m_stop) {
+			return;
+		}
+
+		// Announce we are going to sleep before checking one last time, pairs with the fence in Notify.
+		m_sleeping.fetch_add(1, std::memory_order_seq_cst);
+
+		if (auto job = FindJob(index)) {
+			m_sleeping.fetch_sub(1, std::memory_order_relaxed);
+			lock.unlock();
+			Execute(job);
+			continue;
+		}
+
+		m_condition.wait(lock, [this]() {
+			return m_stop || m_wakeups > 0;
+		});
+
+		if (m_wakeups > 0) {
+			m_wakeups--;
+		}
+
+		m_sleeping.fetch_sub(1, std::memory_order_relaxed);
+	}
+}
+
+Job *JobSystem::FindJob(uint32_t index) {
+	if (index != NoWorker) {
+		if (auto job = m_workers[index]->m_queue.Pop()) {
+			return job;
+		}
+	}
+
+	if (m_injectedSize.load(std::memory_order_acquire) != 0) {
+		std::unique_lock<std::mutex> lock(m_injectedMutex);
+
+		if (!m_injected.empty()) {
+			auto job = m_injected.front();
+			m_injected.pop_front();
+			m_injectedSize.fetch_sub(1, std::memory_order_relaxed);
+			return job;
+		}
+	}
+
+	auto workerCount = static_cast<uint32_t>(m_workers.size());
+	auto start = NextRandom(CurrentWorker.m_random) % workerCount;
+
+	for (uint32_t i = 0; i < workerCount; ++i) {
+		auto victim = (start + i) % workerCount;
+
+		if (victim == index) {
+			continue;
+		}
+
+		if (auto job = m_workers[victim]->m_queue.Steal()) {
+			return job;
+		}
+	}
+
+	return nullptr;
+}
+
+void JobSystem::Execute(Job *job) {
+	ACID_PROFILE_SCOPE("Job");
+	job->m_function(*job);
+	Finish(job);
+}
+
+void JobSystem::Finish(Job *job) {
+	if (job->m_unfinished.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+		return;
+	}
+
+	auto parent = job->m_parent;
+	auto counter = job->m_counter;
+	ReleaseJob(job);
+
+	if (parent) {
+		Finish(parent);
+	}
+
+	if (counter) {
+		counter->m_value.fetch_sub(1, std::memory_order_release);
+	}
+}
+
+void JobSystem::Notify() {
+	// Pairs with the sleeping increment in WorkerRun, either we see the sleeper or it sees our job.
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+
+	if (m_sleeping.load(std::memory_order_relaxed) == 0) {
+		return;
+	}
+
+	{
+		std::unique_lock<std::mutex> lock(m_sleepMutex);
+
+		if (m_wakeups < m_sleeping.load(std::memory_order_relaxed)) {
+			m_wakeups++;
+		}
+	}
+
+	m_condition.notify_one();
+}
+
+uint32_t JobSystem::GetWorkerIndex() const {
+	return CurrentWorker.m_system == this ? CurrentWorker.m_index : NoWorker;
+}
+}
@@ -0,0 +1,261 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#include "NonCopyable.hpp"
+#include "WorkStealingQueue.hpp"
+
+namespace acid {
+class JobSystem;
+
+/**
+ * @brief A counter that is incremented when a job is created against it and decremented once the job and all it's children have finished.
+ * Used with {@link JobSystem#Wait} for fork-join waits.
+ */
+class ACID_EXPORT JobCounter : public virtual NonCopyable {
+	friend class JobSystem;
+public:
+	JobCounter() = default;
+
+	/**
+	 * Gets the number of unfinished jobs tracked by this counter.
+	 * @return The number of unfinished jobs.
+	 */
+	uint32_t GetValue() const { return m_value.load(std::memory_order_acquire); }
+
+	/**
+	 * Gets if all jobs tracked by this counter have finished.
+	 * @return If the counter is zero.
+	 */
+	bool IsDone() const { return GetValue() == 0; }
+
+private:
+	std::atomic<uint32_t> m_value = 0;
+};
+
+/**
+ * @brief A unit of work owned by a {@link JobSystem}, the function is stored inline so creating a job does not allocate.
+ */
+class alignas(64) Job {
+	friend class JobSystem;
+public:
+	/// The number of bytes available to store a job function and it's captures.
+	static constexpr std::size_t StorageSize = 96;
+
+	/**
+	 * Gets the parent job, that will not finish until this job has finished.
+	 * @return The parent job, or nullptr.
+	 */
+	Job *GetParent() const { return m_parent; }
+
+private:
+	void (*m_function)(Job &job) = nullptr;
+	Job *m_parent = nullptr;
+	JobCounter *m_counter = nullptr;
+	std::atomic<int32_t> m_unfinished = 0;
+	std::atomic<uint32_t> m_nextFree = 0;
+	std::aligned_storage_t<StorageSize, alignof(std::max_align_t)> m_storage;
+};
+
+/**
+ * @brief A work-stealing job scheduler. Each worker owns a lock-free deque it pushes and pops from,
+ * idle workers steal from the other deques. Threads that are not workers submit through a shared queue.
+ */
+class ACID_EXPORT JobSystem : public virtual NonCopyable {
+public:
+	/**
+	 * Creates a new job system.
+	 * @param threadCount The number of worker threads to start.
+	 * @param jobCapacity The maximum number of jobs that can be alive at one time.
+	 */
+	explicit JobSystem(uint32_t threadCount = std::thread::hardware_concurrency(), uint32_t jobCapacity = 4096);
+
+	~JobSystem();
+
+	/**
+	 * Creates a job that will call the function when run. The function may take a {@code Job &} to create children from.
+	 * @tparam F The function type.
+	 * @param function The function to call.
+	 * @param counter A optional counter incremented now and decremented when the job finishes.
+	 * @return The created job, it must be passed to {@link JobSystem#Run}.
+	 */
+	template<typename F>
+	Job *Create(F &&function, JobCounter *counter = nullptr) {
+		return Allocate(nullptr, counter, std::forward<F>(function));
+	}
+
+	/**
+	 * Creates a job as a child of another, the parent will not finish until all of it's children finish.
+	 * @tparam F The function type.
+	 * @param parent The parent job, that has not yet finished.
+	 * @param function The function to call.
+	 * @return The created job, it must be passed to {@link JobSystem#Run}.
+	 */
+	template<typename F>
+	Job *CreateChild(Job &parent, F &&function) {
+		return Allocate(&parent, nullptr, std::forward<F>(function));
+	}
+
+	/**
+	 * Schedules a created job to be run on the calling worker's deque, or the shared queue if called from outside the job system.
+	 * @param job The job to run.
+	 */
+	void Run(Job *job);
+
+	/**
+	 * Creates and schedules a job in one call.
+	 * @tparam F The function type.
+	 * @param function The function to call.
+	 * @param counter A optional counter incremented now and decremented when the job finishes.
+	 */
+	template<typename F>
+	void Run(F &&function, JobCounter *counter = nullptr) {
+		Run(Create(std::forward<F>(function), counter));
+	}
+
+	/**
+	 * Schedules a function and it's arguments, returning a future for it's result.
+	 * Unlike {@link JobSystem#Run} this allocates the shared state for the future.
+	 * @tparam F The function type.
+	 * @tparam Args The argument types.
+	 * @param f The function to call.
+	 * @param args The arguments to bind.
+	 * @return The future result.
+	 */
+	template<typename F, typename... Args>
+	decltype(auto) Enqueue(F &&f, Args &&... args) {
+		using return_type = std::invoke_result_t<F, Args...>;
+
+		std::packaged_task<return_type()> task(std::bind(std::forward<F>(f), std::forward<Args>(args)...));
+		auto result = task.get_future();
+		Run(Create(std::move(task)));
+		return result;
+	}
+
+	/**
+	 * Splits a range into chunks that are run in parallel, the calling thread helps until all chunks are done.
+	 * @tparam F The function type, called as {@code function(begin, end)}.
+	 * @param count The size of the range.
+	 * @param chunkSize The maximum size of each chunk.
+	 * @param function The function to call on each chunk.
+	 */
+	template<typename F>
+	void ParallelFor(uint32_t count, uint32_t chunkSize, F &&function) {
+		chunkSize = std::max(chunkSize, 1u);
+		JobCounter counter;
+
+		for (uint32_t begin = 0; begin < count; begin += chunkSize) {
+			auto end = std::min(begin + chunkSize, count);
+			Run(Create([&function, begin, end]() {
+				function(begin, end);
+			}, &counter));
+		}
+
+		Wait(counter);
+	}
+
+	/**
+	 * Blocks until the counter reaches zero, the calling thread runs other jobs while it waits.
+	 * @param counter The counter to wait on.
+	 */
+	void Wait(const JobCounter &counter);
+
+	/**
+	 * Blocks until every created job has finished, the calling thread runs jobs while it waits.
+	 */
+	void Wait();
+
+	/**
+	 * Runs one pending job on the calling thread, if one is available.
+	 * @return If a job was run.
+	 */
+	bool RunPending();
+
+	/**
+	 * Gets the number of worker threads.
+	 * @return The worker thread count.
+	 */
+	uint32_t GetThreadCount() const { return static_cast<uint32_t>(m_workers.size()); }
+
+	/**
+	 * Gets if the calling thread is one of this job system's workers.
+	 * @return If called from a worker.
+	 */
+	bool IsWorkerThread() const;
+
+private:
+	static constexpr std::size_t QueueCapacity = 4096;
+	static constexpr uint32_t NoWorker = std::numeric_limits<uint32_t>::max();
+
+	struct Worker {
+		std::thread m_thread;
+		WorkStealingQueue<Job, QueueCapacity> m_queue;
+	};
+
+	template<typename F>
+	Job *Allocate(Job *parent, JobCounter *counter, F &&function) {
+		using Callable = std::decay_t<F>;
+		static_assert(sizeof(Callable) <= Job::StorageSize, "Job function is too large to store inline, capture by reference or pointer instead");
+		static_assert(alignof(Callable) <= alignof(std::max_align_t), "Job function is over-aligned");
+
+		auto job = AcquireJob();
+		new(&job->m_storage) Callable(std::forward<F>(function));
+		job->m_function = [](Job &job) {
+			auto callable = std::launder(reinterpret_cast<Callable *>(&job.m_storage));
+
+			if constexpr (std::is_invocable_v<Callable &, Job &>) {
+				(*callable)(job);
+			} else {
+				(*callable)();
+			}
+
+			callable->~Callable();
+		};
+		job->m_parent = parent;
+		job->m_counter = counter;
+		job->m_unfinished.store(1, std::memory_order_relaxed);
+
+		if (parent) {
+			parent->m_unfinished.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		if (counter) {
+			counter->m_value.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		return job;
+	}
+
+	Job *AcquireJob();
+	void ReleaseJob(Job *job);
+
+	void WorkerRun(uint32_t index);
+	Job *FindJob(uint32_t index);
+	void Execute(Job *job);
+	void Finish(Job *job);
+	void Notify();
+	uint32_t GetWorkerIndex() const;
+
+	std::vector<std::unique_ptr<Worker>> m_workers;
+
+	std::unique_ptr<Job[]> m_jobs;
+	uint32_t m_jobCapacity;
+	// Tagged head of the free list, high 32 bits are a ABA tag, low 32 bits are the job index + 1.
+	std::atomic<uint64_t> m_freeHead = 0;
+	std::atomic<uint32_t> m_liveJobs = 0;
+
+	std::mutex m_injectedMutex;
+	std::deque<Job *> m_injected;
+	std::atomic<uint32_t> m_injectedSize = 0;
+
+	std::mutex m_sleepMutex;
+	std::condition_variable m_condition;
+	std::atomic<uint32_t> m_sleeping = 0;
+	uint32_t m_wakeups = 0;
+	bool m_stop = false;
+};
+}
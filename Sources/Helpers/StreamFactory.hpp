@@ -44,12 +44,17 @@ public:
 	template<typename T>
 	class Registrar : public Base {
 	public:
-		TypeId GetTypeId() const override { return TypeInfo<Base>::template GetTypeId<T>(); }
-		std::string GetTypeName() const override { return name; }
+		TypeId GetTypeId() const override {
+			// Subclasses of T that are not registrars themselves get the ID of their own type, so they are never mistaken for T.
+			if (typeid(*this) == typeid(T))
+				return TypeInfo<Base>::template GetTypeId<T>();
+			return TypeInfo<Base>::GetTypeId(typeid(*this));
+		}
+		std::string GetTypeName() const override { return Name(); }
 
 	protected:
 		static bool Register(const std::string &name) {
-			Registrar::name = name;
+			Name() = name;
 			StreamFactory::Registry()[name] = [](Args... args) -> TCreateReturn {
 				return std::make_unique<T>(std::forward<Args>(args)...);
 			};
@@ -61,11 +66,15 @@ public:
 		}
 		
 		Node &Write(Node &node) const override {
-			node["type"].Set(name);
+			node["type"].Set(Name());
 			return node << *dynamic_cast<const T *>(this);
 		}
 
-		inline static std::string name;
+		// A function local, a static member of a class template may be initialized after the registration that sets it.
+		static std::string &Name() {
+			static std::string name;
+			return name;
+		}
 	};
 
 	friend inline const Node &operator>>(const Node &node, std::unique_ptr<Base> &object) {
@@ -75,9 +84,20 @@ public:
 		return node;
 	}
 
-	virtual TypeId GetTypeId() const { return -1; }
+	/**
+	 * Gets the type ID of the dynamic type of this object, types that are not registrars are given a ID the first time they are seen.
+	 * @return The type ID.
+	 */
+	virtual TypeId GetTypeId() const { return TypeInfo<Base>::GetTypeId(typeid(*this)); }
 	virtual std::string GetTypeName() const { return ""; }
 
+	/**
+	 * Creates a copy of this object that is not attached to anything, used to instantiate prefabs and capture snapshots without decoding again.
+	 * Types that are cheap and safe to copy override this, otherwise copies are decoded from a node.
+	 * @return The copy, or null if the object is not copied.
+	 */
+	virtual TCreateReturn Clone() const { return nullptr; }
+
 	friend const Node &operator>>(const Node &node, Base &base) {
 		return base.Load(node);
 	}
@@ -1,5 +1,7 @@
 #include "ThreadPool.hpp"
 
+#include "Engine/Profiler.hpp"
+
 namespace acid {
 ThreadPool::ThreadPool(uint32_t threadCount) {
 	m_workers.reserve(threadCount);
@@ -22,6 +24,7 @@ ThreadPool::ThreadPool(uint32_t threadCount) {
 					m_tasks.pop();
 				}
 
+				ACID_PROFILE_SCOPE("ThreadPool Task");
 				task();
 			}
 		});
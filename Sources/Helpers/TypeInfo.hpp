@@ -1,5 +1,6 @@
 #pragma once
 
+#include <mutex>
 #include <typeindex>
 
 #include "StdAfx.hpp"
@@ -14,12 +15,33 @@ public:
 
 	/**
 	 * Get the type ID of K which is a base of T.
+	 * The ID is looked up once per type and cached, later calls only read a static.
 	 * @tparam K The type ID K.
 	 * @return The type ID.
 	 */
 	template<typename K>
 	static TypeId GetTypeId() noexcept {
-		auto typeIndex = std::type_index(typeid(K));
+		static const TypeId id = FindTypeId(std::type_index(typeid(K)));
+		return id;
+	}
+
+	/**
+	 * Get the type ID of a type only known at runtime, such as the dynamic type of a object.
+	 * @param typeIndex The type.
+	 * @return The type ID.
+	 */
+	static TypeId GetTypeId(const std::type_index &typeIndex) noexcept {
+		return FindTypeId(typeIndex);
+	}
+
+private:
+	/**
+	 * Finds or assigns the ID of a type, the map keeps IDs the same across modules that each cache their own copy.
+	 * @param typeIndex The type.
+	 * @return The type ID.
+	 */
+	static TypeId FindTypeId(const std::type_index &typeIndex) noexcept {
+		std::lock_guard<std::mutex> lock(m_mutex);
 		if (auto it = m_typeMap.find(typeIndex); it != m_typeMap.end())
 			return it->second;
 		const auto id = NextTypeId();
@@ -27,7 +49,6 @@ public:
 		return id;
 	}
 
-private:
 	/**
 	 * Get the next type ID for T
 	 * @return The next type ID for T.
@@ -41,6 +62,7 @@ private:
 	// Next type ID for T.
 	static TypeId m_nextTypeId;
 	static std::unordered_map<std::type_index, TypeId> m_typeMap;
+	static std::mutex m_mutex;
 };
 
 template<typename K>
@@ -48,4 +70,7 @@ TypeId TypeInfo<K>::m_nextTypeId = 0;
 
 template<typename K>
 std::unordered_map<std::type_index, TypeId> TypeInfo<K>::m_typeMap = {};
+
+template<typename K>
+std::mutex TypeInfo<K>::m_mutex;
 }
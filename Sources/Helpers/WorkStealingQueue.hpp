@@ -0,0 +1,113 @@
+#pragma once
+
+#include <atomic>
+#include "NonCopyable.hpp"
+
+namespace acid {
+/**
+ * @brief A fixed size lock-free Chase-Lev deque of pointers. The owning thread pushes and pops from the bottom, any other thread may steal from the top.
+ * @tparam T The pointed to type to hold.
+ * @tparam Capacity The maximum number of items, must be a power of two.
+ */
+template<typename T, std::size_t Capacity>
+class WorkStealingQueue : public virtual NonCopyable {
+	static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "WorkStealingQueue capacity must be a power of two");
+public:
+	WorkStealingQueue() {
+		for (auto &item : m_items) {
+			item.store(nullptr, std::memory_order_relaxed);
+		}
+	}
+
+	/**
+	 * Pushes a item onto the bottom of the queue, may only be called by the owning thread.
+	 * @param item The item to push.
+	 * @return If the item was pushed, false if the queue is full.
+	 */
+	bool Push(T *item) {
+		auto bottom = m_bottom.load(std::memory_order_relaxed);
+		auto top = m_top.load(std::memory_order_acquire);
+
+		if (bottom - top >= static_cast<int64_t>(Capacity)) {
+			return false;
+		}
+
+		m_items[bottom & Mask].store(item, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+		m_bottom.store(bottom + 1, std::memory_order_relaxed);
+		return true;
+	}
+
+	/**
+	 * Pops the most recently pushed item from the bottom of the queue, may only be called by the owning thread.
+	 * @return The popped item, or nullptr if the queue is empty.
+	 */
+	T *Pop() {
+		auto bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+		m_bottom.store(bottom, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		auto top = m_top.load(std::memory_order_relaxed);
+
+		if (top > bottom) {
+			m_bottom.store(bottom + 1, std::memory_order_relaxed);
+			return nullptr;
+		}
+
+		auto item = m_items[bottom & Mask].load(std::memory_order_relaxed);
+
+		if (top == bottom) {
+			// Last item, race against any thieves for it.
+			if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+				item = nullptr;
+			}
+
+			m_bottom.store(bottom + 1, std::memory_order_relaxed);
+		}
+
+		return item;
+	}
+
+	/**
+	 * Steals the oldest item from the top of the queue, may be called from any thread.
+	 * @return The stolen item, or nullptr if the queue is empty or another thread won the race.
+	 */
+	T *Steal() {
+		auto top = m_top.load(std::memory_order_acquire);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		auto bottom = m_bottom.load(std::memory_order_acquire);
+
+		if (top >= bottom) {
+			return nullptr;
+		}
+
+		auto item = m_items[top & Mask].load(std::memory_order_relaxed);
+
+		if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+			return nullptr;
+		}
+
+		return item;
+	}
+
+	/**
+	 * Gets a approximate count of items in the queue.
+	 * @return The approximate size.
+	 */
+	std::size_t size() const {
+		auto bottom = m_bottom.load(std::memory_order_relaxed);
+		auto top = m_top.load(std::memory_order_relaxed);
+		return bottom > top ? static_cast<std::size_t>(bottom - top) : 0;
+	}
+
+	bool empty() const { return size() == 0; }
+	static constexpr std::size_t capacity() { return Capacity; }
+
+private:
+	static constexpr int64_t Mask = static_cast<int64_t>(Capacity) - 1;
+
+	// Top and bottom are kept on separate cache lines, thieves only ever touch the top.
+	alignas(64) std::atomic<int64_t> m_top = 0;
+	alignas(64) std::atomic<int64_t> m_bottom = 0;
+	alignas(64) std::array<std::atomic<T *>, Capacity> m_items;
+};
+}
@@ -6,6 +6,11 @@ bool AxisJoystick::registered = Register("axisJoystick");
 AxisJoystick::AxisJoystick(JoystickPort port, JoystickAxis axis) :
 	m_port(port),
 	m_axis(axis) {
+	// Headless engines have no input devices, the axis always reads zero.
+	if (!Joysticks::Get()) {
+		return;
+	}
+
 	Joysticks::Get()->OnAxis().Add([this](JoystickPort port, JoystickAxis axis, float value) {
 		if (port == m_port && axis == m_axis)
 			m_onAxis(GetAmount());
@@ -13,6 +18,10 @@ AxisJoystick::AxisJoystick(JoystickPort port, JoystickAxis axis) :
 }
 
 float AxisJoystick::GetAmount() const {
+	if (!Joysticks::Get()) {
+		return 0.0f;
+	}
+
 	return m_scale * Joysticks::Get()->GetAxis(m_port, m_axis);
 }
 
@@ -25,6 +34,10 @@ Axis::ArgumentDescription AxisJoystick::GetArgumentDescription() const {
 }
 
 bool AxisJoystick::IsConnected() const {
+	if (!Joysticks::Get()) {
+		return false;
+	}
+
 	return Joysticks::Get()->IsConnected(m_port);
 }
 
@@ -7,12 +7,21 @@ bool AxisMouse::registered = Register("axisMouse");
 
 AxisMouse::AxisMouse(uint8_t axis) :
 	m_axis(axis) {
+	// Headless engines have no input devices, the axis always reads zero.
+	if (!Mouse::Get()) {
+		return;
+	}
+
 	Mouse::Get()->OnPosition().Add([this](Vector2d value) {
 		m_onAxis(GetAmount());
 	}, this);
 }
 
 float AxisMouse::GetAmount() const {
+	if (!Mouse::Get()) {
+		return 0.0f;
+	}
+
 	return m_scale * static_cast<float>(Mouse::Get()->GetPositionDelta()[m_axis]);
 }
 
@@ -8,6 +8,11 @@ HatJoystick::HatJoystick(JoystickPort port, JoystickHat hat, const BitMask<Joyst
 	m_port(port),
 	m_hat(hat),
 	m_hatFlags(hatFlags) {
+	// Headless engines have no joysticks, the hat always reads centred.
+	if (!Joysticks::Get()) {
+		return;
+	}
+
 	Joysticks::Get()->OnHat().Add([this](JoystickPort port, JoystickHat hat, BitMask<JoystickHatValue> value) {
 		if (port == m_port && hat == m_hat) {
 			m_onAxis(GetAmount());
@@ -37,6 +42,10 @@ Axis::ArgumentDescription HatJoystick::GetArgumentDescription() const {
 }
 
 float HatJoystick::GetAmount() const {
+	if (!Joysticks::Get()) {
+		return 0.0f;
+	}
+
 	auto hat = Joysticks::Get()->GetHat(m_port, m_hat);
 	float value = 0.0f;
 	if (hat & JoystickHatValue::Up) {
@@ -63,6 +72,10 @@ float HatJoystick::GetAmount() const {
 }
 
 bool HatJoystick::IsDown() const {
+	if (!Joysticks::Get()) {
+		return false;
+	}
+
 	return (Joysticks::Get()->GetHat(m_port, m_hat) & m_hatFlags) ^ m_inverted;
 }
 
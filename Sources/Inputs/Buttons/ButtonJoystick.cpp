@@ -6,6 +6,11 @@ bool ButtonJoystick::registered = Register("buttonJoystick");
 ButtonJoystick::ButtonJoystick(JoystickPort port, JoystickButton button) :
 	m_port(port),
 	m_button(button) {
+	// Headless engines have no input devices, the button always reads as released.
+	if (!Joysticks::Get()) {
+		return;
+	}
+
 	Joysticks::Get()->OnButton().Add([this](JoystickPort port, JoystickButton button, InputAction action) {
 		if (port == m_port && button == m_button) {
 			m_onButton(action, 0);
@@ -14,6 +19,10 @@ ButtonJoystick::ButtonJoystick(JoystickPort port, JoystickButton button) :
 }
 
 bool ButtonJoystick::IsDown() const {
+	if (!Joysticks::Get()) {
+		return false;
+	}
+
 	return (Joysticks::Get()->GetButton(m_port, m_button) != InputAction::Release) ^ m_inverted;
 }
 
@@ -5,6 +5,11 @@ bool ButtonKeyboard::registered = Register("buttonKeyboard");
 
 ButtonKeyboard::ButtonKeyboard(Key key) :
 	m_key(key) {
+	// Headless engines have no input devices, the button always reads as released.
+	if (!Keyboard::Get()) {
+		return;
+	}
+
 	Keyboard::Get()->OnKey().Add([this](Key key, InputAction action, BitMask<InputMod> mods) {
 		if (key == m_key) {
 			m_onButton(action, mods);
@@ -13,6 +18,10 @@ ButtonKeyboard::ButtonKeyboard(Key key) :
 }
 
 bool ButtonKeyboard::IsDown() const {
+	if (!Keyboard::Get()) {
+		return false;
+	}
+
 	return (Keyboard::Get()->GetKey(m_key) != InputAction::Release) ^ m_inverted;
 }
 
@@ -5,6 +5,11 @@ bool ButtonMouse::registered = Register("buttonMouse");
 
 ButtonMouse::ButtonMouse(MouseButton button) :
 	m_button(button) {
+	// Headless engines have no input devices, the button always reads as released.
+	if (!Mouse::Get()) {
+		return;
+	}
+
 	Mouse::Get()->OnButton().Add([this](MouseButton button, InputAction action, BitMask<InputMod> mods) {
 		if (button == m_button) {
 			m_onButton(action, mods);
@@ -13,6 +18,10 @@ ButtonMouse::ButtonMouse(MouseButton button) :
 }
 
 bool ButtonMouse::IsDown() const {
+	if (!Mouse::Get()) {
+		return false;
+	}
+
 	return (Mouse::Get()->GetButton(m_button) != InputAction::Release) ^ m_inverted;
 }
 
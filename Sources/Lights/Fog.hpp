@@ -23,6 +23,8 @@ public:
 	void Start() override;
 	void Update() override;
 
+	std::unique_ptr<Component> Clone() const override { return std::make_unique<Fog>(*this); }
+
 	const Colour &GetColour() const { return m_colour; }
 	void SetColour(const Colour &colour) { m_colour = colour; }
 
@@ -20,6 +20,8 @@ public:
 	void Start() override;
 	void Update() override;
 
+	std::unique_ptr<Component> Clone() const override { return std::make_unique<Light>(*this); }
+
 	const Colour &GetColour() const { return m_colour; }
 	void SetColour(const Colour &colour) { m_colour = colour; }
 
@@ -1,6 +1,7 @@
 #include "MaterialDefault.hpp"
 
 #include "Animations/MeshAnimated.hpp"
+#include "Engine/Engine.hpp"
 #include "Maths/Transform.hpp"
 
 namespace acid {
@@ -29,7 +30,7 @@ void MaterialDefault::CreatePipeline(const Shader::VertexInput &vertexInput, boo
 
 void MaterialDefault::PushUniforms(UniformHandler &uniformObject, const Transform *transform) {
 	if (transform)
-		uniformObject.Push("transform", transform->GetWorldMatrix());
+		uniformObject.Push("transform", transform->GetInterpolatedWorldMatrix(Engine::Get()->GetAlpha()));
 	
 	uniformObject.Push("baseDiffuse", m_baseDiffuse);
 	uniformObject.Push("metallic", m_metallic);
@@ -14,6 +14,8 @@ public:
 		float roughness = 0.0f, std::shared_ptr<Image2d> imageMaterial = nullptr, std::shared_ptr<Image2d> imageNormal = nullptr, bool castsShadows = true,
 		bool ignoreLighting = false, bool ignoreFog = false);
 
+	std::unique_ptr<Material> Clone() const override { return std::make_unique<MaterialDefault>(*this); }
+
 	void CreatePipeline(const Shader::VertexInput &vertexInput, bool animated) override;
 	void PushUniforms(UniformHandler &uniformObject, const Transform *transform) override;
 	void PushDescriptors(DescriptorsHandler &descriptorSet) override;
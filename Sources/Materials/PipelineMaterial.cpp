@@ -5,12 +5,16 @@
 
 namespace acid {
 std::shared_ptr<PipelineMaterial> PipelineMaterial::Create(const Node &node) {
-	if (auto resource = Resources::Get()->Find(node)) {
-		return std::dynamic_pointer_cast<PipelineMaterial>(resource);
+	if (auto resource = Resources::Get()->Find<PipelineMaterial>(node)) {
+		return resource;
 	}
 
 	auto result = std::make_shared<PipelineMaterial>();
-	Resources::Get()->Add(node, std::dynamic_pointer_cast<Resource>(result));
+
+	if (auto resource = Resources::Get()->FindOrAdd(node, result); resource != result) {
+		return resource;
+	}
+
 	node >> *result;
 	//result->Load();
 	return result;
@@ -37,13 +41,45 @@ bool PipelineMaterial::BindPipeline(const CommandBuffer &commandBuffer) {
 
 	if (m_renderStage != renderStage) {
 		m_renderStage = renderStage;
+		// Frames in flight may still be drawing with the previous pipeline.
+		Graphics::Get()->DestroyDeferred(std::move(m_pipeline));
 		m_pipeline.reset(m_pipelineCreate.Create(m_pipelineStage));
+		AddDependencies();
 	}
 
 	m_pipeline->BindPipeline(commandBuffer);
 	return true;
 }
 
+void PipelineMaterial::Reload() {
+	// Pipelines that have not been bound compile the changed shaders when they are first bound.
+	if (!m_pipeline) {
+		return;
+	}
+
+	// Built before the old pipeline is replaced, so a failed build leaves the material as it was.
+	std::unique_ptr<PipelineGraphics> pipeline(m_pipelineCreate.Create(m_pipelineStage));
+	Graphics::Get()->DestroyDeferred(std::move(m_pipeline));
+	m_pipeline = std::move(pipeline);
+	AddDependencies();
+}
+
+void PipelineMaterial::AddDependencies() {
+	auto resources = Resources::Get();
+
+	if (!resources) {
+		return;
+	}
+
+	for (const auto &stage : m_pipeline->GetShader()->GetStages()) {
+		resources->AddDependency(*this, stage);
+	}
+
+	for (const auto &include : m_pipeline->GetShader()->GetIncludes()) {
+		resources->AddDependency(*this, include);
+	}
+}
+
 const Node &operator>>(const Node &node, PipelineMaterial &pipeline) {
 	node["renderpass"].Get(pipeline.m_pipelineStage.first);
 	node["subpass"].Get(pipeline.m_pipelineStage.second);
@@ -38,6 +38,11 @@ public:
 	 */
 	bool BindPipeline(const CommandBuffer &commandBuffer);
 
+	/**
+	 * Rebuilds the pipeline from its changed shaders, if it has been created. If building the new pipeline throws the old pipeline is kept.
+	 */
+	void Reload() override;
+
 	const Pipeline::Stage &GetStage() const { return m_pipelineStage; }
 	const PipelineGraphicsCreate &GetPipelineCreate() const { return m_pipelineCreate; }
 	const PipelineGraphics *GetPipeline() { return m_pipeline.get(); }
@@ -46,6 +51,11 @@ public:
 	friend Node &operator<<(Node &node, const PipelineMaterial &pipeline);
 
 private:
+	/**
+	 * Adds the shader stages and their includes as dependencies, so this pipeline is rebuilt when one changes.
+	 */
+	void AddDependencies();
+
 	Pipeline::Stage m_pipelineStage;
 	PipelineGraphicsCreate m_pipelineCreate;
 	const RenderStage *m_renderStage = nullptr;
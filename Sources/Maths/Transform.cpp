@@ -11,49 +11,125 @@ Transform::Transform(const Vector3f &position, const Vector3f &rotation, const V
 	m_scale(scale) {
 }
 
-Transform::~Transform() {
-	delete m_worldTransform;
+Transform::Transform(const Transform &other) :
+	Transform(other.m_position, other.m_rotation, other.m_scale) {
+	m_localMin = other.m_localMin;
+	m_localMax = other.m_localMax;
+}
 
+Transform::~Transform() {
 	if (m_parent) {
 		m_parent->RemoveChild(this);
 	}
 
 	for (auto &child : m_children) {
 		child->m_parent = nullptr;
+		child->SetDirty();
 	}
 }
 
+Transform &Transform::operator=(const Transform &other) {
+	m_position = other.m_position;
+	m_rotation = other.m_rotation;
+	m_scale = other.m_scale;
+	m_localMin = other.m_localMin;
+	m_localMax = other.m_localMax;
+	SetDirty();
+	return *this;
+}
+
 Transform Transform::Multiply(const Transform &other) const {
 	return {Vector3f(GetWorldMatrix().Transform(Vector4f(other.m_position))), m_rotation + other.m_rotation, m_scale * other.m_scale};
 }
 
-Matrix4 Transform::GetWorldMatrix() const {
-	auto worldTransform = GetWorldTransform();
-	return Matrix4::TransformationMatrix(worldTransform->m_position, worldTransform->m_rotation, worldTransform->m_scale);
+const Matrix4 &Transform::GetWorldMatrix() const {
+	UpdateWorld();
+	return m_worldMatrix;
 }
 
-Vector3f Transform::GetPosition() const {
-	return GetWorldTransform()->m_position;
+const Vector3f &Transform::GetPosition() const {
+	UpdateWorld();
+	return m_worldPosition;
+}
+
+const Vector3f &Transform::GetRotation() const {
+	UpdateWorld();
+	return m_worldRotation;
+}
+
+const Vector3f &Transform::GetScale() const {
+	UpdateWorld();
+	return m_worldScale;
+}
+
+const Vector3f &Transform::GetWorldMin() const {
+	UpdateWorld();
+	return m_worldMin;
+}
+
+const Vector3f &Transform::GetWorldMax() const {
+	UpdateWorld();
+	return m_worldMax;
+}
+
+void Transform::UpdateHierarchy() {
+	UpdateWorld();
+
+	for (auto &child : m_children) {
+		if (child->m_dirty) {
+			child->UpdateHierarchy();
+		}
+	}
 }
 
-Vector3f Transform::GetRotation() const {
-	return GetWorldTransform()->m_rotation;
+const Matrix4 &Transform::GetInterpolatedWorldMatrix(float alpha) const {
+	UpdateWorld();
+
+	if (alpha >= 1.0f || !m_snapshot) {
+		return m_worldMatrix;
+	}
+
+	if (alpha == m_interpolatedAlpha && m_version == m_interpolatedVersion) {
+		return m_interpolatedMatrix;
+	}
+
+	// Euler angles are blended as quaternions, so 359 degrees to 1 degree turns through 0 rather than the long way round.
+	auto rotation = m_snapshotRotation.Slerp(Quaternion(Matrix4::TransformationMatrix({}, m_worldRotation, Vector3f(1.0f))), alpha);
+	m_interpolatedMatrix = Matrix4().Translate(m_snapshotPosition.Lerp(m_worldPosition, alpha)).Multiply(rotation.ToRotationMatrix())
+		.Scale(m_snapshotScale.Lerp(m_worldScale, alpha));
+	m_interpolatedAlpha = alpha;
+	m_interpolatedVersion = m_version;
+	return m_interpolatedMatrix;
 }
 
-Vector3f Transform::GetScale() const {
-	return GetWorldTransform()->m_scale;
+void Transform::StoreSnapshot() {
+	UpdateWorld();
+	m_snapshot = true;
+	m_snapshotPosition = m_worldPosition;
+	m_snapshotRotation = Quaternion(Matrix4::TransformationMatrix({}, m_worldRotation, Vector3f(1.0f)));
+	m_snapshotScale = m_worldScale;
+	m_interpolatedAlpha = -1.0f;
 }
 
 void Transform::SetLocalPosition(const Vector3f &localPosition) {
 	m_position = localPosition;
+	SetDirty();
 }
 
 void Transform::SetLocalRotation(const Vector3f &localRotation) {
 	m_rotation = localRotation;
+	SetDirty();
 }
 
 void Transform::SetLocalScale(const Vector3f &localScale) {
 	m_scale = localScale;
+	SetDirty();
+}
+
+void Transform::SetLocalBounds(const Vector3f &min, const Vector3f &max) {
+	m_localMin = min;
+	m_localMax = max;
+	SetDirty();
 }
 
 void Transform::SetParent(Transform *parent) {
@@ -66,6 +142,8 @@ void Transform::SetParent(Transform *parent) {
 	if (m_parent) {
 		m_parent->AddChild(this);
 	}
+
+	SetDirty();
 }
 
 void Transform::SetParent(Entity *parent) {
@@ -92,6 +170,7 @@ const Node &operator>>(const Node &node, Transform &transform) {
 	node["position"].Get(transform.m_position);
 	node["rotation"].Get(transform.m_rotation);
 	node["scale"].Get(transform.m_scale);
+	transform.SetDirty();
 	return node;
 }
 
@@ -106,22 +185,52 @@ std::ostream &operator<<(std::ostream &stream, const Transform &transform) {
 	return stream << transform.m_position << ", " << transform.m_rotation << ", " << transform.m_scale;
 }
 
-const Transform *Transform::GetWorldTransform() const {
+void Transform::UpdateWorld() const {
+	if (!m_dirty) {
+		return;
+	}
+
 	if (!m_parent) {
-		if (m_worldTransform) {
-			delete m_worldTransform;
-			m_worldTransform = nullptr;
-		}
+		m_worldPosition = m_position;
+		m_worldRotation = m_rotation;
+		m_worldScale = m_scale;
+	} else {
+		m_parent->UpdateWorld();
+
+		// Combines with the parent the same way as Multiply.
+		m_worldPosition = Vector3f(m_parent->m_worldMatrix.Transform(Vector4f(m_position)));
+		m_worldRotation = m_parent->m_worldRotation + m_rotation;
+		m_worldScale = m_parent->m_worldScale * m_scale;
+	}
+
+	m_worldMatrix = Matrix4::TransformationMatrix(m_worldPosition, m_worldRotation, m_worldScale);
 
-		return this;
+	// Transforms the centre of the local box, each half extent of the new box is the sum of the absolute axes scaled by the old half extents.
+	auto centre = Vector3f(m_worldMatrix.Transform(Vector4f((m_localMin + m_localMax) * 0.5f)));
+	auto halfExtents = (m_localMax - m_localMin) * 0.5f;
+	Vector3f worldHalfExtents;
+
+	for (uint32_t i = 0; i < 3; i++) {
+		worldHalfExtents[i] = std::abs(m_worldMatrix[0][i]) * halfExtents.m_x + std::abs(m_worldMatrix[1][i]) * halfExtents.m_y +
+			std::abs(m_worldMatrix[2][i]) * halfExtents.m_z;
 	}
 
-	if (!m_worldTransform) {
-		m_worldTransform = new Transform();
+	m_worldMin = centre - worldHalfExtents;
+	m_worldMax = centre + worldHalfExtents;
+	m_version++;
+	m_dirty = false;
+}
+
+void Transform::SetDirty() {
+	if (m_dirty) {
+		return;
 	}
 
-	*m_worldTransform = *m_parent->GetWorldTransform() * *this;
-	return m_worldTransform;
+	m_dirty = true;
+
+	for (auto &child : m_children) {
+		child->SetDirty();
+	}
 }
 
 void Transform::AddChild(Transform *child) {
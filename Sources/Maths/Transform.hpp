@@ -1,12 +1,15 @@
 ﻿#pragma once
 
 #include "Matrix4.hpp"
+#include "Quaternion.hpp"
 #include "Vector3.hpp"
 #include "Scenes/Component.hpp"
 
 namespace acid {
 /**
  * @brief Holds position, rotation, and scale components.
+ * The world position, rotation, scale, and matrix are cached. Changing a transform marks it and every transform below it dirty,
+ * dirty transforms are recomputed parents first, either lazily when read or by {@link Transform#UpdateHierarchy} once per frame.
  */
 class ACID_EXPORT Transform : public Component::Registrar<Transform> {
 public:
@@ -18,8 +21,23 @@ public:
 	 */
 	Transform(const Vector3f &position = {}, const Vector3f &rotation = {}, const Vector3f &scale = Vector3f(1.0f));
 
+	/**
+	 * Copies the local position, rotation, and scale, the copy has no parent or children.
+	 * @param other The transform to copy.
+	 */
+	Transform(const Transform &other);
+
 	~Transform();
 
+	/**
+	 * Sets the local position, rotation, and scale from another transform, keeping this transforms parent and children.
+	 * @param other The transform to copy.
+	 * @return This transform.
+	 */
+	Transform &operator=(const Transform &other);
+
+	std::unique_ptr<Component> Clone() const override { return std::make_unique<Transform>(*this); }
+
 	/**
 	 * Multiplies this transform with another transform.
 	 * @param other The other transform.
@@ -27,10 +45,54 @@ public:
 	 */
 	Transform Multiply(const Transform &other) const;
 
-	Matrix4 GetWorldMatrix() const;
-	Vector3f GetPosition() const;
-	Vector3f GetRotation() const;
-	Vector3f GetScale() const;
+	const Matrix4 &GetWorldMatrix() const;
+	const Vector3f &GetPosition() const;
+	const Vector3f &GetRotation() const;
+	const Vector3f &GetScale() const;
+
+	/**
+	 * Gets the world space box around the local bounds, see {@link Transform#SetLocalBounds}.
+	 * @return The minimum corner of the box.
+	 */
+	const Vector3f &GetWorldMin() const;
+
+	/**
+	 * Gets the world space box around the local bounds, see {@link Transform#SetLocalBounds}.
+	 * @return The maximum corner of the box.
+	 */
+	const Vector3f &GetWorldMax() const;
+
+	/**
+	 * Gets a number that changes each time the cached world transform is recomputed.
+	 * @return The version.
+	 */
+	uint32_t GetVersion() const { return m_version; }
+
+	/**
+	 * Gets if the cached world transform needs to be recomputed.
+	 * @return If the transform is dirty.
+	 */
+	bool IsDirty() const { return m_dirty; }
+
+	/**
+	 * Recomputes the cached world transform of this transform and every transform below it, parents before children.
+	 * The parent must not be dirty, or this must have no parent. Separate subtrees can be updated on different threads.
+	 */
+	void UpdateHierarchy();
+
+	/**
+	 * Gets the world matrix blended between the last snapshot and the current transform, used to render between fixed steps.
+	 * Rotation is blended along the shortest arc. The matrix is cached until the alpha, the snapshot, or the world transform changes,
+	 * so every renderer of a transform in a frame shares one blend.
+	 * @param alpha How far to blend from the snapshot to the current transform, from 0 to 1.
+	 * @return The interpolated world matrix.
+	 */
+	const Matrix4 &GetInterpolatedWorldMatrix(float alpha) const;
+
+	/**
+	 * Stores the current world position, rotation, and scale to interpolate from, called before each fixed step.
+	 */
+	void StoreSnapshot();
 
 	const Vector3f &GetLocalPosition() const { return m_position; }
 	void SetLocalPosition(const Vector3f &localPosition);
@@ -41,6 +103,17 @@ public:
 	const Vector3f &GetLocalScale() const { return m_scale; }
 	void SetLocalScale(const Vector3f &localScale);
 
+	const Vector3f &GetLocalMin() const { return m_localMin; }
+	const Vector3f &GetLocalMax() const { return m_localMax; }
+
+	/**
+	 * Sets the local space box around what is attached to this transform, used to place the entity in the structure's spatial index.
+	 * Meshes set this from their model extents, by default the box is the transform's origin.
+	 * @param min The minimum corner of the box.
+	 * @param max The maximum corner of the box.
+	 */
+	void SetLocalBounds(const Vector3f &min, const Vector3f &max);
+
 	Transform *GetParent() const { return m_parent; }
 	void SetParent(Transform *parent);
 	void SetParent(Entity *parent);
@@ -59,7 +132,15 @@ public:
 	friend std::ostream &operator<<(std::ostream &stream, const Transform &transform);
 
 private:
-	const Transform *GetWorldTransform() const;
+	/**
+	 * Recomputes the cached world transform if it is dirty, after recomputing any dirty parents.
+	 */
+	void UpdateWorld() const;
+
+	/**
+	 * Marks this transform and every transform below it dirty.
+	 */
+	void SetDirty();
 
 	void AddChild(Transform *child);
 	void RemoveChild(Transform *child);
@@ -69,9 +150,30 @@ private:
 	Vector3f m_position;
 	Vector3f m_rotation;
 	Vector3f m_scale;
+	Vector3f m_localMin;
+	Vector3f m_localMax;
+
+	// The world transform before the last fixed step, blending in world space never walks up the hierarchy.
+	bool m_snapshot = false;
+	Vector3f m_snapshotPosition;
+	Quaternion m_snapshotRotation;
+	Vector3f m_snapshotScale;
 
 	Transform *m_parent = nullptr;
 	std::vector<Transform *> m_children;
-	mutable Transform *m_worldTransform = nullptr;
+
+	// If dirty then every transform below this is dirty too, so marking can stop at a transform that is already dirty.
+	mutable bool m_dirty = true;
+	mutable Vector3f m_worldPosition;
+	mutable Vector3f m_worldRotation;
+	mutable Vector3f m_worldScale;
+	mutable Matrix4 m_worldMatrix;
+	mutable Vector3f m_worldMin;
+	mutable Vector3f m_worldMax;
+	mutable uint32_t m_version = 0;
+	// The alpha and world version the interpolated matrix was blended for, a negative alpha when there is none.
+	mutable float m_interpolatedAlpha = -1.0f;
+	mutable uint32_t m_interpolatedVersion = 0;
+	mutable Matrix4 m_interpolatedMatrix;
 };
 }
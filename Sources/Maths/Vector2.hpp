@@ -200,7 +200,7 @@ public:
 	 * @return The lowest vector.
 	 **/
 	template<typename K>
-	constexpr auto Min(const Vector2<K> &other);
+	constexpr auto Min(const Vector2<K> &other) const;
 
 	/**
 	 * Gets the maximum vector size between this vector and other.
@@ -209,7 +209,7 @@ public:
 	 * @return The maximum vector.
 	 **/
 	template<typename K>
-	constexpr auto Max(const Vector2<K> &other);
+	constexpr auto Max(const Vector2<K> &other) const;
 
 	/**
 	 * Gets the distance between this vector and another vector.
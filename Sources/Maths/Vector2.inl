@@ -153,13 +153,13 @@ constexpr auto Vector2<T>::MinMax() const {
 
 template<typename T>
 template<typename K>
-constexpr auto Vector2<T>::Min(const Vector2<K> &other) {
+constexpr auto Vector2<T>::Min(const Vector2<K> &other) const {
 	return Vector2<decltype(std::min(m_x, other.m_x))>(std::min(m_x, other.m_x), std::min(m_y, other.m_y));
 }
 
 template<typename T>
 template<typename K>
-constexpr auto Vector2<T>::Max(const Vector2<K> &other) {
+constexpr auto Vector2<T>::Max(const Vector2<K> &other) const {
 	return Vector2<decltype(std::max(m_x, other.m_x))>(std::max(m_x, other.m_x), std::max(m_y, other.m_y));
 }
 
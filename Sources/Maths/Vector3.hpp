@@ -214,7 +214,7 @@ public:
 	 * @return The lowest vector.
 	 **/
 	template<typename K>
-	constexpr auto Min(const Vector3<K> &other);
+	constexpr auto Min(const Vector3<K> &other) const;
 
 	/**
 	 * Gets the maximum vector size between this vector and other.
@@ -223,7 +223,7 @@ public:
 	 * @return The maximum vector.
 	 **/
 	template<typename K>
-	constexpr auto Max(const Vector3<K> &other);
+	constexpr auto Max(const Vector3<K> &other) const;
 
 	/**
 	 * Gets the distance between this vector and another vector.
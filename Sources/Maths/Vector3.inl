@@ -166,13 +166,13 @@ constexpr auto Vector3<T>::MinMax() const {
 
 template<typename T>
 template<typename K>
-constexpr auto Vector3<T>::Min(const Vector3<K> &other) {
+constexpr auto Vector3<T>::Min(const Vector3<K> &other) const {
 	return Vector3<decltype(std::min(m_x, other.m_x))>(std::min(m_x, other.m_x), std::min(m_y, other.m_y), std::min(m_z, other.m_z));
 }
 
 template<typename T>
 template<typename K>
-constexpr auto Vector3<T>::Max(const Vector3<K> &other) {
+constexpr auto Vector3<T>::Max(const Vector3<K> &other) const {
 	return Vector3<decltype(std::max(m_x, other.m_x))>(std::max(m_x, other.m_x), std::max(m_y, other.m_y), std::max(m_z, other.m_z));
 }
 
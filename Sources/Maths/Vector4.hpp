@@ -201,7 +201,7 @@ public:
 	 * @return The lowest vector.
 	 **/
 	template<typename K>
-	constexpr auto Min(const Vector4<K> &other);
+	constexpr auto Min(const Vector4<K> &other) const;
 
 	/**
 	 * Gets the maximum vector size between this vector and other.
@@ -210,7 +210,7 @@ public:
 	 * @return The maximum vector.
 	 **/
 	template<typename K>
-	constexpr auto Max(const Vector4<K> &other);
+	constexpr auto Max(const Vector4<K> &other) const;
 
 	/**
 	 * Gets the distance between this vector and another vector.
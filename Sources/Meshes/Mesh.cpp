@@ -12,14 +12,32 @@ Mesh::Mesh(std::shared_ptr<Model> model, std::unique_ptr<Material> &&material) :
 	m_material(std::move(material)) {
 }
 
+std::unique_ptr<Component> Mesh::Clone() const {
+	std::unique_ptr<Material> material;
+
+	if (m_material && !(material = m_material->Clone())) {
+		return nullptr;
+	}
+
+	auto mesh = std::make_unique<Mesh>(m_model, std::move(material));
+	mesh->SetEnabled(IsEnabled());
+	return mesh;
+}
+
 void Mesh::Start() {
 	if (m_material)
 		m_material->CreatePipeline(GetVertexInput(), false);
 }
 
 void Mesh::Update() {
+	auto transform = GetEntity()->GetComponent<Transform>();
+
+	// Keeps the transform's bounds around the model, for the structure's spatial tree and culling.
+	if (transform && m_model && (transform->GetLocalMin() != m_model->GetMinExtents() || transform->GetLocalMax() != m_model->GetMaxExtents())) {
+		transform->SetLocalBounds(m_model->GetMinExtents(), m_model->GetMaxExtents());
+	}
+
 	if (m_material) {
-		auto transform = GetEntity()->GetComponent<Transform>();
 		m_material->PushUniforms(m_uniformObject, transform);
 	}
 }
@@ -32,6 +50,9 @@ bool Mesh::CmdRender(const CommandBuffer &commandBuffer, UniformHandler &uniform
 	if (auto rigidbody = GetEntity()->GetComponent<Rigidbody>()) {
 		if (!rigidbody->InFrustum(Scenes::Get()->GetCamera()->GetViewFrustum()))
 			return false;
+	} else if (auto transform = GetEntity()->GetComponent<Transform>()) {
+		if (!Scenes::Get()->GetCamera()->GetViewFrustum().CubeInFrustum(transform->GetWorldMin(), transform->GetWorldMax()))
+			return false;
 	}
 
 	// Check if we are in the correct pipeline stage.
@@ -18,6 +18,8 @@ public:
 	 */
 	explicit Mesh(std::shared_ptr<Model> model = nullptr, std::unique_ptr<Material> &&material = nullptr);
 
+	std::unique_ptr<Component> Clone() const override;
+
 	void Start() override;
 	void Update() override;
 
@@ -17,20 +17,32 @@ void SubrenderMeshes::Render(const CommandBuffer &commandBuffer) {
 	m_uniformScene.Push("view", camera->GetViewMatrix());
 	m_uniformScene.Push("cameraPos", camera->GetPosition());
 
-	auto meshes = Scenes::Get()->GetStructure()->QueryComponents<Mesh>();
-	if (m_sort == Sort::Front)
-		std::sort(meshes.begin(), meshes.end(), std::greater<>());
-	else if (m_sort == Sort::Back)
-		std::sort(meshes.begin(), meshes.end(), std::less<>());
-
-	for (const auto &mesh : meshes) {
-		mesh->CmdRender(commandBuffer, m_uniformScene, GetStage());
+	auto &meshView = Scenes::Get()->GetStructure()->GetView<Mesh>();
+
+	if (m_sort == Sort::None) {
+		meshView.ForEach([&](Mesh &mesh) {
+			mesh.CmdRender(commandBuffer, m_uniformScene, GetStage());
+		});
+	} else {
+		std::pmr::vector<Mesh *> meshes(&FrameAllocator::Get());
+		meshes.reserve(meshView.GetSize());
+		meshView.ForEach([&meshes](Mesh &mesh) {
+			meshes.emplace_back(&mesh);
+		});
+
+		if (m_sort == Sort::Front)
+			std::sort(meshes.begin(), meshes.end(), [](Mesh *a, Mesh *b) { return *a > *b; });
+		else
+			std::sort(meshes.begin(), meshes.end(), [](Mesh *a, Mesh *b) { return *a < *b; });
+
+		for (const auto &mesh : meshes) {
+			mesh->CmdRender(commandBuffer, m_uniformScene, GetStage());
+		}
 	}
 
 	// TODO: Split animated meshes into it's own subrender.
-	auto animatedMeshes = Scenes::Get()->GetStructure()->QueryComponents<MeshAnimated>();
-	for (const auto &animatedMesh : animatedMeshes) {
-		animatedMesh->CmdRender(commandBuffer, m_uniformScene, GetStage());
-	}
+	Scenes::Get()->GetStructure()->ForEach<MeshAnimated>([&](MeshAnimated &animatedMesh) {
+		animatedMesh.CmdRender(commandBuffer, m_uniformScene, GetStage());
+	});
 }
 }
@@ -6,6 +6,7 @@
 #include "tiny_gltf.h"
 
 #include "Files/Files.hpp"
+#include "Graphics/Graphics.hpp"
 #include "Resources/Resources.hpp"
 #include "Models/Vertex3d.hpp"
 
@@ -13,12 +14,16 @@ namespace acid {
 bool ModelGltf::registered = Register("gltf", ".gltf");
 
 std::shared_ptr<ModelGltf> ModelGltf::Create(const Node &node) {
-	if (auto resource = Resources::Get()->Find(node)) {
-		return std::dynamic_pointer_cast<ModelGltf>(resource);
+	if (auto resource = Resources::Get()->Find<ModelGltf>(node)) {
+		return resource;
 	}
 
 	auto result = std::make_shared<ModelGltf>("");
-	Resources::Get()->Add(node, std::dynamic_pointer_cast<Resource>(result));
+
+	if (auto resource = Resources::Get()->FindOrAdd(node, result); resource != result) {
+		return resource;
+	}
+
 	node >> *result;
 	result->Load();
 	return result;
@@ -38,6 +43,15 @@ ModelGltf::ModelGltf(std::filesystem::path filename, bool load) :
 	}
 }
 
+void ModelGltf::Reload() {
+	// The buffers being replaced may still be used by a frame in flight.
+	if (auto graphics = Graphics::Get()) {
+		graphics->WaitIdle();
+	}
+
+	Load();
+}
+
 const Node &operator>>(const Node &node, ModelGltf &model) {
 	node["filename"].Get(model.m_filename);
 	return node;
@@ -49,6 +63,8 @@ Node &operator<<(Node &node, const ModelGltf &model) {
 }
 
 void ModelGltf::Load() {
+	ACID_PROFILE_SCOPE("ModelGltf::Load");
+
 	if (m_filename.empty()) {
 		return;
 	}
@@ -57,6 +73,10 @@ void ModelGltf::Load() {
 	auto debugStart = Time::Now();
 #endif
 
+	if (auto resources = Resources::Get()) {
+		resources->AddDependency(*this, m_filename);
+	}
+
 	auto folder = m_filename.parent_path();
 	auto fileLoaded = Files::Read(m_filename);
 
@@ -30,6 +30,11 @@ public:
 	 */
 	explicit ModelGltf(std::filesystem::path filename, bool load = true);
 
+	/**
+	 * Reloads this model from its file, replacing the buffers on the device.
+	 */
+	void Reload() override;
+
 	friend const Node &operator>>(const Node &node, ModelGltf &model);
 	friend Node &operator<<(Node &node, const ModelGltf &model);
 
@@ -1,9 +1,15 @@
 #include "Model.hpp"
 
+#include "Graphics/Graphics.hpp"
 #include "Scenes/Scenes.hpp"
 #include "Resources/Resources.hpp"
+#include "Models/Shapes/ModelCube.hpp"
 
 namespace acid {
+std::shared_ptr<Model> Model::CreatePlaceholder() {
+	return std::make_shared<ModelCube>(Vector3f(1.0f));
+}
+
 bool Model::CmdRender(const CommandBuffer &commandBuffer, uint32_t instances) const {
 	if (m_vertexBuffer && m_indexBuffer) {
 		VkBuffer vertexBuffers[1] = {m_vertexBuffer->GetBuffer()};
@@ -25,6 +31,20 @@ bool Model::CmdRender(const CommandBuffer &commandBuffer, uint32_t instances) co
 }
 
 std::vector<uint32_t> Model::GetIndices(std::size_t offset) const {
+	if (!m_indexData.empty()) {
+		std::vector<uint32_t> indices(m_indexCount);
+
+		for (uint32_t i = 0; i < m_indexCount; i++) {
+			std::memcpy(&indices[i], reinterpret_cast<const char *>(m_indexData.data()) + (i * sizeof(uint32_t)) + offset, sizeof(uint32_t));
+		}
+
+		return indices;
+	}
+
+	if (!m_indexBuffer) {
+		return {};
+	}
+
 	Buffer indexStaging(m_indexBuffer->GetSize(), VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
 		VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
 
@@ -52,10 +72,16 @@ std::vector<uint32_t> Model::GetIndices(std::size_t offset) const {
 
 void Model::SetIndices(const std::vector<uint32_t> &indices) {
 	m_indexBuffer = nullptr;
+	m_indexData.clear();
 	m_indexCount = static_cast<uint32_t>(indices.size());
 
 	if (indices.empty())
 		return;
+
+	if (!HasDevice()) {
+		m_indexData = indices;
+		return;
+	}
 	
 	Buffer indexStaging(sizeof(uint32_t) * indices.size(), VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
 		indices.data());
@@ -72,7 +98,7 @@ void Model::SetIndices(const std::vector<uint32_t> &indices) {
 }
 
 std::vector<float> Model::GetPointCloud() const {
-	if (!m_vertexBuffer) {
+	if (!m_vertexBuffer && m_vertexData.empty()) {
 		return {};
 	}
 
@@ -92,4 +118,8 @@ std::vector<float> Model::GetPointCloud() const {
 
 	return pointCloud;
 }
+
+bool Model::HasDevice() {
+	return Graphics::Get() != nullptr;
+}
 }
@@ -60,7 +60,7 @@ public:
 	protected:
 		template<int Dummy = 0>
 		static bool Register(const std::string &typeName) {
-			Registrar::name = typeName;
+			Name() = typeName;
 			ModelFactory::RegistryNode()[typeName] = [](const Node &node) -> TCreateReturn {
 				return T::Create(node);
 			};
@@ -81,11 +81,15 @@ public:
 		}
 
 		Node &Write(Node &node) const override {
-			node["type"].Set(name);
+			node["type"].Set(Name());
 			return node << *dynamic_cast<const T *>(this);
 		}
 
-		inline static std::string name;
+		// A function local, a static member of a class template may be initialized after the registration that sets it.
+		static std::string &Name() {
+			static std::string name;
+			return name;
+		}
 	};
 
 	friend const Node &operator>>(const Node &node, Base &base) {
@@ -105,6 +109,9 @@ protected:
  */
 class ACID_EXPORT Model : public ModelFactory<Model>, public Resource {
 public:
+	/// Every model format is counted in the budget of models in {@link Resources}.
+	using BudgetType = Model;
+
 	/**
 	 * Creates a new empty model.
 	 */
@@ -122,6 +129,12 @@ public:
 		Initialize(vertices, indices);
 	}
 
+	/**
+	 * Creates the model used while a model is loading, a unit cube.
+	 * @return The placeholder model.
+	 */
+	static std::shared_ptr<Model> CreatePlaceholder();
+
 	bool CmdRender(const CommandBuffer &commandBuffer, uint32_t instances = 1) const;
 
 	template<typename T>
@@ -151,8 +164,17 @@ protected:
 	void Initialize(const std::vector<T> &vertices, const std::vector<uint32_t> &indices = {});
 
 private:
+	/**
+	 * Gets if there is a graphics device to upload buffers to, headless engines keep the vertices and indices in memory instead.
+	 * @return If buffers can be created.
+	 */
+	static bool HasDevice();
+
 	std::unique_ptr<Buffer> m_vertexBuffer;
 	std::unique_ptr<Buffer> m_indexBuffer;
+	// Copies kept when there is no device, so headless engines can still read the model for collision shapes.
+	std::vector<std::byte> m_vertexData;
+	std::vector<uint32_t> m_indexData;
 	uint32_t m_vertexCount = 0;
 	uint32_t m_indexCount = 0;
 
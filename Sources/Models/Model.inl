@@ -5,6 +5,21 @@
 namespace acid {
 template<typename T>
 std::vector<T> Model::GetVertices(std::size_t offset) const {
+	if (!m_vertexData.empty()) {
+		std::vector<T> vertices(m_vertexCount);
+		auto sizeOfSrcT = m_vertexData.size() / m_vertexCount;
+
+		for (uint32_t i = 0; i < m_vertexCount; i++) {
+			std::memcpy(&vertices[i], m_vertexData.data() + (i * sizeOfSrcT) + offset, sizeof(T));
+		}
+
+		return vertices;
+	}
+
+	if (!m_vertexBuffer) {
+		return {};
+	}
+
 	Buffer vertexStaging(m_vertexBuffer->GetSize(), VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
 		VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
 
@@ -33,10 +48,17 @@ std::vector<T> Model::GetVertices(std::size_t offset) const {
 template<typename T>
 void Model::SetVertices(const std::vector<T> &vertices) {
 	m_vertexBuffer = nullptr;
+	m_vertexData.clear();
 	m_vertexCount = static_cast<uint32_t>(vertices.size());
 
 	if (vertices.empty())
 		return;
+
+	if (!HasDevice()) {
+		m_vertexData.resize(sizeof(T) * vertices.size());
+		std::memcpy(m_vertexData.data(), vertices.data(), m_vertexData.size());
+		return;
+	}
 	
 	Buffer vertexStaging(sizeof(T) * vertices.size(), VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
 		vertices.data());
@@ -56,6 +78,8 @@ template<typename T>
 void Model::Initialize(const std::vector<T> &vertices, const std::vector<uint32_t> &indices) {
 	SetVertices(vertices);
 	SetIndices(indices);
+	m_gpuSize = (m_vertexBuffer ? m_vertexBuffer->GetSize() : 0) + (m_indexBuffer ? m_indexBuffer->GetSize() : 0);
+	m_cpuSize = m_vertexData.size() + sizeof(uint32_t) * m_indexData.size();
 
 	m_minExtents = Vector3f::PositiveInfinity;
 	m_maxExtents = Vector3f::NegativeInfinity;
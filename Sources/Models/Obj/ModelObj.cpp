@@ -4,6 +4,7 @@
 #include "tiny_obj_loader.h"
 
 #include "Files/Files.hpp"
+#include "Graphics/Graphics.hpp"
 #include "Resources/Resources.hpp"
 #include "Models/Vertex3d.hpp"
 
@@ -12,8 +13,9 @@ bool ModelObj::registered = Register("obj", ".obj");
 
 class MaterialStreamReader : public tinyobj::MaterialReader {
 public:
-	explicit MaterialStreamReader(std::filesystem::path folder) :
-		m_folder(std::move(folder)) {
+	MaterialStreamReader(std::filesystem::path folder, Resource &model) :
+		m_folder(std::move(folder)),
+		m_model(model) {
 	}
 
 	bool operator()(const std::string &matId, std::vector<tinyobj::material_t> *materials, std::map<std::string, int> *matMap, std::string *warn, std::string *err) override {
@@ -22,6 +24,11 @@ public:
 
 		auto filepath = m_folder / matId;
 
+		// The model depends on its materials even when they are missing, so it is reloaded once they are added.
+		if (auto resources = Resources::Get()) {
+			resources->AddDependency(m_model, filepath);
+		}
+
 		if (!Files::ExistsInPath(filepath)) {
 			std::stringstream ss;
 			ss << "Material stream in error state. \n";
@@ -40,15 +47,20 @@ public:
 
 private:
 	std::filesystem::path m_folder;
+	Resource &m_model;
 };
 
 std::shared_ptr<ModelObj> ModelObj::Create(const Node &node) {
-	if (auto resource = Resources::Get()->Find(node)) {
-		return std::dynamic_pointer_cast<ModelObj>(resource);
+	if (auto resource = Resources::Get()->Find<ModelObj>(node)) {
+		return resource;
 	}
 
 	auto result = std::make_shared<ModelObj>("");
-	Resources::Get()->Add(node, std::dynamic_pointer_cast<Resource>(result));
+
+	if (auto resource = Resources::Get()->FindOrAdd(node, result); resource != result) {
+		return resource;
+	}
+
 	node >> *result;
 	result->Load();
 	return result;
@@ -68,6 +80,15 @@ ModelObj::ModelObj(std::filesystem::path filename, bool load) :
 	}
 }
 
+void ModelObj::Reload() {
+	// The buffers being replaced may still be used by a frame in flight.
+	if (auto graphics = Graphics::Get()) {
+		graphics->WaitIdle();
+	}
+
+	Load();
+}
+
 const Node &operator>>(const Node &node, ModelObj &model) {
 	node["filename"].Get(model.m_filename);
 	return node;
@@ -79,6 +100,8 @@ Node &operator<<(Node &node, const ModelObj &model) {
 }
 
 void ModelObj::Load() {
+	ACID_PROFILE_SCOPE("ModelObj::Load");
+
 	if (m_filename.empty()) {
 		return;
 	}
@@ -87,9 +110,13 @@ void ModelObj::Load() {
 	auto debugStart = Time::Now();
 #endif
 
+	if (auto resources = Resources::Get()) {
+		resources->AddDependency(*this, m_filename);
+	}
+
 	auto folder = m_filename.parent_path();
 	IFStream inStream(m_filename);
-	MaterialStreamReader materialReader(folder);
+	MaterialStreamReader materialReader(folder, *this);
 
 	tinyobj::attrib_t attrib;
 	std::vector<tinyobj::shape_t> shapes;
@@ -29,6 +29,11 @@ public:
 	 */
 	explicit ModelObj(std::filesystem::path filename, bool load = true);
 
+	/**
+	 * Reloads this model from its file, replacing the buffers on the device.
+	 */
+	void Reload() override;
+
 	friend const Node &operator>>(const Node &node, ModelObj &model);
 	friend Node &operator<<(Node &node, const ModelObj &model);
 
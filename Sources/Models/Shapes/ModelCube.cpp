@@ -7,12 +7,16 @@ namespace acid {
 bool ModelCube::registered = Register("cube");
 
 std::shared_ptr<ModelCube> ModelCube::Create(const Node &node) {
-	if (auto resource = Resources::Get()->Find(node)) {
-		return std::dynamic_pointer_cast<ModelCube>(resource);
+	if (auto resource = Resources::Get()->Find<ModelCube>(node)) {
+		return resource;
 	}
 
 	auto result = std::make_shared<ModelCube>(Vector3f());
-	Resources::Get()->Add(node, std::dynamic_pointer_cast<Resource>(result));
+
+	if (auto resource = Resources::Get()->FindOrAdd(node, result); resource != result) {
+		return resource;
+	}
+
 	node >> *result;
 	result->Load();
 	return result;
@@ -7,6 +7,8 @@ class ACID_EXPORT EmitterCircle : public Emitter::Registrar<EmitterCircle> {
 public:
 	explicit EmitterCircle(float radius = 1.0f, const Vector3f &heading = Vector3f::Up);
 
+	std::unique_ptr<Emitter> Clone() const override { return std::make_unique<EmitterCircle>(*this); }
+
 	Vector3f GeneratePosition() const override;
 
 	float GetRadius() const { return m_radius; }
@@ -7,6 +7,8 @@ class ACID_EXPORT EmitterLine : public Emitter::Registrar<EmitterLine> {
 public:
 	explicit EmitterLine(float length = 1.0f, const Vector3f &axis = Vector3f::Right);
 
+	std::unique_ptr<Emitter> Clone() const override { return std::make_unique<EmitterLine>(*this); }
+
 	Vector3f GeneratePosition() const override;
 
 	float GetLength() const { return m_length; }
@@ -7,6 +7,8 @@ class ACID_EXPORT EmitterPoint : public Emitter::Registrar<EmitterPoint> {
 public:
 	EmitterPoint();
 
+	std::unique_ptr<Emitter> Clone() const override { return std::make_unique<EmitterPoint>(*this); }
+
 	Vector3f GeneratePosition() const override;
 
 	const Vector3f &GetPoint() const { return m_point; }
@@ -7,6 +7,8 @@ class ACID_EXPORT EmitterSphere : public Emitter::Registrar<EmitterSphere> {
 public:
 	explicit EmitterSphere(float radius = 1.0f);
 
+	std::unique_ptr<Emitter> Clone() const override { return std::make_unique<EmitterSphere>(*this); }
+
 	Vector3f GeneratePosition() const override;
 
 	float GetRadius() const { return m_radius; }
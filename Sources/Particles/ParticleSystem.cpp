@@ -19,6 +19,27 @@ ParticleSystem::ParticleSystem(std::vector<std::shared_ptr<ParticleType>> types,
 	m_elapsedEmit(Time::Seconds(1.0f / m_pps)) {
 }
 
+std::unique_ptr<Component> ParticleSystem::Clone() const {
+	std::vector<std::unique_ptr<Emitter>> emitters;
+
+	for (const auto &emitter : m_emitters) {
+		if (!emitters.emplace_back(emitter->Clone())) {
+			return nullptr;
+		}
+	}
+
+	auto particleSystem = std::make_unique<ParticleSystem>(m_types, std::move(emitters), m_pps, m_averageSpeed, m_gravityEffect);
+	particleSystem->SetEnabled(IsEnabled());
+	particleSystem->m_randomRotation = m_randomRotation;
+	particleSystem->m_direction = m_direction;
+	particleSystem->m_directionDeviation = m_directionDeviation;
+	particleSystem->m_speedDeviation = m_speedDeviation;
+	particleSystem->m_lifeDeviation = m_lifeDeviation;
+	particleSystem->m_stageDeviation = m_stageDeviation;
+	particleSystem->m_scaleDeviation = m_scaleDeviation;
+	return particleSystem;
+}
+
 void ParticleSystem::Start() {
 }
 
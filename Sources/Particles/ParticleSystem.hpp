@@ -24,6 +24,8 @@ public:
 	explicit ParticleSystem(std::vector<std::shared_ptr<ParticleType>> types = {}, std::vector<std::unique_ptr<Emitter>> &&emitters = {}, 
 		float pps = 5.0f, float averageSpeed = 0.2f, float gravityEffect = 1.0f);
 
+	std::unique_ptr<Component> Clone() const override;
+
 	void Start() override;
 	void Update() override;
 
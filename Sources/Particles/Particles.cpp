@@ -28,8 +28,12 @@ void Particles::Update() {
 			continue;
 		}
 
-		std::sort((*it).second.begin(), (*it).second.end());
-		(*it).first->Update((*it).second);
+		// Sorting and instance buffers are only needed to render.
+		if (!Engine::Get()->IsHeadless()) {
+			std::sort((*it).second.begin(), (*it).second.end());
+			(*it).first->Update((*it).second);
+		}
+
 		++it;
 	}
 }
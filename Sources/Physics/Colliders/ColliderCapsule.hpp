@@ -11,6 +11,8 @@ public:
 
 	~ColliderCapsule();
 
+	std::unique_ptr<Collider> Clone() const override { return std::make_unique<ColliderCapsule>(m_radius, m_height, m_localTransform); }
+
 	btCollisionShape *GetCollisionShape() const override;
 
 	float GetRadius() const { return m_radius; }
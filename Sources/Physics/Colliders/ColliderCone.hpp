@@ -11,6 +11,8 @@ public:
 
 	~ColliderCone();
 
+	std::unique_ptr<Collider> Clone() const override { return std::make_unique<ColliderCone>(m_radius, m_height, m_localTransform); }
+
 	btCollisionShape *GetCollisionShape() const override;
 
 	float GetRadius() const { return m_radius; }
@@ -46,6 +46,21 @@ void ColliderConvexHull::Update() {
 	}
 }*/
 
+std::unique_ptr<Collider> ColliderConvexHull::Clone() const {
+	std::vector<float> pointCloud;
+
+	if (m_shape) {
+		pointCloud.reserve(m_shape->getNumPoints() * 3);
+
+		for (int32_t i = 0; i < m_shape->getNumPoints(); i++) {
+			auto point = m_shape->getUnscaledPoints()[i];
+			pointCloud.insert(pointCloud.end(), {static_cast<float>(point.x()), static_cast<float>(point.y()), static_cast<float>(point.z())});
+		}
+	}
+
+	return std::make_unique<ColliderConvexHull>(pointCloud, m_localTransform);
+}
+
 btCollisionShape *ColliderConvexHull::GetCollisionShape() const {
 	return m_shape.get();
 }
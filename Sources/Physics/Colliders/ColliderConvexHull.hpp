@@ -12,6 +12,8 @@ public:
 
 	~ColliderConvexHull();
 
+	std::unique_ptr<Collider> Clone() const override;
+
 	btCollisionShape *GetCollisionShape() const override;
 
 	uint32_t GetPointCount() const { return m_pointCount; }
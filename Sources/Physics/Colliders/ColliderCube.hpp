@@ -11,6 +11,8 @@ public:
 
 	~ColliderCube();
 
+	std::unique_ptr<Collider> Clone() const override { return std::make_unique<ColliderCube>(m_extents, m_localTransform); }
+
 	btCollisionShape *GetCollisionShape() const override;
 
 	const Vector3f &GetExtents() const { return m_extents; }
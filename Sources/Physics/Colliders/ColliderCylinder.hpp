@@ -11,6 +11,8 @@ public:
 
 	~ColliderCylinder();
 
+	std::unique_ptr<Collider> Clone() const override { return std::make_unique<ColliderCylinder>(m_radius, m_height, m_localTransform); }
+
 	btCollisionShape *GetCollisionShape() const override;
 
 	float GetRadius() const { return m_radius; }
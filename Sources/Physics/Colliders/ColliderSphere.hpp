@@ -11,6 +11,8 @@ public:
 
 	~ColliderSphere();
 
+	std::unique_ptr<Collider> Clone() const override { return std::make_unique<ColliderSphere>(m_radius, m_localTransform); }
+
 	btCollisionShape *GetCollisionShape() const override;
 
 	float GetRadius() const { return m_radius; }
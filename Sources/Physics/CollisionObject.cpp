@@ -43,6 +43,26 @@ Force *CollisionObject::AddForce(std::unique_ptr<Force> &&force) {
 	return m_forces.emplace_back(std::move(force)).get();
 }
 
+bool CollisionObject::CopyTo(CollisionObject &other) const {
+	for (const auto &collider : m_colliders) {
+		auto copy = collider->Clone();
+
+		if (!copy) {
+			return false;
+		}
+
+		other.AddCollider(std::move(copy));
+	}
+
+	other.m_mass = m_mass;
+	other.m_friction = m_friction;
+	other.m_frictionRolling = m_frictionRolling;
+	other.m_frictionSpinning = m_frictionSpinning;
+	other.m_linearFactor = m_linearFactor;
+	other.m_angularFactor = m_angularFactor;
+	return true;
+}
+
 void CollisionObject::SetChildTransform(Collider *child, const Transform &transform) {
 	auto compoundShape = dynamic_cast<btCompoundShape *>(m_shape.get());
 
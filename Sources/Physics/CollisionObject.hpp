@@ -96,6 +96,13 @@ protected:
 
 	void CreateShape(bool forceSingle = false);
 
+	/**
+	 * Copies the colliders and physical properties of this object into a object that has not been started, its body is created when it starts.
+	 * @param other The object to copy into.
+	 * @return If every collider could be copied.
+	 */
+	bool CopyTo(CollisionObject &other) const;
+
 	std::vector<std::unique_ptr<Collider>> m_colliders;
 
 	float m_mass;
@@ -23,13 +23,29 @@ KinematicCharacter::KinematicCharacter(std::unique_ptr<Collider> &&collider, flo
 }
 
 KinematicCharacter::~KinematicCharacter() {
-	auto physics = Scenes::Get()->GetPhysics();
-
-	if (physics) {
+	// Prefab templates are never started, and may be destroyed once the scenes module is gone.
+	if (auto scenes = Scenes::Get(); scenes && scenes->GetPhysics()) {
 		// TODO: Are these being deleted?
-		physics->GetDynamicsWorld()->removeCollisionObject(m_ghostObject.get());
-		physics->GetDynamicsWorld()->removeAction(m_controller.get());
+		scenes->GetPhysics()->GetDynamicsWorld()->removeCollisionObject(m_ghostObject.get());
+		scenes->GetPhysics()->GetDynamicsWorld()->removeAction(m_controller.get());
+	}
+}
+
+std::unique_ptr<Component> KinematicCharacter::Clone() const {
+	auto character = std::make_unique<KinematicCharacter>();
+
+	if (!CopyTo(*character)) {
+		return nullptr;
 	}
+
+	character->SetEnabled(IsEnabled());
+	character->m_up = m_up;
+	character->m_stepHeight = m_stepHeight;
+	character->m_fallSpeed = m_fallSpeed;
+	character->m_jumpSpeed = m_jumpSpeed;
+	character->m_maxHeight = m_maxHeight;
+	character->m_interpolate = m_interpolate;
+	return character;
 }
 
 void KinematicCharacter::Start() {
@@ -24,6 +24,8 @@ public:
 
 	~KinematicCharacter();
 
+	std::unique_ptr<Component> Clone() const override;
+
 	void Start() override;
 	void Update() override;
 
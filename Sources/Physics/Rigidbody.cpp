@@ -25,11 +25,21 @@ Rigidbody::~Rigidbody() {
 		delete body->getMotionState();
 	}
 
-	auto physics = Scenes::Get()->GetPhysics();
+	// Prefab templates are never started, and may be destroyed once the scenes module is gone.
+	if (auto scenes = Scenes::Get(); scenes && scenes->GetPhysics()) {
+		scenes->GetPhysics()->GetDynamicsWorld()->removeRigidBody(m_rigidBody.get());
+	}
+}
 
-	if (physics) {
-		physics->GetDynamicsWorld()->removeRigidBody(m_rigidBody.get());
+std::unique_ptr<Component> Rigidbody::Clone() const {
+	auto rigidbody = std::make_unique<Rigidbody>();
+
+	if (!CopyTo(*rigidbody)) {
+		return nullptr;
 	}
+
+	rigidbody->SetEnabled(IsEnabled());
+	return rigidbody;
 }
 
 void Rigidbody::Start() {
@@ -26,6 +26,8 @@ public:
 
 	~Rigidbody();
 
+	std::unique_ptr<Component> Clone() const override;
+
 	void Start() override;
 	void Update() override;
 
@@ -19,7 +19,7 @@ SubrenderDeferred::SubrenderDeferred(const Pipeline::Stage &pipelineStage) :
 	Subrender(pipelineStage),
 	m_pipeline(pipelineStage, {"Shaders/Deferred/Deferred.vert", "Shaders/Deferred/Deferred.frag"}, {}, {},
 		PipelineGraphics::Mode::Polygon, PipelineGraphics::Depth::None),
-	m_brdf(Resources::Get()->GetThreadPool().Enqueue(ComputeBRDF, 512)),
+	m_brdf(Resources::Get()->GetJobSystem().Enqueue(ComputeBRDF, 512)),
 	m_fog(Colour::White, 0.001f, 2.0f, -0.1f, 0.3f) {
 #if defined(ACID_DEBUG)
 	Node node;
@@ -33,27 +33,26 @@ void SubrenderDeferred::Render(const CommandBuffer &commandBuffer) {
 
 	// TODO probably use a cubemap image directly instead of scene components.
 	std::shared_ptr<ImageCube> skybox = nullptr;
-	auto meshes = Scenes::Get()->GetStructure()->QueryComponents<Mesh>();
-	for (const auto &mesh : meshes) {
-		if (auto materialSkybox = dynamic_cast<const MaterialSkybox *>(mesh->GetMaterial())) {
+	Scenes::Get()->GetStructure()->ForEach<Mesh>([&skybox](Mesh &mesh) {
+		if (auto materialSkybox = dynamic_cast<const MaterialSkybox *>(mesh.GetMaterial())) {
 			skybox = materialSkybox->GetImage();
-			break;
+			return false;
 		}
-	}
+
+		return true;
+	});
 
 	if (m_skybox != skybox) {
 		m_skybox = skybox;
-		m_irradiance = Resources::Get()->GetThreadPool().Enqueue(ComputeIrradiance, m_skybox, 64);
-		m_prefiltered = Resources::Get()->GetThreadPool().Enqueue(ComputePrefiltered, m_skybox, 512);
+		m_irradiance = Resources::Get()->GetJobSystem().Enqueue(ComputeIrradiance, m_skybox, 64);
+		m_prefiltered = Resources::Get()->GetJobSystem().Enqueue(ComputePrefiltered, m_skybox, 512);
 	}
 
 	// Updates uniforms.
-	std::vector<DeferredLight> deferredLights(MAX_LIGHTS);
+	std::pmr::vector<DeferredLight> deferredLights(MAX_LIGHTS, &FrameAllocator::Get());
 	uint32_t lightCount = 0;
 
-	auto sceneLights = Scenes::Get()->GetStructure()->QueryComponents<Light>();
-
-	for (const auto &light : sceneLights) {
+	Scenes::Get()->GetStructure()->ForEach<Light>([&](Light &light) {
 		//auto position = *light->GetPosition();
 		//float radius = light->GetRadius();
 
@@ -63,20 +62,18 @@ void SubrenderDeferred::Render(const CommandBuffer &commandBuffer) {
 		//}
 
 		DeferredLight deferredLight = {};
-		deferredLight.m_colour = light->GetColour();
+		deferredLight.m_colour = light.GetColour();
 
-		if (auto transform = light->GetEntity()->GetComponent<Transform>()) {
+		if (auto transform = light.GetEntity()->GetComponent<Transform>()) {
 			deferredLight.m_position = transform->GetPosition();
 		}
 
-		deferredLight.m_radius = light->GetRadius();
+		deferredLight.m_radius = light.GetRadius();
 		deferredLights[lightCount] = deferredLight;
 		lightCount++;
 
-		if (lightCount >= MAX_LIGHTS) {
-			break;
-		}
-	}
+		return lightCount < MAX_LIGHTS;
+	});
 
 	// Updates uniforms.
 	m_uniformScene.Push("view", camera->GetViewMatrix());
@@ -135,9 +132,9 @@ std::unique_ptr<Image2d> SubrenderDeferred::ComputeBRDF(uint32_t size) {
 
 #if defined(ACID_DEBUG)
 	// Saves the BRDF Image.
-	Resources::Get()->GetThreadPool().Enqueue([](Image2d *image) {
+	Resources::Get()->GetJobSystem().Run([image = brdfImage.get()]() {
 		image->GetBitmap()->Write("Deferred/Brdf.png");
-	}, brdfImage.get());
+	});
 #endif
 
 	return brdfImage;
@@ -170,9 +167,9 @@ std::unique_ptr<ImageCube> SubrenderDeferred::ComputeIrradiance(const std::share
 
 #if defined(ACID_DEBUG)
 	// Saves the irradiance Image.
-	Resources::Get()->GetThreadPool().Enqueue([](ImageCube *image) {
+	Resources::Get()->GetJobSystem().Run([image = irradianceCubemap.get()]() {
 		image->GetBitmap()->Write("Deferred/Irradiance.png");
-	}, irradianceCubemap.get());
+	});
 #endif
 
 	return irradianceCubemap;
@@ -236,11 +233,11 @@ std::unique_ptr<ImageCube> SubrenderDeferred::ComputePrefiltered(const std::shar
 	// TODO: This debug write causes a crash at runtime, why?
 #if defined(ACID_DEBUG)
 	// Saves the prefiltered Image.
-	Resources::Get()->GetThreadPool().Enqueue([](ImageCube *image) {
+	Resources::Get()->GetJobSystem().Run([image = prefilteredCubemap.get()]() {
 		for (uint32_t i = 0; i < image->GetMipLevels(); i++) {
 			image->GetBitmap(i)->Write("Deferred/Prefiltered_" + String::To(i) + ".png");
 		}
-	}, prefilteredCubemap.get());
+	});
 #endif
 
 	return prefilteredCubemap;
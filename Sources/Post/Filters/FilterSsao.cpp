@@ -12,7 +12,7 @@ static const float SSAO_RADIUS = 0.5f;
 
 FilterSsao::FilterSsao(const Pipeline::Stage &pipelineStage) :
 	PostFilter(pipelineStage, {"Shaders/Post/Default.vert", "Shaders/Post/Ssao.frag"}, GetDefines()),
-	m_noise(Resources::Get()->GetThreadPool().Enqueue(ComputeNoise, SSAO_NOISE_DIM)),
+	m_noise(Resources::Get()->GetJobSystem().Enqueue(ComputeNoise, SSAO_NOISE_DIM)),
 	m_kernel(SSAO_KERNEL_SIZE) {
 	for (uint32_t i = 0; i < SSAO_KERNEL_SIZE; ++i) {
 		Vector3f sample(Maths::Random(-1.0f, 1.0f), Maths::Random(-1.0f, 1.0f), Maths::Random(0.0f, 1.0f));
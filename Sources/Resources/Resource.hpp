@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include "StdAfx.hpp"
 //#include "Files/Node.hpp"
 
@@ -7,12 +8,35 @@ namespace acid {
 /**
  * @brief A managed resource object. Implementations contain Create functions that can take a node object or pass parameters to the constructor.
  */
-class ACID_EXPORT Resource {
+class ACID_EXPORT Resource : public std::enable_shared_from_this<Resource> {
 public:
 	Resource() = default;
 
 	virtual ~Resource() = default;
 
+	/**
+	 * Reloads this resource in place, called from {@link Resources#Update} when a file it depends on has changed.
+	 * Resources that are not loaded from files are left as they are.
+	 */
+	virtual void Reload() {}
+
+	/**
+	 * Gets the bytes of memory this resource holds on the CPU, counted against the budget of its type in {@link Resources}.
+	 * @return The CPU bytes.
+	 */
+	std::size_t GetCpuSize() const { return m_cpuSize; }
+
+	/**
+	 * Gets the bytes of device memory this resource holds, counted against the budget of its type in {@link Resources}.
+	 * @return The GPU bytes.
+	 */
+	std::size_t GetGpuSize() const { return m_gpuSize; }
+
+protected:
+	// Set by implementations once loaded, may be read while a resource is loading on another thread.
+	std::atomic<std::size_t> m_cpuSize = 0;
+	std::atomic<std::size_t> m_gpuSize = 0;
+
 	/*template<typename T>
 	friend std::enable_if_t<std::is_base_of_v<Resource, T>, const Node &> operator>>(const Node &node, std::shared_ptr<T> &object) {
 		object = T::Create(node);
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "Files/Node.hpp"
+
+namespace acid {
+/**
+ * @brief A resource that is loading on another thread, given by {@link Resources#LoadAsync}.
+ * Until the resource has loaded the handle gives the placeholder for its type, such as a checker image, a unit cube, or a silent sound.
+ * Handles are only read and completed on the main thread, so they need no locking.
+ * @tparam T The resource type.
+ */
+template<typename T>
+class ResourceHandle {
+	friend class Resources;
+public:
+	/// Called on the main thread once the resource has loaded, not called if it failed to load.
+	using OnLoaded = std::function<void(const std::shared_ptr<T> &)>;
+
+	ResourceHandle() = default;
+
+	/**
+	 * Gets the loaded resource, or the placeholder if it has not loaded yet.
+	 * @return The resource, null if it has not loaded and the type has no placeholder.
+	 */
+	std::shared_ptr<T> Get() const {
+		if (!m_state) {
+			return nullptr;
+		}
+
+		return m_state->m_resource ? m_state->m_resource : m_state->m_placeholder;
+	}
+
+	/**
+	 * Gets if the resource has finished loading, a resource that failed to load is ready and gives the placeholder.
+	 * @return If the resource is ready.
+	 */
+	bool IsReady() const { return m_state && m_state->m_ready; }
+
+	explicit operator bool() const { return static_cast<bool>(m_state); }
+
+private:
+	struct State {
+		Node m_node;
+		std::shared_ptr<T> m_placeholder;
+		// Set by the loading thread, then moved into the resource on the main thread.
+		std::shared_ptr<T> m_result;
+		std::shared_ptr<T> m_resource;
+		OnLoaded m_onLoaded;
+		bool m_ready = false;
+	};
+
+	std::shared_ptr<State> m_state;
+};
+}
@@ -1,54 +1,255 @@
 #include "Resources.hpp"
 
 namespace acid {
-Resources::Resources() :
+Resources::Resources(JobSystem *jobSystem) :
+	m_jobSystem(jobSystem),
 	m_elapsedPurge(5s) {
 }
 
+Resources::~Resources() {
+	// Loading jobs add their completions to this module.
+	if (!m_loading.IsDone()) {
+		GetJobSystem().Wait(m_loading);
+	}
+}
+
 void Resources::Update() {
+	// Completions are swapped out first, so callbacks may start more loads.
+	std::vector<std::function<void()>> completions;
+	{
+		std::lock_guard<std::mutex> lock(m_completionsMutex);
+		completions.swap(m_completions);
+	}
+
+	for (auto &completion : completions) {
+		completion();
+	}
+
+	std::vector<std::filesystem::path> changedFiles;
+	{
+		std::lock_guard<std::mutex> lock(m_changedFilesMutex);
+		changedFiles.swap(m_changedFiles);
+	}
+
+	if (!changedFiles.empty()) {
+		Reload(changedFiles);
+	}
+
 	if (m_elapsedPurge.GetElapsed() != 0) {
-		for (auto it = m_resources.begin(); it != m_resources.end();) {
-			if ((*it).second.use_count() <= 1) {
-				it = m_resources.erase(it);
-				continue;
+		Trim();
+	}
+}
+
+void Resources::Remove(const std::shared_ptr<Resource> &resource) {
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	for (auto &[typeId, resources] : m_resources) {
+		for (auto it = resources.begin(); it != resources.end(); ++it) {
+			if ((*it).second.m_resource == resource) {
+				resources.erase(it);
+				return;
+			}
+		}
+	}
+}
+
+void Resources::AddDependency(Resource &resource, const std::filesystem::path &filename) {
+	auto weak = resource.weak_from_this();
+
+	if (weak.expired()) {
+		return;
+	}
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	auto &dependents = m_dependents[filename.lexically_normal().generic_string()];
+
+	if (std::find_if(dependents.begin(), dependents.end(), [&resource](const std::weak_ptr<Resource> &dependent) {
+		return dependent.lock().get() == &resource;
+	}) == dependents.end()) {
+		dependents.emplace_back(std::move(weak));
+	}
+}
+
+void Resources::Watch(const std::filesystem::path &path) {
+	auto &observer = m_observers.emplace_back(std::make_unique<FileObserver>(path));
+	// Called from the observer's thread, so changes are queued for the next update.
+	observer->OnChange().Add([this](std::filesystem::path filename, FileObserver::Status status) {
+		if (status == FileObserver::Status::Erased) {
+			return;
+		}
+
+		std::lock_guard<std::mutex> lock(m_changedFilesMutex);
+		m_changedFiles.emplace_back(std::move(filename));
+	});
+}
+
+std::size_t Resources::Reload(const std::vector<std::filesystem::path> &filenames) {
+	std::vector<std::shared_ptr<Resource>> reloads;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		for (const auto &filename : filenames) {
+			// Watched paths start with the watched directory while dependencies are inside a search path, so each ending of the path is found.
+			auto path = filename.lexically_normal();
+			std::filesystem::path ending;
+
+			for (auto it = path.end(); it != path.begin();) {
+				--it;
+				ending = ending.empty() ? *it : *it / ending;
+				auto dependents = m_dependents.find(ending.generic_string());
+
+				if (dependents == m_dependents.end()) {
+					continue;
+				}
+
+				for (const auto &dependent : dependents->second) {
+					if (auto resource = dependent.lock(); resource && std::find(reloads.begin(), reloads.end(), resource) == reloads.end()) {
+						reloads.emplace_back(std::move(resource));
+					}
+				}
 			}
+		}
+	}
 
-			++it;
+	// Reloaded without holding the lock, as reloading adds dependencies and may create other resources.
+	for (const auto &resource : reloads) {
+		try {
+			resource->Reload();
+		} catch (const std::exception &e) {
+			Log::Error("Could not reload resource: ", e.what(), '\n');
 		}
 	}
+
+	return reloads.size();
 }
 
-std::shared_ptr<Resource> Resources::Find(const Node &node) const {
-	for (const auto &[key, resource] : m_resources) {
-		if (key == node) {
-			return resource;
+void Resources::Trim() {
+	// Evicted resources are destroyed after unlocking, as destructors may free device memory or use the registries.
+	std::vector<std::shared_ptr<Resource>> evicted;
+	std::unique_lock<std::mutex> lock(m_mutex);
+
+	struct Candidate {
+		std::unordered_map<Node, Entry> *resources;
+		std::unordered_map<Node, Entry>::iterator it;
+	};
+
+	struct Usage {
+		const Budget *budget;
+		Stats *stats;
+		std::size_t cpuBytes = 0;
+		std::size_t gpuBytes = 0;
+		std::vector<Candidate> candidates;
+	};
+
+	// Registries are gathered by budget type, as a budget may be shared by many resource types.
+	std::unordered_map<TypeId, Usage> usages;
+
+	for (auto &[typeId, resources] : m_resources) {
+		auto &cache = m_caches[m_budgetTypes.at(typeId)];
+
+		if (!cache.m_budget) {
+			for (auto it = resources.begin(); it != resources.end();) {
+				if (it->second.m_resource.use_count() <= 1) {
+					evicted.emplace_back(std::move(it->second.m_resource));
+					it = resources.erase(it);
+					cache.m_stats.m_evictions++;
+					continue;
+				}
+
+				++it;
+			}
+
+			continue;
+		}
+
+		auto &usage = usages.try_emplace(m_budgetTypes.at(typeId), Usage{&*cache.m_budget, &cache.m_stats}).first->second;
+
+		for (auto it = resources.begin(); it != resources.end(); ++it) {
+			usage.cpuBytes += it->second.m_resource->GetCpuSize();
+			usage.gpuBytes += it->second.m_resource->GetGpuSize();
+
+			// Releasing a handle is not seen, so resources still in use count as used at every trim.
+			if (it->second.m_resource.use_count() > 1) {
+				it->second.m_lastUsed = ++m_useCount;
+				continue;
+			}
+
+			usage.candidates.emplace_back(Candidate{&resources, it});
 		}
 	}
 
-	return nullptr;
-	/*auto it = m_resources.find(node);
+	for (auto &[budgetType, usage] : usages) {
+		if (usage.cpuBytes <= usage.budget->m_cpuBytes && usage.gpuBytes <= usage.budget->m_gpuBytes) {
+			continue;
+		}
 
-	if (it == m_resources.end()) {
-		return nullptr;
+		std::sort(usage.candidates.begin(), usage.candidates.end(), [](const Candidate &a, const Candidate &b) {
+			return a.it->second.m_lastUsed < b.it->second.m_lastUsed;
+		});
+
+		for (const auto &candidate : usage.candidates) {
+			if (usage.cpuBytes <= usage.budget->m_cpuBytes && usage.gpuBytes <= usage.budget->m_gpuBytes) {
+				break;
+			}
+
+			usage.cpuBytes -= candidate.it->second.m_resource->GetCpuSize();
+			usage.gpuBytes -= candidate.it->second.m_resource->GetGpuSize();
+			evicted.emplace_back(std::move(candidate.it->second.m_resource));
+			candidate.resources->erase(candidate.it);
+			usage.stats->m_evictions++;
+		}
 	}
 
-	return it->second;*/
-}
+	for (auto it = m_dependents.begin(); it != m_dependents.end();) {
+		auto &dependents = it->second;
+		dependents.erase(std::remove_if(dependents.begin(), dependents.end(), [](const std::weak_ptr<Resource> &dependent) {
+			return dependent.expired();
+		}), dependents.end());
 
-void Resources::Add(const Node &node, const std::shared_ptr<Resource> &resource) {
-	if (Find(node)) {
-		return;
+		if (dependents.empty()) {
+			it = m_dependents.erase(it);
+			continue;
+		}
+
+		++it;
 	}
 
-	m_resources.emplace(node, resource);
+	lock.unlock();
+	evicted.clear();
 }
 
-void Resources::Remove(const std::shared_ptr<Resource> &resource) {
-	for (auto it = m_resources.begin(); it != m_resources.end(); ++it) // TODO: Clean remove.
-	{
-		if ((*it).second == resource) {
-			m_resources.erase(it);
+Resources::Stats Resources::GetStats(TypeId budgetType) const {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	Stats stats;
+
+	if (auto cache = m_caches.find(budgetType); cache != m_caches.end()) {
+		stats = cache->second.m_stats;
+	}
+
+	for (const auto &[typeId, resources] : m_resources) {
+		if (m_budgetTypes.at(typeId) != budgetType) {
+			continue;
 		}
+
+		stats.m_count += resources.size();
+
+		for (const auto &[node, entry] : resources) {
+			stats.m_cpuBytes += entry.m_resource->GetCpuSize();
+			stats.m_gpuBytes += entry.m_resource->GetGpuSize();
+		}
+	}
+
+	return stats;
+}
+
+std::size_t Resources::GetSize() const {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	std::size_t size = 0;
+
+	for (const auto &[typeId, resources] : m_resources) {
+		size += resources.size();
 	}
+
+	return size;
 }
 }
@@ -1,34 +1,327 @@
 #pragma once
 
 #include "Engine/Engine.hpp"
-#include "Helpers/ThreadPool.hpp"
+#include "Files/FileObserver.hpp"
 #include "Files/Node.hpp"
+#include "Helpers/TypeInfo.hpp"
 #include "Resource.hpp"
+#include "ResourceHandle.hpp"
 
 namespace acid {
+/**
+ * @brief If a resource type has a static {@code CreatePlaceholder} function, giving the resource used while one is loading.
+ * @tparam T The resource type.
+ */
+template<typename T, typename = void>
+struct HasPlaceholder : std::false_type {};
+
+template<typename T>
+struct HasPlaceholder<T, std::void_t<decltype(T::CreatePlaceholder())>> : std::true_type {};
+
+/**
+ * @brief The type whose budget and stats a resource type is counted in, given by a {@code BudgetType} member such as {@link Model} for every model format.
+ * @tparam T The resource type.
+ */
+template<typename T, typename = void>
+struct BudgetTypeOf {
+	using Type = T;
+};
+
+template<typename T>
+struct BudgetTypeOf<T, std::void_t<typename T::BudgetType>> {
+	using Type = typename T::BudgetType;
+};
+
 /**
  * @brief Module used for managing resources.
+ * Each resource type has its own registry, where resources are found by a hash of the node they were created from.
+ * Registries may be used from any thread, so resources can be created while loading on a worker.
+ * Resources track the files they were loaded from, when a watched file changes only the resources depending on it are reloaded.
+ * Unused resources of a type with a budget stay cached, and are evicted least recently used first once the type is over budget.
+ * Unused resources of a type without a budget are released.
  */
 class ACID_EXPORT Resources : public Module::Registrar<Resources> {
 public:
-	Resources();
+	/**
+	 * @brief The memory a resource type may hold, cached resources are evicted while either is exceeded.
+	 */
+	struct Budget {
+		std::size_t m_cpuBytes = std::numeric_limits<std::size_t>::max();
+		std::size_t m_gpuBytes = std::numeric_limits<std::size_t>::max();
+	};
+
+	/**
+	 * @brief The cache statistics of a resource type.
+	 */
+	struct Stats {
+		/// Resources found by {@link Resources#Find}.
+		uint64_t m_hits = 0;
+		/// Resources not found by {@link Resources#Find}, that are then created.
+		uint64_t m_misses = 0;
+		/// Unused resources released or evicted over budget.
+		uint64_t m_evictions = 0;
+		/// The number of resources in the registries.
+		std::size_t m_count = 0;
+		std::size_t m_cpuBytes = 0;
+		std::size_t m_gpuBytes = 0;
+	};
+
+	/**
+	 * Creates the resource manager.
+	 * @param jobSystem The job system resources are loaded on, or null to use the engine's.
+	 */
+	explicit Resources(JobSystem *jobSystem = nullptr);
+
+	~Resources();
 
 	void Update() override;
 
-	std::shared_ptr<Resource> Find(const Node &node) const;
-	void Add(const Node &node, const std::shared_ptr<Resource> &resource);
+	/**
+	 * Finds a resource of a type that was created from a node equal to the given node, counted as a hit or miss of the type's cache.
+	 * @tparam T The resource type.
+	 * @param node The node.
+	 * @return The resource, or null if there is none.
+	 */
+	template<typename T>
+	std::shared_ptr<T> Find(const Node &node) {
+		std::lock_guard<std::mutex> lock(m_mutex);
+		auto &stats = m_caches[TypeInfo<Resource>::GetTypeId<typename BudgetTypeOf<T>::Type>()].m_stats;
+		auto registry = m_resources.find(TypeInfo<Resource>::GetTypeId<T>());
+
+		if (registry == m_resources.end()) {
+			stats.m_misses++;
+			return nullptr;
+		}
+
+		auto it = registry->second.find(node);
+
+		if (it == registry->second.end()) {
+			stats.m_misses++;
+			return nullptr;
+		}
+
+		stats.m_hits++;
+		it->second.m_lastUsed = ++m_useCount;
+		return std::static_pointer_cast<T>(it->second.m_resource);
+	}
+
+	/**
+	 * Adds a resource to the registry of its type, if there is no resource with an equal node already.
+	 * @tparam T The resource type.
+	 * @param node The node the resource is created from.
+	 * @param resource The resource.
+	 */
+	template<typename T>
+	void Add(const Node &node, const std::shared_ptr<T> &resource) {
+		std::lock_guard<std::mutex> lock(m_mutex);
+		auto typeId = TypeInfo<Resource>::GetTypeId<T>();
+		m_budgetTypes.emplace(typeId, TypeInfo<Resource>::GetTypeId<typename BudgetTypeOf<T>::Type>());
+		m_resources[typeId].emplace(node, Entry{resource, ++m_useCount});
+	}
+
+	/**
+	 * Adds a resource to the registry of its type, or finds the resource already added with an equal node, as one step.
+	 * Used by creates after {@link Resources#Find} misses, so concurrent creates of the same node agree on one resource and only that one is loaded.
+	 * A resource found may still be loading on the thread that added it. Not counted as a hit or miss, the find before it was.
+	 * @tparam T The resource type.
+	 * @param node The node the resource is created from.
+	 * @param resource The resource to add if there is none.
+	 * @return The resource in the registry, the given resource if it was added.
+	 */
+	template<typename T>
+	std::shared_ptr<T> FindOrAdd(const Node &node, const std::shared_ptr<T> &resource) {
+		std::lock_guard<std::mutex> lock(m_mutex);
+		auto typeId = TypeInfo<Resource>::GetTypeId<T>();
+		m_budgetTypes.emplace(typeId, TypeInfo<Resource>::GetTypeId<typename BudgetTypeOf<T>::Type>());
+		auto [it, added] = m_resources[typeId].try_emplace(node, Entry{resource, ++m_useCount});
+
+		if (!added) {
+			it->second.m_lastUsed = m_useCount;
+		}
+
+		return std::static_pointer_cast<T>(it->second.m_resource);
+	}
+
 	void Remove(const std::shared_ptr<Resource> &resource);
 
 	/**
-	 * Gets the resource loader thread pool.
-	 * @return The resource loader thread pool.
+	 * Adds a file that a resource was loaded from, the resource is reloaded when the file changes.
+	 * Resources not owned by a shared pointer, such as ones created on the stack, are not tracked.
+	 * @param resource The resource.
+	 * @param filename The file, as given to {@link Files#Read}.
+	 */
+	void AddDependency(Resource &resource, const std::filesystem::path &filename);
+
+	/**
+	 * Watches a directory for changed files, resources that depend on a changed file are reloaded on the next update.
+	 * Must be called on the main thread.
+	 * @param path The directory to watch, usually a search path given to {@link Files}.
+	 */
+	void Watch(const std::filesystem::path &path);
+
+	/**
+	 * Reloads in place every resource that depends on one of the files, a resource depending on many of them is reloaded once.
+	 * A changed path may start with the directory it was found in, it matches any dependency that it ends with.
+	 * @param filenames The changed files.
+	 * @return The number of resources reloaded.
+	 */
+	std::size_t Reload(const std::vector<std::filesystem::path> &filenames);
+
+	/**
+	 * Creates a resource on a worker thread, the returned handle gives a placeholder until it has loaded.
+	 * Must be called on the main thread, the handle is completed and the callback called from {@link Resources#Update}.
+	 * @tparam T The resource type, created with {@code T::Create(node)}.
+	 * @tparam Base The type the handle gives, the type a placeholder is created for, such as {@link Model} for a {@link ModelObj}.
+	 * @param node The node to create the resource from.
+	 * @param onLoaded A optional function called on the main thread once the resource has loaded, not called if it failed to load.
+	 * @return The handle to the resource.
+	 */
+	template<typename T, typename Base = T>
+	ResourceHandle<Base> LoadAsync(const Node &node, typename ResourceHandle<Base>::OnLoaded onLoaded = nullptr) {
+		ResourceHandle<Base> handle;
+		handle.m_state = std::make_shared<typename ResourceHandle<Base>::State>();
+		handle.m_state->m_node = node;
+		handle.m_state->m_placeholder = GetPlaceholder<Base>();
+		handle.m_state->m_onLoaded = std::move(onLoaded);
+
+		GetJobSystem().Run([this, state = handle.m_state]() {
+			// A resource that fails to load completes with no result, so its handle keeps giving the placeholder.
+			try {
+				state->m_result = T::Create(state->m_node);
+			} catch (const std::exception &e) {
+				Log::Error("Could not load resource: ", e.what(), '\n');
+			}
+
+			std::lock_guard<std::mutex> lock(m_completionsMutex);
+			m_completions.emplace_back([state]() {
+				state->m_resource = std::move(state->m_result);
+				state->m_ready = true;
+
+				if (state->m_onLoaded && state->m_resource) {
+					state->m_onLoaded(state->m_resource);
+					state->m_onLoaded = nullptr;
+				}
+			});
+		}, &m_loading);
+		return handle;
+	}
+
+	/**
+	 * Gets the placeholder of a resource type, created the first time it is used.
+	 * @tparam T The resource type.
+	 * @return The placeholder, or null if the type has none.
+	 */
+	template<typename T>
+	std::shared_ptr<T> GetPlaceholder() {
+		if constexpr (HasPlaceholder<T>::value) {
+			auto typeId = TypeInfo<Resource>::GetTypeId<T>();
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+
+				if (auto it = m_placeholders.find(typeId); it != m_placeholders.end()) {
+					return std::static_pointer_cast<T>(it->second);
+				}
+			}
+
+			// Created without holding the lock, as creating may find or add resources.
+			std::shared_ptr<Resource> placeholder = T::CreatePlaceholder();
+			std::lock_guard<std::mutex> lock(m_mutex);
+			return std::static_pointer_cast<T>(m_placeholders.emplace(typeId, std::move(placeholder)).first->second);
+		} else {
+			return nullptr;
+		}
+	}
+
+	/**
+	 * Gets the number of resources in every registry.
+	 * @return The number of resources.
+	 */
+	std::size_t GetSize() const;
+
+	/**
+	 * Releases unused resources of types without a budget, and evicts the least recently used unused resources of types over budget.
+	 * Called from {@link Resources#Update} every few seconds.
 	 */
-	ThreadPool &GetThreadPool() { return m_threadPool; }
+	void Trim();
+
+	/**
+	 * Gets the budget of a resource type.
+	 * @tparam T The resource type, or any type counted in its budget.
+	 * @return The budget, or none if unused resources are released.
+	 */
+	template<typename T>
+	std::optional<Budget> GetBudget() const {
+		std::lock_guard<std::mutex> lock(m_mutex);
+		auto cache = m_caches.find(TypeInfo<Resource>::GetTypeId<typename BudgetTypeOf<T>::Type>());
+		return cache != m_caches.end() ? cache->second.m_budget : std::nullopt;
+	}
+
+	/**
+	 * Sets the budget of a resource type, unused resources are then kept until the type is over budget.
+	 * @tparam T The resource type, or any type counted in its budget.
+	 * @param budget The budget, or none to release unused resources.
+	 */
+	template<typename T>
+	void SetBudget(const std::optional<Budget> &budget) {
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_caches[TypeInfo<Resource>::GetTypeId<typename BudgetTypeOf<T>::Type>()].m_budget = budget;
+	}
+
+	/**
+	 * Gets the cache statistics of a resource type, the resident count and bytes are summed from the registries.
+	 * @tparam T The resource type, or any type counted in its budget.
+	 * @return The stats.
+	 */
+	template<typename T>
+	Stats GetStats() const {
+		return GetStats(TypeInfo<Resource>::GetTypeId<typename BudgetTypeOf<T>::Type>());
+	}
+
+	/**
+	 * Gets the number of resources from {@link Resources#LoadAsync} that are still loading.
+	 * @return The number of loading resources.
+	 */
+	uint32_t GetLoadingCount() const { return m_loading.GetValue(); }
+
+	/**
+	 * Gets the job system used to load resources, this is shared with the engine's module updates.
+	 * @return The resource loader job system.
+	 */
+	JobSystem &GetJobSystem() { return m_jobSystem ? *m_jobSystem : Engine::Get()->GetJobSystem(); }
 
 private:
-	std::map<Node, std::shared_ptr<Resource>> m_resources;
+	struct Entry {
+		std::shared_ptr<Resource> m_resource;
+		// The use count when the resource was last found or seen in use, lower is less recently used.
+		uint64_t m_lastUsed;
+	};
+
+	struct Cache {
+		std::optional<Budget> m_budget;
+		Stats m_stats;
+	};
+
+	Stats GetStats(TypeId budgetType) const;
+
+	JobSystem *m_jobSystem;
+	std::unordered_map<TypeId, std::unordered_map<Node, Entry>> m_resources;
+	// The budget type of each registry.
+	std::unordered_map<TypeId, TypeId> m_budgetTypes;
+	std::unordered_map<TypeId, Cache> m_caches;
+	uint64_t m_useCount = 0;
+	std::unordered_map<TypeId, std::shared_ptr<Resource>> m_placeholders;
+	mutable std::mutex m_mutex;
 	ElapsedTime m_elapsedPurge;
 
-	ThreadPool m_threadPool;
+	JobCounter m_loading;
+	std::vector<std::function<void()>> m_completions;
+	std::mutex m_completionsMutex;
+
+	// Resources to reload when a file changes, by the normal path of the file.
+	std::unordered_map<std::string, std::vector<std::weak_ptr<Resource>>> m_dependents;
+	std::vector<std::filesystem::path> m_changedFiles;
+	std::mutex m_changedFilesMutex;
+	// Destroyed first, as observers add to the changed files from their own threads.
+	std::vector<std::unique_ptr<FileObserver>> m_observers;
 };
 }
@@ -0,0 +1,74 @@
+#include "Archetype.hpp"
+
+#include "Entity.hpp"
+
+namespace acid {
+Archetype::Archetype(std::vector<TypeId> signature) :
+	m_signature(std::move(signature)),
+	m_columns(m_signature.size()) {
+}
+
+std::size_t Archetype::GetColumn(TypeId typeId) const {
+	auto it = std::lower_bound(m_signature.begin(), m_signature.end(), typeId);
+
+	if (it == m_signature.end() || *it != typeId) {
+		return NoColumn;
+	}
+
+	return static_cast<std::size_t>(it - m_signature.begin());
+}
+
+void Archetype::Add(Entity *entity) {
+	entity->m_archetype = this;
+	entity->m_archetypeRow = m_entities.size();
+	m_entities.emplace_back(entity);
+
+	for (auto &column : m_columns) {
+		column.emplace_back(nullptr);
+	}
+
+	Refresh(entity);
+}
+
+void Archetype::Reserve(std::size_t size) {
+	m_entities.reserve(size);
+
+	for (auto &column : m_columns) {
+		column.reserve(size);
+	}
+}
+
+void Archetype::Remove(Entity *entity) {
+	// Swaps the last row into the removed row.
+	auto row = entity->m_archetypeRow;
+	auto last = m_entities.back();
+	m_entities[row] = last;
+	last->m_archetypeRow = row;
+	m_entities.pop_back();
+
+	for (auto &column : m_columns) {
+		column[row] = column.back();
+		column.pop_back();
+	}
+
+	entity->m_archetype = nullptr;
+}
+
+void Archetype::Refresh(Entity *entity) {
+	auto row = entity->m_archetypeRow;
+
+	for (auto &column : m_columns) {
+		column[row] = nullptr;
+	}
+
+	for (const auto &component : entity->GetComponents()) {
+		if (component->IsRemoved()) {
+			continue;
+		}
+
+		if (auto column = GetColumn(component->GetTypeId()); column != NoColumn && !m_columns[column][row]) {
+			m_columns[column][row] = component.get();
+		}
+	}
+}
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "Helpers/NonCopyable.hpp"
+#include "Component.hpp"
+
+namespace acid {
+class Entity;
+
+/**
+ * @brief A table of every entity in a structure with the same set of component types.
+ * Each component type is a column holding the entity's first component of that type, so iterating a type over a archetype is linear.
+ */
+class ACID_EXPORT Archetype : public virtual NonCopyable {
+	friend class Entity;
+	friend class SceneStructure;
+public:
+	/// The column returned when a type is not in the archetype.
+	static constexpr std::size_t NoColumn = std::numeric_limits<std::size_t>::max();
+
+	/**
+	 * Creates a new archetype.
+	 * @param signature The sorted and unique component type IDs.
+	 */
+	explicit Archetype(std::vector<TypeId> signature);
+
+	/**
+	 * Gets the column a component type is stored in.
+	 * @param typeId The component type ID.
+	 * @return The column, or {@link Archetype#NoColumn} if the type is not in this archetype.
+	 */
+	std::size_t GetColumn(TypeId typeId) const;
+
+	/**
+	 * Gets if any component type in this archetype is, or derives from, a type.
+	 * @tparam T The type.
+	 * @return If entities in this archetype have a component of the type.
+	 */
+	template<typename T>
+	bool Contains() const {
+		if constexpr (!std::is_base_of_v<Component, T>) {
+			return true;
+		} else {
+			for (const auto &column : m_columns) {
+				if (!column.empty() && Component::Cast<T>(column.front())) {
+					return true;
+				}
+			}
+
+			return false;
+		}
+	}
+
+	const std::vector<TypeId> &GetSignature() const { return m_signature; }
+	const std::vector<Entity *> &GetEntities() const { return m_entities; }
+	const std::vector<Component *> &GetComponents(std::size_t column) const { return m_columns[column]; }
+	std::size_t GetSize() const { return m_entities.size(); }
+
+private:
+	void Add(Entity *entity);
+	void Remove(Entity *entity);
+	void Refresh(Entity *entity);
+
+	/**
+	 * Reserves rows for a number of entities, so adding that many does not reallocate.
+	 * @param size The number of rows.
+	 */
+	void Reserve(std::size_t size);
+
+	std::vector<TypeId> m_signature;
+	std::vector<Entity *> m_entities;
+	std::vector<std::vector<Component *>> m_columns;
+};
+}
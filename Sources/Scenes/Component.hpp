@@ -13,6 +13,16 @@ class Entity;
 class ACID_EXPORT Component : public StreamFactory<Component>, public virtual Observer {
 	friend class Entity;
 public:
+	Component() = default;
+
+	/**
+	 * Copies if the component is enabled, the copy is not attached to a entity and has not been started.
+	 * @param other The component to copy.
+	 */
+	Component(const Component &other) :
+		m_enabled(other.m_enabled) {
+	}
+
 	virtual ~Component() = default;
 
 	/**
@@ -23,10 +33,26 @@ public:
 
 	/**
 	 * Run when updating the entity this is attached to.
+	 * If {@link Component#IsThreadSafe} this may be run on a worker thread at the same time as other components.
 	 */
 	virtual void Update() {
 	}
 
+	/**
+	 * Run on the main thread after every component in the structure has been updated.
+	 */
+	virtual void LateUpdate() {
+	}
+
+	/**
+	 * Gets if {@link Component#Update} can run on a worker thread in parallel with other components.
+	 * A thread safe update should only change this component, anything that touches other components belongs in {@link Component#LateUpdate}.
+	 * World transforms are recomputed before thread safe updates run, so reading any transform is safe but changing one is not.
+	 * Adding or removing components and entities from a parallel update is queued until every parallel update has finished.
+	 * @return If the update is thread safe.
+	 */
+	virtual bool IsThreadSafe() const { return false; }
+
 	bool IsEnabled() const { return m_enabled; };
 	void SetEnabled(bool enable) { m_enabled = enable; }
 
@@ -45,11 +71,72 @@ public:
 	 */
 	void SetEntity(Entity *entity) { m_entity = entity; }
 
+	/**
+	 * Casts a component to a type if it is, or derives from, that type.
+	 * Components added to a entity remember their type ID, if a component type derives from T is found with one dynamic_cast the first time
+	 * the type is seen and cached, after that casting compares type IDs. Types that are not components are always found with dynamic_cast.
+	 * @tparam T The type to cast to.
+	 * @param component The component to cast, may be null.
+	 * @return The casted component, or null if the component is not of the type.
+	 */
+	template<typename T>
+	static T *Cast(Component *component) {
+		if constexpr (std::is_same_v<T, Component>) {
+			return component;
+		} else if constexpr (!std::is_base_of_v<Component, T>) {
+			return dynamic_cast<T *>(component);
+		} else {
+			if (!component) {
+				return nullptr;
+			}
+
+			auto typeId = component->m_typeId;
+
+			if (typeId == TypeInfo<Component>::GetTypeId<T>()) {
+				return static_cast<T *>(component);
+			}
+
+			if (typeId >= MaxCastTypes) {
+				return dynamic_cast<T *>(component);
+			}
+
+			auto &derives = Derives<T>()[typeId];
+			auto value = derives.load(std::memory_order_relaxed);
+
+			if (value == Relation::Unknown) {
+				value = dynamic_cast<T *>(component) ? Relation::Derived : Relation::Unrelated;
+				derives.store(value, std::memory_order_relaxed);
+			}
+
+			return value == Relation::Derived ? static_cast<T *>(component) : nullptr;
+		}
+	}
+
 private:
+	enum class Relation : uint8_t {
+		Unknown, Derived, Unrelated
+	};
+
+	/// Component type IDs up to this have their cast results cached.
+	static constexpr TypeId MaxCastTypes = 256;
+
+	/**
+	 * Gets if each component type derives from T, indexed by type ID.
+	 * @tparam T The type being casted to.
+	 * @return The cached relations.
+	 */
+	template<typename T>
+	static std::array<std::atomic<Relation>, MaxCastTypes> &Derives() {
+		static std::array<std::atomic<Relation>, MaxCastTypes> derives = {};
+		return derives;
+	}
+
 	bool m_started = false;
 	bool m_enabled = true;
 	bool m_removed = false;
 	Entity *m_entity = nullptr;
+	// Set when added to a entity, every component type has a ID even if it is not registered.
+	TypeId m_typeId = -1;
 };
 
 }
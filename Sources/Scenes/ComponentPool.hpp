@@ -0,0 +1,186 @@
+#pragma once
+
+#include "Helpers/NonCopyable.hpp"
+#include "Component.hpp"
+
+namespace acid {
+class ComponentPoolBase;
+
+/**
+ * @brief Deletes a component, returning it to the pool it was created in if it has one.
+ */
+class ACID_EXPORT ComponentDeleter {
+public:
+	ComponentDeleter() = default;
+
+	explicit ComponentDeleter(std::shared_ptr<ComponentPoolBase> pool) :
+		m_pool(std::move(pool)) {
+	}
+
+	/**
+	 * Allows heap allocated components to be converted from a {@code std::unique_ptr} of any component type.
+	 */
+	template<typename T, typename = std::enable_if_t<std::is_base_of_v<Component, T>>>
+	ComponentDeleter(const std::default_delete<T> &) {
+	}
+
+	void operator()(Component *component) const;
+
+	ComponentPoolBase *GetPool() const { return m_pool.get(); }
+
+private:
+	// Shared so components that are moved to another structure keep their pool alive.
+	std::shared_ptr<ComponentPoolBase> m_pool;
+};
+
+using ComponentPtr = std::unique_ptr<Component, ComponentDeleter>;
+
+/**
+ * @brief Storage for components of one type.
+ */
+class ACID_EXPORT ComponentPoolBase : public virtual NonCopyable {
+public:
+	virtual ~ComponentPoolBase() = default;
+
+	/**
+	 * Destroys a component that was created in this pool.
+	 * @param component The component to destroy.
+	 */
+	virtual void Destroy(Component *component) = 0;
+
+	/**
+	 * Gets the number of components alive in this pool.
+	 * @return The number of components.
+	 */
+	virtual std::size_t GetSize() const = 0;
+};
+
+/**
+ * @brief Stores components of one type contiguously in fixed size chunks, so their addresses never change and iterating them touches memory in order.
+ * @tparam T The component type.
+ */
+template<typename T>
+class ComponentPool : public ComponentPoolBase {
+public:
+	/// The number of components in each chunk.
+	static constexpr std::size_t ChunkSize = 256;
+
+	~ComponentPool() {
+		for (std::size_t i = 0; i < m_chunks.size(); i++) {
+			for (std::size_t j = 0; j < ChunkSize; j++) {
+				if (m_chunks[i].m_alive[j]) {
+					Get(i, j)->~T();
+				}
+			}
+		}
+	}
+
+	/**
+	 * Creates a component in the first free slot.
+	 * @tparam Args The argument types.
+	 * @param args The component constructor arguments.
+	 * @return The created component.
+	 */
+	template<typename... Args>
+	T *Create(Args &&... args) {
+		if (m_free.empty()) {
+			auto chunk = m_chunks.size();
+			m_chunks.emplace_back();
+			m_ranges.emplace(reinterpret_cast<const std::byte *>(m_chunks.back().m_data.get()), chunk);
+
+			// Slots are handed out lowest first, so components created together sit next to each other.
+			for (auto j = ChunkSize; j-- > 0;) {
+				m_free.emplace_back(chunk * ChunkSize + j);
+			}
+		}
+
+		auto slot = m_free.back();
+		auto component = new(Get(slot / ChunkSize, slot % ChunkSize)) T(std::forward<Args>(args)...);
+		m_free.pop_back();
+		m_chunks[slot / ChunkSize].m_alive[slot % ChunkSize] = true;
+		m_size++;
+		return component;
+	}
+
+	void Destroy(Component *component) override {
+		auto casted = static_cast<T *>(component);
+		auto address = reinterpret_cast<const std::byte *>(casted);
+		auto it = --m_ranges.upper_bound(address);
+		auto chunk = it->second;
+		auto index = static_cast<std::size_t>(casted - Get(chunk, 0));
+
+		casted->~T();
+		m_chunks[chunk].m_alive[index] = false;
+		m_free.emplace_back(chunk * ChunkSize + index);
+		m_size--;
+	}
+
+	std::size_t GetSize() const override { return m_size; }
+
+private:
+	struct Chunk {
+		std::unique_ptr<std::aligned_storage_t<sizeof(T), alignof(T)>[]> m_data = std::make_unique<std::aligned_storage_t<sizeof(T), alignof(T)>[]>(ChunkSize);
+		std::array<bool, ChunkSize> m_alive = {};
+	};
+
+	T *Get(std::size_t chunk, std::size_t index) {
+		return reinterpret_cast<T *>(m_chunks[chunk].m_data.get()) + index;
+	}
+
+	std::vector<Chunk> m_chunks;
+	// Finds the chunk a component is in from its address.
+	std::map<const std::byte *, std::size_t> m_ranges;
+	std::vector<std::size_t> m_free;
+	std::size_t m_size = 0;
+};
+
+/**
+ * @brief The component pools of a structure, one for each component type created through it.
+ */
+class ACID_EXPORT ComponentPools : public virtual NonCopyable {
+public:
+	/**
+	 * Creates a component in the pool for its type.
+	 * @tparam T The component type.
+	 * @tparam Args The argument types.
+	 * @param args The component constructor arguments.
+	 * @return The created component, and the owning pointer that returns it to the pool.
+	 */
+	template<typename T, typename... Args>
+	std::pair<T *, ComponentPtr> Create(Args &&... args) {
+		auto &pool = m_pools[std::type_index(typeid(T))];
+
+		if (!pool) {
+			pool = std::make_shared<ComponentPool<T>>();
+		}
+
+		auto component = static_cast<ComponentPool<T> *>(pool.get())->Create(std::forward<Args>(args)...);
+		return {component, ComponentPtr(component, ComponentDeleter(pool))};
+	}
+
+	/**
+	 * Gets the number of components alive in every pool.
+	 * @return The number of components.
+	 */
+	std::size_t GetSize() const {
+		std::size_t size = 0;
+
+		for (const auto &[type, pool] : m_pools) {
+			size += pool->GetSize();
+		}
+
+		return size;
+	}
+
+private:
+	std::unordered_map<std::type_index, std::shared_ptr<ComponentPoolBase>> m_pools;
+};
+
+inline void ComponentDeleter::operator()(Component *component) const {
+	if (m_pool) {
+		m_pool->Destroy(component);
+	} else {
+		delete component;
+	}
+}
+}
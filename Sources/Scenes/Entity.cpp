@@ -9,48 +9,152 @@ Entity::Entity(const std::filesystem::path &filename) {
 	*entityPrefab >> *this;
 }
 
-void Entity::Update() {
-	for (auto it = m_components.begin(); it != m_components.end();) {
-		if ((*it)->IsRemoved()) {
-			it = m_components.erase(it);
+Entity::~Entity() {
+	if (m_archetype) {
+		m_archetype->Remove(this);
+	}
+}
+
+void Entity::Update(std::vector<Component *> *parallel) {
+	auto removed = false;
+
+	// Indexed because a update may add components.
+	for (std::size_t i = 0; i < m_components.size(); i++) {
+		auto component = m_components[i].get();
+
+		if (component->IsRemoved()) {
+			// Erased at the structure's next sync point, or straight after this loop if the entity is not being updated by a structure.
+			if (IsUpdating()) {
+				m_structure->GetCommands().RemoveComponent(this, component);
+			} else {
+				removed = true;
+			}
+
 			continue;
 		}
 
-		if ((*it)->GetEntity() != this) {
-			(*it)->SetEntity(this);
+		if (component->GetEntity() != this) {
+			component->SetEntity(this);
 		}
 
-		if ((*it)->IsEnabled()) {
-			if (!(*it)->m_started) {
-				(*it)->Start();
-				(*it)->m_started = true;
+		if (component->IsEnabled()) {
+			if (!component->m_started) {
+				component->Start();
+				component->m_started = true;
 			}
 
-			(*it)->Update();
+			if (parallel && component->IsThreadSafe()) {
+				parallel->emplace_back(component);
+			} else {
+				component->Update();
+			}
 		}
+	}
 
-		++it;
+	if (removed && CompactComponents()) {
+		UpdateArchetype();
 	}
 }
 
-Component *Entity::AddComponent(std::unique_ptr<Component> &&component) {
+void Entity::LateUpdate() {
+	// Indexed because a late update may add components.
+	for (std::size_t i = 0; i < m_components.size(); i++) {
+		auto component = m_components[i].get();
+
+		if (component->m_started && component->IsEnabled() && !component->IsRemoved()) {
+			component->LateUpdate();
+		}
+	}
+}
+
+void Entity::SetName(const std::string &name) {
+	if (IsDeferring()) {
+		m_structure->GetCommands().Rename(this, name);
+	} else if (m_structure) {
+		m_structure->RenameEntity(this, name);
+	} else {
+		m_name = name;
+	}
+}
+
+Component *Entity::AddComponent(ComponentPtr &&component) {
 	if (!component) {
 		return nullptr;
 	}
 
-	component->SetEntity(this);
-	return m_components.emplace_back(std::move(component)).get();
+	if (IsDeferring()) {
+		component->SetEntity(this);
+		return m_structure->GetCommands().AddComponent(this, std::move(component));
+	}
+
+	auto result = InsertComponent(std::move(component));
+	UpdateArchetype();
+	return result;
 }
 
 void Entity::RemoveComponent(Component *component) {
-	m_components.erase(std::remove_if(m_components.begin(), m_components.end(), [component](std::unique_ptr<Component> &c) {
+	if (IsUpdating()) {
+		m_structure->GetCommands().RemoveComponent(this, component);
+		return;
+	}
+
+	m_components.erase(std::remove_if(m_components.begin(), m_components.end(), [component](ComponentPtr &c) {
 		return c.get() == component;
 	}), m_components.end());
+	UpdateArchetype();
 }
 
 void Entity::RemoveComponent(const std::string &name) {
-	m_components.erase(std::remove_if(m_components.begin(), m_components.end(), [name](std::unique_ptr<Component> &c) {
+	if (IsUpdating()) {
+		for (const auto &component : m_components) {
+			if (name == component->GetTypeName()) {
+				RemoveComponent(component.get());
+			}
+		}
+
+		return;
+	}
+
+	m_components.erase(std::remove_if(m_components.begin(), m_components.end(), [name](ComponentPtr &c) {
 		return name == c->GetTypeName();
 	}), m_components.end());
+	UpdateArchetype();
+}
+
+void Entity::UpdateArchetype() {
+	if (m_structure) {
+		m_structure->UpdateArchetype(this);
+	}
+}
+
+Component *Entity::InsertComponent(ComponentPtr &&component) {
+	component->SetEntity(this);
+	component->m_typeId = component->GetTypeId();
+	return m_components.emplace_back(std::move(component)).get();
+}
+
+bool Entity::CompactComponents() {
+	auto it = std::remove_if(m_components.begin(), m_components.end(), [](const ComponentPtr &component) {
+		return component->IsRemoved();
+	});
+
+	if (it == m_components.end()) {
+		return false;
+	}
+
+	m_components.erase(it, m_components.end());
+	return true;
+}
+
+bool Entity::IsUpdating() const {
+	return m_structure && m_structure->IsUpdating();
+}
+
+bool Entity::IsDeferring() const {
+	return m_structure && m_structure->IsDeferring();
+}
+
+ComponentPools *Entity::GetPools() const {
+	return IsDeferring() ? nullptr : m_pools;
 }
 }
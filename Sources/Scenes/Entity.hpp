@@ -1,13 +1,19 @@
 #pragma once
 
 #include "Helpers/NonCopyable.hpp"
-#include "Component.hpp"
+#include "ComponentPool.hpp"
+#include "EntityHandle.hpp"
 
 namespace acid {
+class Archetype;
+class SceneStructure;
+
 /**
  * @brief Class that represents a objects that acts as a component container.
  */
 class ACID_EXPORT Entity : public virtual NonCopyable {
+	friend class Archetype;
+	friend class SceneStructure;
 public:
 	Entity() = default;
 
@@ -17,13 +23,24 @@ public:
 	 */
 	Entity(const std::filesystem::path &filename);
 
-	void Update();
+	~Entity();
+
+	/**
+	 * Starts and updates the components attached to this entity, removing any that have been marked removed.
+	 * @param parallel If not null, thread safe components are added to this list to be updated later instead of being updated now.
+	 */
+	void Update(std::vector<Component *> *parallel = nullptr);
+
+	/**
+	 * Calls {@link Component#LateUpdate} on every started and enabled component.
+	 */
+	void LateUpdate();
 
 	/**
 	 * Gets all components attached to this entity.
 	 * @return The list of components.
 	 */
-	const std::vector<std::unique_ptr<Component>> &GetComponents() const { return m_components; }
+	const std::vector<ComponentPtr> &GetComponents() const { return m_components; }
 
 	/**
 	 * Gets the count of components attached to this entity.
@@ -42,7 +59,7 @@ public:
 		T *alternative = nullptr;
 
 		for (const auto &component : m_components) {
-			auto casted = dynamic_cast<T *>(component.get());
+			auto casted = Component::Cast<T>(component.get());
 
 			if (casted) {
 				if (allowDisabled && !component->IsEnabled()) {
@@ -68,7 +85,7 @@ public:
 		std::vector<T *> components;
 
 		for (const auto &component : m_components) {
-			auto casted = dynamic_cast<T *>(component.get());
+			auto casted = Component::Cast<T>(component.get());
 
 			if (casted) {
 				if (allowDisabled && !component->IsEnabled()) {
@@ -88,10 +105,11 @@ public:
 	 * @param component The component to add.
 	 * @return The added component.
 	 */
-	Component *AddComponent(std::unique_ptr<Component> &&component);
+	Component *AddComponent(ComponentPtr &&component);
 
 	/**
 	 * Creates a component by type to be added this entity.
+	 * If the entity is in a structure with pooled storage the component is created in the structure's pool for its type.
 	 * @tparam T The type of component to add.
 	 * @tparam Args The argument types/
 	 * @param args The type constructor arguments.
@@ -99,11 +117,21 @@ public:
 	 */
 	template<typename T, typename... Args>
 	T *AddComponent(Args &&... args) {
-		return dynamic_cast<T *>(AddComponent(std::make_unique<T>(std::forward<Args>(args)...)));
+		if (auto pools = GetPools()) {
+			auto [component, owner] = pools->Create<T>(std::forward<Args>(args)...);
+			AddComponent(std::move(owner));
+			return component;
+		}
+
+		auto component = std::make_unique<T>(std::forward<Args>(args)...);
+		auto result = component.get();
+		AddComponent(std::move(component));
+		return result;
 	}
 
 	/**
 	 * Removes a component from this entity.
+	 * While the structure is updating the removal is recorded and applied at the structure's next sync point.
 	 * @param component The component to remove.
 	 */
 	void RemoveComponent(Component *component);
@@ -120,25 +148,103 @@ public:
 	 */
 	template<typename T>
 	void RemoveComponent() {
-		for (auto it = m_components.begin(); it != m_components.end(); ++it) {
-			auto casted = dynamic_cast<T *>((*it).get());
-
-			if (casted) {
-				(*it)->SetEntity(nullptr);
-				m_components.erase(it);
+		if (IsUpdating()) {
+			for (const auto &component : m_components) {
+				if (Component::Cast<T>(component.get())) {
+					RemoveComponent(component.get());
+				}
 			}
+
+			return;
 		}
+
+		m_components.erase(std::remove_if(m_components.begin(), m_components.end(), [](const ComponentPtr &component) {
+			return Component::Cast<T>(component.get()) != nullptr;
+		}), m_components.end());
+		UpdateArchetype();
 	}
 
 	const std::string &GetName() const { return m_name; }
-	void SetName(const std::string &name) { m_name = name; }
+	/**
+	 * Sets the name, while the structure is updating components in parallel the rename is recorded and the name changes at the next sync point.
+	 * @param name The new name.
+	 */
+	void SetName(const std::string &name);
 
 	bool IsRemoved() const { return m_removed; }
 	void SetRemoved(bool removed) { m_removed = removed; }
 
+	/**
+	 * Gets the structure this entity is in.
+	 * @return The structure, or null if the entity has not been added to one.
+	 */
+	SceneStructure *GetStructure() const { return m_structure; }
+
+	/**
+	 * Gets the handle to this entity in its structure, keep a handle instead of a pointer when the entity may be destroyed.
+	 * @return The handle, or a null handle if the entity has not been added to a structure.
+	 */
+	const EntityHandle &GetHandle() const { return m_handle; }
+
+	/**
+	 * Gets the archetype table this entity is a row of.
+	 * @return The archetype, or null if the entity has not been added to a structure.
+	 */
+	Archetype *GetArchetype() const { return m_archetype; }
+
 private:
+	/**
+	 * Moves this entity to the archetype matching its components, called after components are added or removed.
+	 */
+	void UpdateArchetype();
+
+	/**
+	 * Adds a component without updating the archetype.
+	 * @param component The component.
+	 * @return The added component.
+	 */
+	Component *InsertComponent(ComponentPtr &&component);
+
+	/**
+	 * Erases components that have been marked removed.
+	 * @return If any components were erased.
+	 */
+	bool CompactComponents();
+
+	/**
+	 * Gets if removing components must be recorded, because the structure is updating.
+	 * @return If removals are deferred.
+	 */
+	bool IsUpdating() const;
+
+	/**
+	 * Gets if adding components must be recorded too, because the structure is updating components in parallel.
+	 * @return If changes are deferred.
+	 */
+	bool IsDeferring() const;
+
+	/**
+	 * Gets the pools to create components in, pools are not thread safe so none are used while deferring.
+	 * @return The pools, or null to allocate components on the heap.
+	 */
+	ComponentPools *GetPools() const;
+
 	std::string m_name;
-	std::vector<std::unique_ptr<Component>> m_components;
+	std::vector<ComponentPtr> m_components;
 	bool m_removed = false;
+
+	SceneStructure *m_structure = nullptr;
+	ComponentPools *m_pools = nullptr;
+	Archetype *m_archetype = nullptr;
+	std::size_t m_archetypeRow = 0;
+	// The position of this entity in the structure's entity list.
+	std::size_t m_index = 0;
+	EntityHandle m_handle;
+	// Other entities in the structure with the same name.
+	Entity *m_prevNamed = nullptr;
+	Entity *m_nextNamed = nullptr;
+	// The leaf of this entity in the structure's spatial tree, and the transform version it was placed with.
+	int32_t m_spatialProxy = -1;
+	uint32_t m_boundsVersion = 0;
 };
 }
@@ -0,0 +1,60 @@
+#include "EntityCommandBuffer.hpp"
+
+namespace acid {
+Entity *EntityCommandBuffer::CreateEntity() {
+	auto object = std::make_unique<Entity>();
+	auto result = object.get();
+	Add(std::move(object));
+	return result;
+}
+
+Entity *EntityCommandBuffer::CreateEntity(const std::string &filename) {
+	auto object = std::make_unique<Entity>(filename);
+	auto result = object.get();
+	Add(std::move(object));
+	return result;
+}
+
+void EntityCommandBuffer::Add(std::unique_ptr<Entity> object) {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_created.emplace_back(std::move(object));
+}
+
+void EntityCommandBuffer::Destroy(Entity *object) {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_destroyed.emplace_back(object);
+}
+
+void EntityCommandBuffer::Destroy(const EntityHandle &handle) {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_destroyedHandles.emplace_back(handle);
+}
+
+Component *EntityCommandBuffer::AddComponent(Entity *object, ComponentPtr &&component) {
+	auto result = component.get();
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_addedComponents.emplace_back(object, std::move(component));
+	return result;
+}
+
+void EntityCommandBuffer::RemoveComponent(Entity *object, Component *component) {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_removedComponents.emplace_back(object, component);
+}
+
+void EntityCommandBuffer::Rename(Entity *object, const std::string &name) {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_renamed.emplace_back(object, name);
+}
+
+void EntityCommandBuffer::Move(Entity *object, SceneStructure &structure) {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_moved.emplace_back(object, &structure);
+}
+
+bool EntityCommandBuffer::IsEmpty() {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_created.empty() && m_addedComponents.empty() && m_removedComponents.empty() && m_renamed.empty() && m_moved.empty() && m_destroyed.empty() &&
+		m_destroyedHandles.empty();
+}
+}
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <mutex>
+#include "Helpers/NonCopyable.hpp"
+#include "Entity.hpp"
+
+namespace acid {
+class SceneStructure;
+
+/**
+ * @brief Records changes to the entities and components of a structure, to be applied together at the structure's next sync point.
+ * Recording is thread safe. Applying groups changes by kind: component changes refresh each entity's archetype once,
+ * and destroyed entities are swapped with the last entity and popped, so removing thousands of entities in a frame is linear.
+ */
+class ACID_EXPORT EntityCommandBuffer : public virtual NonCopyable {
+	friend class SceneStructure;
+public:
+	/**
+	 * Creates a entity that will be added when the commands are applied, until then the entity is only owned by this buffer.
+	 * @return The created entity, components may be added to it straight away.
+	 */
+	Entity *CreateEntity();
+
+	/**
+	 * Creates a entity from a prefab that will be added when the commands are applied.
+	 * @param filename The file to load the component data from.
+	 * @return The created entity.
+	 */
+	Entity *CreateEntity(const std::string &filename);
+
+	/**
+	 * Records a entity to be added.
+	 * @param object The entity.
+	 */
+	void Add(std::unique_ptr<Entity> object);
+
+	/**
+	 * Records a entity to be destroyed, destroying the same entity more than once is allowed.
+	 * @param object The entity.
+	 */
+	void Destroy(Entity *object);
+
+	/**
+	 * Records a entity to be destroyed by handle, nothing happens if the entity has already been destroyed when the commands are applied.
+	 * @param handle The entity handle.
+	 */
+	void Destroy(const EntityHandle &handle);
+
+	/**
+	 * Records a component to be added to a entity.
+	 * @param object The entity.
+	 * @param component The component.
+	 * @return The component, that is not attached until the commands are applied.
+	 */
+	Component *AddComponent(Entity *object, ComponentPtr &&component);
+
+	/**
+	 * Creates a component on the heap and records it to be added to a entity.
+	 * @tparam T The type of component to add.
+	 * @tparam Args The argument types.
+	 * @param object The entity.
+	 * @param args The type constructor arguments.
+	 * @return The component, that is not attached until the commands are applied.
+	 */
+	template<typename T, typename... Args>
+	T *AddComponent(Entity *object, Args &&... args) {
+		auto component = new T(std::forward<Args>(args)...);
+		AddComponent(object, ComponentPtr(component));
+		return component;
+	}
+
+	/**
+	 * Records a component to be removed from a entity.
+	 * @param object The entity.
+	 * @param component The component.
+	 */
+	void RemoveComponent(Entity *object, Component *component);
+
+	/**
+	 * Records a entity to be renamed, if a entity is renamed more than once the last name is used.
+	 * @param object The entity.
+	 * @param name The new name.
+	 */
+	void Rename(Entity *object, const std::string &name);
+
+	/**
+	 * Records a entity to be moved to another structure.
+	 * @param object The entity.
+	 * @param structure The structure to move to.
+	 */
+	void Move(Entity *object, SceneStructure &structure);
+
+	/**
+	 * Gets if there are no recorded commands.
+	 * @return If the buffer is empty.
+	 */
+	bool IsEmpty();
+
+private:
+	std::mutex m_mutex;
+	std::vector<std::unique_ptr<Entity>> m_created;
+	std::vector<std::pair<Entity *, ComponentPtr>> m_addedComponents;
+	std::vector<std::pair<Entity *, Component *>> m_removedComponents;
+	std::vector<std::pair<Entity *, std::string>> m_renamed;
+	std::vector<std::pair<Entity *, SceneStructure *>> m_moved;
+	std::vector<Entity *> m_destroyed;
+	std::vector<EntityHandle> m_destroyedHandles;
+};
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "StdAfx.hpp"
+
+namespace acid {
+/**
+ * @brief A stable reference to a entity in a structure, that can be checked after the entity is destroyed.
+ * The index is a slot in the structure, the generation changes each time the slot is reused, so a handle to a destroyed entity never
+ * finds the entity that took its place. Handles are only valid in the structure that created them.
+ */
+class ACID_EXPORT EntityHandle {
+public:
+	EntityHandle() = default;
+
+	EntityHandle(uint32_t index, uint32_t generation) :
+		m_index(index),
+		m_generation(generation) {
+	}
+
+	uint32_t GetIndex() const { return m_index; }
+	uint32_t GetGeneration() const { return m_generation; }
+
+	/**
+	 * Gets if this handle was given to a entity, it may still be dangling.
+	 * @return If the handle is not null.
+	 */
+	explicit operator bool() const { return m_generation != 0; }
+
+	bool operator==(const EntityHandle &other) const { return m_index == other.m_index && m_generation == other.m_generation; }
+	bool operator!=(const EntityHandle &other) const { return !operator==(other); }
+
+private:
+	uint32_t m_index = 0;
+	// Zero is never used by a slot, so default handles are null.
+	uint32_t m_generation = 0;
+};
+}
+
+namespace std {
+template<>
+struct hash<acid::EntityHandle> {
+	size_t operator()(const acid::EntityHandle &handle) const noexcept {
+		return hash<uint64_t>()(static_cast<uint64_t>(handle.GetGeneration()) << 32 | handle.GetIndex());
+	}
+};
+}
@@ -10,12 +10,16 @@
 
 namespace acid {
 std::shared_ptr<EntityPrefab> EntityPrefab::Create(const Node &node) {
-	if (auto resource = Resources::Get()->Find(node)) {
-		return std::dynamic_pointer_cast<EntityPrefab>(resource);
+	if (auto resource = Resources::Get()->Find<EntityPrefab>(node)) {
+		return resource;
 	}
 
 	auto result = std::make_shared<EntityPrefab>("");
-	Resources::Get()->Add(node, std::dynamic_pointer_cast<Resource>(result));
+
+	if (auto resource = Resources::Get()->FindOrAdd(node, result); resource != result) {
+		return resource;
+	}
+
 	node >> *result;
 	result->Load();
 	return result;
@@ -36,30 +40,59 @@ EntityPrefab::EntityPrefab(std::filesystem::path filename, bool load) :
 }
 
 void EntityPrefab::Load() {
+	ACID_PROFILE_SCOPE("EntityPrefab::Load");
+
 	if (m_filename.empty()) {
 		return;
 	}
 
+	if (auto resources = Resources::Get()) {
+		resources->AddDependency(*this, m_filename);
+	}
+
 	m_file = std::make_unique<File>(m_filename);
 	m_file->Load();
+	Compile();
 }
 
 void EntityPrefab::Write(Node::Format format) const {
 	m_file->Write(m_filename, format);
 }
 
-const EntityPrefab &operator>>(const EntityPrefab &entityPrefab, Entity &entity) {
-	for (const auto &property : entityPrefab.GetParent()->GetProperties()) {
+void EntityPrefab::Instantiate(Entity &entity) const {
+	for (const auto &[component, node] : m_templates) {
+		auto instance = component->Clone();
+
+		if (!instance) {
+			instance = Component::Create(node->GetName());
+			*node >> *instance;
+		}
+
+		entity.AddComponent(std::move(instance));
+	}
+}
+
+void EntityPrefab::Compile() {
+	m_templates.clear();
+
+	if (!m_file) {
+		return;
+	}
+
+	for (const auto &property : m_file->GetNode()->GetProperties()) {
 		if (property.GetName().empty()) {
 			continue;
 		}
 
 		if (auto component = Component::Create(property.GetName())) {
 			property >> *component;
-			entity.AddComponent(std::move(component));
+			m_templates.push_back({std::move(component), &property});
 		}
 	}
+}
 
+const EntityPrefab &operator>>(const EntityPrefab &entityPrefab, Entity &entity) {
+	entityPrefab.Instantiate(entity);
 	return entityPrefab;
 }
 
@@ -77,6 +110,7 @@ EntityPrefab &operator<<(EntityPrefab &entityPrefab, const Entity &entity) {
 		property << *component;
 	}
 
+	entityPrefab.Compile();
 	return entityPrefab;
 }
 
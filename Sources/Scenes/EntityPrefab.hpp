@@ -3,12 +3,15 @@
 #include "Files/File.hpp"
 #include "Files/Node.hpp"
 #include "Resources/Resource.hpp"
+#include "Component.hpp"
 
 namespace acid {
 class Entity;
 
 /**
  * @brief Resource that represents a entity prefab.
+ * When loaded each component in the file is decoded once into a template, instances copy the templates with {@link Component#Clone},
+ * components that can't be cloned are decoded from their already parsed node.
  */
 class ACID_EXPORT EntityPrefab : public Resource {
 public:
@@ -36,6 +39,23 @@ public:
 	void Load();
 	void Write(Node::Format format = Node::Format::Minified) const;
 
+	/**
+	 * Reloads this prefab from its file, entities instantiated after this are given the changed components.
+	 */
+	void Reload() override { Load(); }
+
+	/**
+	 * Adds a copy of each component in this prefab to a entity.
+	 * @param entity The entity to add the components to.
+	 */
+	void Instantiate(Entity &entity) const;
+
+	/**
+	 * Gets the number of components each instance is given.
+	 * @return The number of components.
+	 */
+	std::size_t GetComponentCount() const { return m_templates.size(); }
+
 	const std::filesystem::path &GetFilename() const { return m_filename; }
 	Node *GetParent() const { return m_file->GetNode(); }
 
@@ -45,7 +65,21 @@ public:
 	friend Node &operator<<(Node &node, const EntityPrefab &entityPrefab);
 
 private:
+	/**
+	 * @brief A component decoded from the prefab, and the node it was decoded from.
+	 */
+	struct ComponentTemplate {
+		std::unique_ptr<Component> m_component;
+		const Node *m_node;
+	};
+
+	/**
+	 * Decodes the templates from the prefab's file, called whenever the file changes.
+	 */
+	void Compile();
+
 	std::filesystem::path m_filename;
 	std::unique_ptr<File> m_file;
+	std::vector<ComponentTemplate> m_templates;
 };
 }
@@ -14,10 +14,11 @@ public:
 	/**
 	 * Creates a new scene.
 	 * @param camera The scenes camera.
+	 * @param storage Where components added to entities in the scene are allocated.
 	 */
-	explicit Scene(std::unique_ptr<Camera> &&camera) :
+	explicit Scene(std::unique_ptr<Camera> &&camera, SceneStructure::Storage storage = SceneStructure::Storage::Heap) :
 		m_camera(std::move(camera)),
-		m_structure(std::make_unique<SceneStructure>()),
+		m_structure(std::make_unique<SceneStructure>(storage)),
 		m_physics(std::make_unique<ScenePhysics>()) {
 	}
 
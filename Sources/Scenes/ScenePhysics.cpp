@@ -51,7 +51,14 @@ ScenePhysics::~ScenePhysics() {
 }
 
 void ScenePhysics::Update() {
-	m_dynamicsWorld->stepSimulation(Engine::Get()->GetDelta().AsSeconds());
+	auto delta = Engine::Get()->GetDelta().AsSeconds();
+
+	if (Engine::Get()->IsFixedTimestep()) {
+		// Exactly one internal step per engine step, the engine already accumulates and interpolates.
+		m_dynamicsWorld->stepSimulation(delta, 1, delta);
+	} else {
+		m_dynamicsWorld->stepSimulation(delta);
+	}
 	CheckForCollisionEvents();
 }
 
@@ -0,0 +1,316 @@
+#include "SceneSnapshot.hpp"
+
+#include <fstream>
+#include "Engine/Log.hpp"
+#include "SceneStructure.hpp"
+
+namespace acid {
+static void WriteUint32(std::vector<std::byte> &buffer, uint32_t value) {
+	auto offset = buffer.size();
+	buffer.resize(offset + sizeof(uint32_t));
+	std::memcpy(buffer.data() + offset, &value, sizeof(uint32_t));
+}
+
+/**
+ * @brief Gives each distinct string an index, in the order they are first seen.
+ */
+class StringTable {
+public:
+	uint32_t Add(const std::string &string) {
+		auto [it, inserted] = m_indices.try_emplace(string, static_cast<uint32_t>(m_strings.size()));
+
+		if (inserted) {
+			m_strings.emplace_back(&it->first);
+		}
+
+		return it->second;
+	}
+
+	const std::vector<const std::string *> &GetStrings() const { return m_strings; }
+
+private:
+	std::unordered_map<std::string, uint32_t> m_indices;
+	std::vector<const std::string *> m_strings;
+};
+
+static void WriteNode(std::vector<std::byte> &buffer, StringTable &strings, const Node &node) {
+	buffer.emplace_back(static_cast<std::byte>(node.GetType()));
+	WriteUint32(buffer, strings.Add(node.GetName()));
+	WriteUint32(buffer, strings.Add(node.GetValue()));
+	WriteUint32(buffer, static_cast<uint32_t>(node.GetProperties().size()));
+
+	for (const auto &property : node.GetProperties()) {
+		WriteNode(buffer, strings, property);
+	}
+}
+
+/**
+ * @brief Reads values from a buffer, reading past the end marks the reader failed and returns zeros.
+ */
+class SnapshotReader {
+public:
+	SnapshotReader(const std::byte *data, std::size_t size, std::size_t offset, const std::vector<std::string_view> &strings) :
+		m_data(data),
+		m_size(size),
+		m_offset(offset),
+		m_strings(strings) {
+	}
+
+	uint32_t ReadUint32() {
+		uint32_t value = 0;
+
+		if (m_offset + sizeof(uint32_t) > m_size) {
+			m_failed = true;
+			return value;
+		}
+
+		std::memcpy(&value, m_data + m_offset, sizeof(uint32_t));
+		m_offset += sizeof(uint32_t);
+		return value;
+	}
+
+	std::string_view ReadString() {
+		auto index = ReadUint32();
+
+		if (index >= m_strings.size()) {
+			m_failed = true;
+			return {};
+		}
+
+		return m_strings[index];
+	}
+
+	bool ReadNode(Node &node, uint32_t depth = 0) {
+		// Nodes from a damaged buffer could nest deep enough to overflow the stack.
+		if (m_offset >= m_size || depth > MaxDepth) {
+			m_failed = true;
+			return false;
+		}
+
+		auto type = static_cast<Node::Type>(m_data[m_offset++]);
+		node.SetType(type);
+		node.SetName(std::string(ReadString()));
+		node.SetValue(std::string(ReadString()));
+		auto count = ReadUint32();
+
+		// Every node takes at least 13 bytes, so a count larger than the bytes left is damaged.
+		if (m_failed || count > (m_size - m_offset) / 13) {
+			m_failed = true;
+			return false;
+		}
+
+		node.GetProperties().resize(count);
+
+		for (auto &property : node.GetProperties()) {
+			if (!ReadNode(property, depth + 1)) {
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	bool IsFailed() const { return m_failed; }
+
+private:
+	static constexpr uint32_t MaxDepth = 256;
+
+	const std::byte *m_data;
+	std::size_t m_size;
+	std::size_t m_offset;
+	const std::vector<std::string_view> &m_strings;
+	bool m_failed = false;
+};
+
+SceneSnapshot::SceneSnapshot(SceneStructure &structure) {
+	auto entities = structure.QueryAll();
+	m_entities.reserve(entities.size());
+
+	for (auto entity : entities) {
+		auto &captured = m_entities.emplace_back();
+		captured.m_name = entity->GetName();
+		captured.m_components.reserve(entity->GetComponents().size());
+
+		for (const auto &component : entity->GetComponents()) {
+			auto name = component->GetTypeName();
+
+			if (component->IsRemoved() || name.empty()) {
+				continue;
+			}
+
+			auto &capturedComponent = captured.m_components.emplace_back();
+			capturedComponent.m_name = std::move(name);
+
+			// Copies are encoded later on the writing thread, other components are encoded now while they can't change.
+			if (!(capturedComponent.m_component = component->Clone())) {
+				capturedComponent.m_node << *component;
+			}
+		}
+	}
+}
+
+std::vector<std::byte> SceneSnapshot::Encode() const {
+	std::vector<std::byte> nodes;
+	std::vector<uint32_t> entityOffsets;
+	entityOffsets.reserve(m_entities.size() + 1);
+	StringTable strings;
+
+	for (const auto &entity : m_entities) {
+		entityOffsets.emplace_back(static_cast<uint32_t>(nodes.size()));
+		WriteUint32(nodes, strings.Add(entity.m_name));
+		WriteUint32(nodes, static_cast<uint32_t>(entity.m_components.size()));
+
+		for (const auto &component : entity.m_components) {
+			if (component.m_component) {
+				Node node;
+				node << *component.m_component;
+				node.SetName(component.m_name);
+				WriteNode(nodes, strings, node);
+			} else {
+				auto node = component.m_node;
+				node.SetName(component.m_name);
+				WriteNode(nodes, strings, node);
+			}
+		}
+	}
+
+	entityOffsets.emplace_back(static_cast<uint32_t>(nodes.size()));
+
+	std::vector<std::byte> buffer(sizeof(Header));
+	Header header = {};
+	header.m_magic = Magic;
+	header.m_version = Version;
+
+	header.m_stringCount = static_cast<uint32_t>(strings.GetStrings().size());
+	header.m_stringsOffset = static_cast<uint32_t>(buffer.size());
+	uint32_t stringOffset = 0;
+
+	for (auto string : strings.GetStrings()) {
+		WriteUint32(buffer, stringOffset);
+		stringOffset += static_cast<uint32_t>(string->size());
+	}
+
+	WriteUint32(buffer, stringOffset);
+
+	for (auto string : strings.GetStrings()) {
+		auto offset = buffer.size();
+		buffer.resize(offset + string->size());
+		std::memcpy(buffer.data() + offset, string->data(), string->size());
+	}
+
+	// Aligns the entity offsets for readers that access them in place.
+	buffer.resize((buffer.size() + alignof(uint32_t) - 1) / alignof(uint32_t) * alignof(uint32_t));
+	header.m_entityCount = static_cast<uint32_t>(m_entities.size());
+	header.m_entitiesOffset = static_cast<uint32_t>(buffer.size());
+	auto nodesOffset = static_cast<uint32_t>(buffer.size() + entityOffsets.size() * sizeof(uint32_t));
+
+	for (auto offset : entityOffsets) {
+		WriteUint32(buffer, nodesOffset + offset);
+	}
+
+	buffer.insert(buffer.end(), nodes.begin(), nodes.end());
+	header.m_size = static_cast<uint32_t>(buffer.size());
+	std::memcpy(buffer.data(), &header, sizeof(Header));
+	return buffer;
+}
+
+bool SceneSnapshot::Write(const std::filesystem::path &filename) const {
+	auto buffer = Encode();
+
+	if (auto parentPath = filename.parent_path(); !parentPath.empty()) {
+		std::filesystem::create_directories(parentPath);
+	}
+
+	std::ofstream stream(filename, std::ios::binary);
+	stream.write(reinterpret_cast<const char *>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+	return static_cast<bool>(stream);
+}
+
+bool SceneSnapshot::Load(SceneStructure &structure, const std::byte *data, std::size_t size) {
+	Header header;
+
+	if (size < sizeof(Header)) {
+		Log::Error("Scene snapshot is too small\n");
+		return false;
+	}
+
+	std::memcpy(&header, data, sizeof(Header));
+
+	if (header.m_magic != Magic || header.m_version == 0 || header.m_version > Version || header.m_size > size) {
+		Log::Error("Scene snapshot has an unknown format or version ", header.m_version, "\n");
+		return false;
+	}
+
+	size = header.m_size;
+	auto stringsEnd = static_cast<std::size_t>(header.m_stringsOffset) + (static_cast<std::size_t>(header.m_stringCount) + 1) * sizeof(uint32_t);
+	auto entitiesEnd = static_cast<std::size_t>(header.m_entitiesOffset) + (static_cast<std::size_t>(header.m_entityCount) + 1) * sizeof(uint32_t);
+
+	if (stringsEnd > size || entitiesEnd > size) {
+		Log::Error("Scene snapshot is damaged\n");
+		return false;
+	}
+
+	// Strings are views into the buffer, only copied when put in a node.
+	std::vector<std::string_view> strings;
+	strings.reserve(header.m_stringCount);
+	SnapshotReader offsets(data, size, header.m_stringsOffset, strings);
+	auto previous = offsets.ReadUint32();
+
+	for (uint32_t i = 0; i < header.m_stringCount; i++) {
+		auto next = offsets.ReadUint32();
+
+		if (next < previous || stringsEnd + next > size) {
+			Log::Error("Scene snapshot is damaged\n");
+			return false;
+		}
+
+		strings.emplace_back(reinterpret_cast<const char *>(data + stringsEnd + previous), next - previous);
+		previous = next;
+	}
+
+	// Entities are decoded before any are added, so a damaged snapshot adds nothing.
+	std::vector<std::unique_ptr<Entity>> entities;
+	entities.reserve(header.m_entityCount);
+	SnapshotReader entityOffsets(data, size, header.m_entitiesOffset, strings);
+	Node node;
+
+	for (uint32_t i = 0; i < header.m_entityCount; i++) {
+		SnapshotReader reader(data, size, entityOffsets.ReadUint32(), strings);
+		auto &entity = entities.emplace_back(std::make_unique<Entity>());
+		entity->SetName(std::string(reader.ReadString()));
+		auto componentCount = reader.ReadUint32();
+
+		for (uint32_t j = 0; j < componentCount && reader.ReadNode(node); j++) {
+			if (auto component = Component::Create(node.GetName())) {
+				node >> *component;
+				entity->AddComponent(std::move(component));
+			}
+		}
+
+		if (reader.IsFailed()) {
+			Log::Error("Scene snapshot is damaged\n");
+			return false;
+		}
+	}
+
+	for (auto &entity : entities) {
+		structure.Add(std::move(entity));
+	}
+
+	return true;
+}
+
+bool SceneSnapshot::Load(SceneStructure &structure, const std::filesystem::path &filename) {
+	std::ifstream stream(filename, std::ios::binary | std::ios::ate);
+
+	if (!stream) {
+		Log::Error("Failed to open scene snapshot ", filename, '\n');
+		return false;
+	}
+
+	std::vector<std::byte> buffer(static_cast<std::size_t>(stream.tellg()));
+	stream.seekg(0);
+	stream.read(reinterpret_cast<char *>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+	return Load(structure, buffer.data(), buffer.size());
+}
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include "Files/Node.hpp"
+#include "Component.hpp"
+
+namespace acid {
+class SceneStructure;
+
+/**
+ * @brief A copy of every entity and component in a structure, saved to and loaded from one contiguous binary buffer.
+ * Capturing copies components with {@link Component#Clone}, which every engine component implements without creating GPU or audio objects.
+ * Components that can't be cloned are encoded to a {@link Node} on the capturing thread instead. Encoding may then run on any thread while
+ * the game keeps changing the structure. Components are stored as their node trees, so resources are
+ * referenced the same way as in prefabs. Every string is stored once in a table and nodes refer to strings by index, offsets are from the start
+ * of the buffer so a file can be loaded straight from mapped memory. Buffers are written in the machine's byte order.
+ */
+class ACID_EXPORT SceneSnapshot {
+public:
+	/// The first bytes of every snapshot.
+	static constexpr std::array<char, 4> Magic = {'A', 'S', 'N', 'P'};
+	/// The format version written, snapshots with a newer version are not loaded.
+	static constexpr uint32_t Version = 1;
+
+	/**
+	 * Captures every entity in a structure, must be called on the thread that updates the structure.
+	 * @param structure The structure to capture.
+	 */
+	explicit SceneSnapshot(SceneStructure &structure);
+
+	/**
+	 * Encodes the snapshot into a buffer, may be called from any thread.
+	 * @return The buffer.
+	 */
+	std::vector<std::byte> Encode() const;
+
+	/**
+	 * Encodes the snapshot and writes it to a file, may be called from any thread.
+	 * @param filename The file to write.
+	 * @return If the file was written.
+	 */
+	bool Write(const std::filesystem::path &filename) const;
+
+	/**
+	 * Creates the entities in a snapshot buffer and adds them to a structure.
+	 * @param structure The structure to add the entities to.
+	 * @param data The buffer, that does not need to outlive this call.
+	 * @param size The size of the buffer in bytes.
+	 * @return If the buffer was a valid snapshot, nothing is added if it is not.
+	 */
+	static bool Load(SceneStructure &structure, const std::byte *data, std::size_t size);
+
+	/**
+	 * Creates the entities in a snapshot file and adds them to a structure.
+	 * @param structure The structure to add the entities to.
+	 * @param filename The file to read.
+	 * @return If the file was a valid snapshot.
+	 */
+	static bool Load(SceneStructure &structure, const std::filesystem::path &filename);
+
+	std::size_t GetEntityCount() const { return m_entities.size(); }
+
+private:
+	/**
+	 * @brief The header at the start of a snapshot buffer.
+	 */
+	struct Header {
+		std::array<char, 4> m_magic;
+		uint32_t m_version;
+		// The size of the whole buffer.
+		uint32_t m_size;
+		// Followed by one more offset than strings, each string ends where the next begins.
+		uint32_t m_stringCount;
+		uint32_t m_stringsOffset;
+		// Followed by one more offset than entities, so each entity can be skipped or decoded on its own.
+		uint32_t m_entityCount;
+		uint32_t m_entitiesOffset;
+		uint32_t m_reserved;
+	};
+
+	/**
+	 * @brief A component copied when captured, or its encoded node if it can't be copied.
+	 */
+	struct CapturedComponent {
+		std::string m_name;
+		std::unique_ptr<Component> m_component;
+		Node m_node;
+	};
+
+	struct CapturedEntity {
+		std::string m_name;
+		std::vector<CapturedComponent> m_components;
+	};
+
+	std::vector<CapturedEntity> m_entities;
+};
+}
@@ -1,68 +1,276 @@
 #include "SceneStructure.hpp"
 
-#include "Physics/Rigidbody.hpp"
+#include "Engine/Engine.hpp"
+#include "Helpers/FrameAllocator.hpp"
+#include "Maths/Transform.hpp"
+#include "EntityPrefab.hpp"
 
 namespace acid {
-SceneStructure::SceneStructure() {
+SceneStructure::SceneStructure(Storage storage) :
+	m_storage(storage) {
+	if (m_storage == Storage::Pooled) {
+		m_pools = std::make_unique<ComponentPools>();
+	}
 }
 
 Entity *SceneStructure::GetEntity(const std::string &name) const {
-	for (auto &object : m_objects) {
-		if (object->GetName() == name) {
-			return object.get();
-		}
+	if (auto it = m_names.find(name); it != m_names.end()) {
+		return it->second.first;
 	}
 
 	return nullptr;
 }
 
+Entity *SceneStructure::GetEntity(const EntityHandle &handle) const {
+	if (handle.GetIndex() >= m_slots.size()) {
+		return nullptr;
+	}
+
+	auto &slot = m_slots[handle.GetIndex()];
+	return slot.m_generation == handle.GetGeneration() ? slot.m_entity : nullptr;
+}
+
 Entity *SceneStructure::CreateEntity() {
-	return m_objects.emplace_back(std::make_unique<Entity>()).get();
+	auto object = std::make_unique<Entity>();
+	auto result = object.get();
+	Add(std::move(object));
+	return result;
 }
 
 Entity *SceneStructure::CreateEntity(const std::string &filename) {
-	return m_objects.emplace_back(std::make_unique<Entity>(filename)).get();
+	auto object = std::make_unique<Entity>(filename);
+	auto result = object.get();
+	Add(std::move(object));
+	return result;
+}
+
+std::vector<Entity *> SceneStructure::Instantiate(const EntityPrefab &prefab, std::size_t count, const Transform *transforms) {
+	std::vector<Entity *> entities;
+	entities.reserve(count);
+
+	if (!m_deferring) {
+		m_objects.reserve(m_objects.size() + count);
+		m_slots.reserve(m_slots.size() + count);
+	}
+
+	Archetype *archetype = nullptr;
+
+	for (std::size_t i = 0; i < count; i++) {
+		auto object = std::make_unique<Entity>();
+		object->m_components.reserve(prefab.GetComponentCount() + 1);
+		prefab.Instantiate(*object);
+
+		if (transforms) {
+			if (auto transform = object->GetComponent<Transform>()) {
+				*transform = transforms[i];
+			} else {
+				object->AddComponent<Transform>(transforms[i]);
+			}
+		}
+
+		entities.emplace_back(object.get());
+		Add(std::move(object));
+
+		// Every instance has the same components, so the first instance's archetype has room made for the rest.
+		if (!archetype && entities.back()->m_archetype) {
+			archetype = entities.back()->m_archetype;
+			archetype->Reserve(archetype->GetSize() + count - 1);
+		}
+	}
+
+	return entities;
 }
 
 void SceneStructure::Add(Entity *object) {
-	m_objects.emplace_back(object);
+	Add(std::unique_ptr<Entity>(object));
 }
 
 void SceneStructure::Add(std::unique_ptr<Entity> object) {
-	m_objects.emplace_back(std::move(object));
+	if (m_deferring) {
+		m_commands.Add(std::move(object));
+		return;
+	}
+
+	object->m_index = m_objects.size();
+	Attach(m_objects.emplace_back(std::move(object)).get());
 }
 
 void SceneStructure::Remove(Entity *object) {
-	m_objects.erase(std::remove_if(m_objects.begin(), m_objects.end(), [object](std::unique_ptr<Entity> &e) {
-		return e.get() == object;
-	}), m_objects.end());
+	if (m_updating) {
+		m_commands.Destroy(object);
+		return;
+	}
+
+	if (object->m_structure == this) {
+		Detach(object->m_index);
+	}
 }
 
 void SceneStructure::Move(Entity *object, SceneStructure &structure) {
-	for (auto it = --m_objects.end(); it != m_objects.begin(); --it) {
-		if ((*it).get() != object) {
-			continue;
-		}
+	if (m_updating) {
+		m_commands.Move(object, structure);
+		return;
+	}
+
+	if (object->m_structure != this || &structure == this) {
+		return;
+	}
 
-		structure.Add(std::move(*it));
-		m_objects.erase(it);
+	// Pooled components stay in this structure's pools, which they keep alive.
+	if (object->m_archetype) {
+		object->m_archetype->Remove(object);
 	}
+
+	structure.Add(Detach(object->m_index));
 }
 
 void SceneStructure::Clear() {
+	{
+		// Recorded commands may point at the entities being cleared.
+		std::lock_guard<std::mutex> lock(m_commands.m_mutex);
+		m_commands.m_created.clear();
+		m_commands.m_addedComponents.clear();
+		m_commands.m_removedComponents.clear();
+		m_commands.m_renamed.clear();
+		m_commands.m_moved.clear();
+		m_commands.m_destroyed.clear();
+		m_commands.m_destroyedHandles.clear();
+	}
+
+	// Frees every slot so handles to the cleared entities stop resolving.
+	for (uint32_t i = 0; i < m_slots.size(); i++) {
+		if (m_slots[i].m_entity) {
+			m_slots[i].m_entity = nullptr;
+			m_slots[i].m_generation = std::max(m_slots[i].m_generation + 1, 1u);
+			m_freeSlots.emplace_back(i);
+		}
+	}
+
+	m_names.clear();
+	m_spatialTree.Clear();
 	m_objects.clear();
 }
 
 void SceneStructure::Update() {
-	for (auto it = m_objects.begin(); it != m_objects.end();) {
-		if ((*it)->IsRemoved()) {
-			it = m_objects.erase(it);
+	// Applies changes recorded since the last update.
+	Flush();
+
+	m_parallelComponents.clear();
+	m_updating = true;
+
+	// Indexed because a update may create entities.
+	for (std::size_t i = 0; i < m_objects.size(); i++) {
+		auto object = m_objects[i].get();
+
+		if (object->IsRemoved()) {
+			m_commands.Destroy(object);
 			continue;
 		}
 
-		(*it)->Update();
-		++it;
+		object->Update(&m_parallelComponents);
 	}
+
+	UpdateParallel();
+
+	for (std::size_t i = 0; i < m_objects.size(); i++) {
+		if (!m_objects[i]->IsRemoved()) {
+			m_objects[i]->LateUpdate();
+		}
+	}
+
+	m_updating = false;
+	Flush();
+}
+
+void SceneStructure::Flush() {
+	if (m_commands.IsEmpty()) {
+		return;
+	}
+
+	std::vector<std::unique_ptr<Entity>> created;
+	std::vector<std::pair<Entity *, ComponentPtr>> addedComponents;
+	std::vector<std::pair<Entity *, Component *>> removedComponents;
+	std::vector<std::pair<Entity *, std::string>> renamed;
+	std::vector<std::pair<Entity *, SceneStructure *>> moved;
+	std::vector<Entity *> destroyed;
+	std::vector<EntityHandle> destroyedHandles;
+
+	{
+		std::lock_guard<std::mutex> lock(m_commands.m_mutex);
+		std::swap(created, m_commands.m_created);
+		std::swap(addedComponents, m_commands.m_addedComponents);
+		std::swap(removedComponents, m_commands.m_removedComponents);
+		std::swap(renamed, m_commands.m_renamed);
+		std::swap(moved, m_commands.m_moved);
+		std::swap(destroyed, m_commands.m_destroyed);
+		std::swap(destroyedHandles, m_commands.m_destroyedHandles);
+	}
+
+	// Commands recorded while applying these, such as by component destructors, wait for the next sync point.
+	auto updating = m_updating;
+	m_updating = true;
+
+	for (auto &object : created) {
+		object->m_index = m_objects.size();
+		Attach(m_objects.emplace_back(std::move(object)).get());
+	}
+
+	// Entities with changed components are refreshed once each, after all of their changes.
+	std::pmr::vector<Entity *> changed(&FrameAllocator::Get());
+	changed.reserve(addedComponents.size() + removedComponents.size());
+
+	for (auto &[object, component] : addedComponents) {
+		object->InsertComponent(std::move(component));
+		changed.emplace_back(object);
+	}
+
+	for (auto &[object, component] : removedComponents) {
+		component->SetRemoved(true);
+		changed.emplace_back(object);
+	}
+
+	std::sort(changed.begin(), changed.end());
+	changed.erase(std::unique(changed.begin(), changed.end()), changed.end());
+
+	for (auto object : changed) {
+		object->CompactComponents();
+		object->UpdateArchetype();
+	}
+
+	// Renamed before moving, so the entity is indexed under its new name in the structure it moves to.
+	for (auto &[object, name] : renamed) {
+		object->SetName(name);
+	}
+
+	for (auto &[object, structure] : moved) {
+		if (object->m_structure != this || structure == this) {
+			continue;
+		}
+
+		if (object->m_archetype) {
+			object->m_archetype->Remove(object);
+		}
+
+		structure->Add(Detach(object->m_index));
+	}
+
+	// Handles to entities that were already destroyed resolve to null and are skipped.
+	for (const auto &handle : destroyedHandles) {
+		if (auto object = GetEntity(handle)) {
+			destroyed.emplace_back(object);
+		}
+	}
+
+	std::sort(destroyed.begin(), destroyed.end());
+	destroyed.erase(std::unique(destroyed.begin(), destroyed.end()), destroyed.end());
+
+	for (auto object : destroyed) {
+		if (object->m_structure == this) {
+			Detach(object->m_index);
+		}
+	}
+
+	m_updating = updating;
 }
 
 std::vector<Entity *> SceneStructure::QueryAll() {
@@ -79,41 +287,261 @@ std::vector<Entity *> SceneStructure::QueryAll() {
 	return entities;
 }
 
+void SceneStructure::UpdateTransforms() {
+	// The highest dirty transform of each changed subtree, every transform below it is dirty and no other root is inside it.
+	std::pmr::vector<Transform *> roots(&FrameAllocator::Get());
+	ForEach<Transform>([&roots](Transform &transform) {
+		if (transform.IsDirty() && (!transform.GetParent() || !transform.GetParent()->IsDirty())) {
+			roots.emplace_back(&transform);
+		}
+	}, true);
+
+	auto count = static_cast<uint32_t>(roots.size());
+
+	// Subtrees do not overlap and only read their clean parent, so they can be updated on separate threads.
+	if (auto engine = Engine::Get(); engine && count > TransformChunkSize) {
+		engine->GetJobSystem().ParallelFor(count, TransformChunkSize, [&roots](uint32_t begin, uint32_t end) {
+			for (auto i = begin; i < end; i++) {
+				roots[i]->UpdateHierarchy();
+			}
+		});
+	} else {
+		for (auto root : roots) {
+			root->UpdateHierarchy();
+		}
+	}
+}
+
+void SceneStructure::UpdateBounds() {
+	ForEach<Transform>([this](Transform &transform) {
+		auto object = transform.GetEntity();
+
+		if (object->m_spatialProxy == SpatialTree::NullNode) {
+			object->m_spatialProxy = m_spatialTree.Insert(object, transform.GetWorldMin(), transform.GetWorldMax());
+		} else if (transform.IsDirty() || transform.GetVersion() != object->m_boundsVersion) {
+			m_spatialTree.Move(object->m_spatialProxy, transform.GetWorldMin(), transform.GetWorldMax());
+		} else {
+			return;
+		}
+
+		// Read after the bounds, which recompute a dirty transform and change its version.
+		object->m_boundsVersion = transform.GetVersion();
+	}, true);
+}
+
 std::vector<Entity *> SceneStructure::QueryFrustum(const Frustum &range) {
 	std::vector<Entity *> entities;
+	m_spatialTree.QueryFrustum(range, [&entities](Entity *object) {
+		if (!object->IsRemoved()) {
+			entities.emplace_back(object);
+		}
+	});
+	return entities;
+}
 
-	for (const auto &object : m_objects) {
-		if (object->IsRemoved()) {
-			continue;
+std::vector<Entity *> SceneStructure::QuerySphere(const Vector3f &centre, float radius) {
+	std::vector<Entity *> entities;
+	m_spatialTree.QuerySphere(centre, radius, [&entities](Entity *object) {
+		if (!object->IsRemoved()) {
+			entities.emplace_back(object);
 		}
+	});
+	return entities;
+}
 
-		auto rigidbody = object->GetComponent<Rigidbody>();
+std::vector<Entity *> SceneStructure::QueryCube(const Vector3f &min, const Vector3f &max) {
+	std::vector<Entity *> entities;
+	m_spatialTree.QueryCube(min, max, [&entities](Entity *object) {
+		if (!object->IsRemoved()) {
+			entities.emplace_back(object);
+		}
+	});
+	return entities;
+}
 
-		if (!rigidbody || rigidbody->InFrustum(range)) {
-			entities.emplace_back(object.get());
+std::vector<Entity *> SceneStructure::QueryRay(const Vector3f &origin, const Vector3f &direction, float maxDistance) {
+	std::vector<Entity *> entities;
+	m_spatialTree.QueryRay(origin, direction, maxDistance, [&entities](Entity *object) {
+		if (!object->IsRemoved()) {
+			entities.emplace_back(object);
 		}
+	});
+	return entities;
+}
+
+void SceneStructure::RenameEntity(Entity *object, const std::string &name) {
+	RemoveName(object);
+	object->m_name = name;
+	AddName(object);
+}
+
+void SceneStructure::AddName(Entity *object) {
+	// Unnamed entities are not indexed.
+	if (object->m_name.empty()) {
+		return;
 	}
 
-	return entities;
+	auto [it, inserted] = m_names.try_emplace(object->m_name, object, object);
+
+	if (!inserted) {
+		auto &[first, last] = it->second;
+		last->m_nextNamed = object;
+		object->m_prevNamed = last;
+		last = object;
+	}
 }
 
-/*std::vector<Entity *> SceneStructure::QuerySphere(const Vector3 &centre, const Vector3 &radius)
-{
-	return {};
-}*/
+void SceneStructure::RemoveName(Entity *object) {
+	if (object->m_name.empty()) {
+		return;
+	}
 
-/*std::vector<Entity *> SceneStructure::QueryCube(const Vector3 &min, const Vector3 &max)
-{
-	return {};
-}*/
+	if (object->m_prevNamed) {
+		object->m_prevNamed->m_nextNamed = object->m_nextNamed;
+	}
 
-bool SceneStructure::Contains(Entity *object) {
-	for (const auto &object2 : m_objects) {
-		if (object2.get() == object) {
-			return true;
+	if (object->m_nextNamed) {
+		object->m_nextNamed->m_prevNamed = object->m_prevNamed;
+	}
+
+	if (auto it = m_names.find(object->m_name); it != m_names.end()) {
+		auto &[first, last] = it->second;
+
+		if (first == object) {
+			first = object->m_nextNamed;
+		}
+
+		if (last == object) {
+			last = object->m_prevNamed;
+		}
+
+		if (!first) {
+			m_names.erase(it);
+		}
+	}
+
+	object->m_prevNamed = nullptr;
+	object->m_nextNamed = nullptr;
+}
+
+std::unique_ptr<Entity> SceneStructure::Detach(std::size_t index) {
+	// Swaps the last entity into the removed position.
+	auto object = std::move(m_objects[index]);
+
+	auto &slot = m_slots[object->m_handle.GetIndex()];
+	slot.m_entity = nullptr;
+	// Zero is the null generation.
+	slot.m_generation = std::max(slot.m_generation + 1, 1u);
+	m_freeSlots.emplace_back(object->m_handle.GetIndex());
+	object->m_handle = {};
+	RemoveName(object.get());
+
+	if (object->m_spatialProxy != SpatialTree::NullNode) {
+		m_spatialTree.Remove(object->m_spatialProxy);
+		object->m_spatialProxy = SpatialTree::NullNode;
+	}
+
+	if (index != m_objects.size() - 1) {
+		m_objects[index] = std::move(m_objects.back());
+		m_objects[index]->m_index = index;
+	}
+
+	m_objects.pop_back();
+	return object;
+}
+
+void SceneStructure::Attach(Entity *object) {
+	object->m_structure = this;
+	object->m_pools = m_pools.get();
+
+	uint32_t slot;
+
+	if (!m_freeSlots.empty()) {
+		slot = m_freeSlots.back();
+		m_freeSlots.pop_back();
+	} else {
+		slot = static_cast<uint32_t>(m_slots.size());
+		m_slots.emplace_back();
+	}
+
+	m_slots[slot].m_entity = object;
+	object->m_handle = {slot, m_slots[slot].m_generation};
+	AddName(object);
+	UpdateArchetype(object);
+}
+
+void SceneStructure::UpdateArchetype(Entity *object) {
+	std::vector<TypeId> signature;
+	signature.reserve(object->m_components.size());
+
+	for (const auto &component : object->m_components) {
+		if (!component->IsRemoved()) {
+			signature.emplace_back(component->GetTypeId());
+		}
+	}
+
+	std::sort(signature.begin(), signature.end());
+	signature.erase(std::unique(signature.begin(), signature.end()), signature.end());
+
+	if (object->m_archetype) {
+		if (object->m_archetype->GetSignature() == signature) {
+			object->m_archetype->Refresh(object);
+			return;
 		}
+
+		object->m_archetype->Remove(object);
 	}
 
-	return false;
+	auto &archetype = m_archetypes[signature];
+
+	if (!archetype) {
+		archetype = std::make_unique<Archetype>(std::move(signature));
+		m_archetypeList.emplace_back(archetype.get());
+		archetype->Add(object);
+
+		for (auto &[type, view] : m_views) {
+			view->AddArchetype(archetype.get());
+		}
+	} else {
+		archetype->Add(object);
+	}
+
+	// Bounds come from the transform, so a entity that loses its transform leaves the spatial tree.
+	if (object->m_spatialProxy != SpatialTree::NullNode && !archetype->Contains<Transform>()) {
+		m_spatialTree.Remove(object->m_spatialProxy);
+		object->m_spatialProxy = SpatialTree::NullNode;
+	}
+}
+
+void SceneStructure::UpdateParallel() {
+	if (m_parallelComponents.empty()) {
+		return;
+	}
+
+	// Transforms changed by earlier updates are recomputed first, as a dirty transform recomputes its cache when read.
+	UpdateTransforms();
+
+	auto count = static_cast<uint32_t>(m_parallelComponents.size());
+	m_deferring = true;
+
+	// Small batches are not worth the cost of scheduling jobs, changes are still deferred so behaviour is the same either way.
+	if (auto engine = Engine::Get(); engine && count > ParallelChunkSize) {
+		engine->GetJobSystem().ParallelFor(count, ParallelChunkSize, [this](uint32_t begin, uint32_t end) {
+			for (auto i = begin; i < end; i++) {
+				m_parallelComponents[i]->Update();
+			}
+		});
+	} else {
+		for (auto component : m_parallelComponents) {
+			component->Update();
+		}
+	}
+
+	m_deferring = false;
+	Flush();
+}
+
+bool SceneStructure::Contains(Entity *object) {
+	return object && object->m_structure == this && object->m_index < m_objects.size() && m_objects[object->m_index].get() == object;
 }
 }
@@ -1,18 +1,54 @@
 #pragma once
 
 #include "Physics/Rigidbody.hpp"
+#include "Archetype.hpp"
 #include "Entity.hpp"
+#include "EntityCommandBuffer.hpp"
+#include "SpatialTree.hpp"
+#include "View.hpp"
 
 namespace acid {
+class EntityPrefab;
+class Transform;
+
 /**
  * @brief Class that represents a  structure of spatial objects.
+ * Entities in the structure are grouped into {@link Archetype} tables by their set of component types, queried through {@link SceneStructure#GetView}.
+ * Entities with a {@link Transform} are kept in a {@link SpatialTree} by their world bounds, queried by region through the spatial queries.
  */
 class ACID_EXPORT SceneStructure : public virtual NonCopyable {
+	friend class Entity;
 public:
-	SceneStructure();
+	/**
+	 * @brief Represents where components created with {@link Entity#AddComponent} are allocated.
+	 */
+	enum class Storage : uint8_t {
+		/// Each component is a separate heap allocation.
+		Heap,
+		/// Components are created in chunked pools per type, so components of a type are contiguous in memory.
+		Pooled
+	};
+
+	/**
+	 * Creates a new structure.
+	 * @param storage Where components created through entities in this structure are allocated.
+	 */
+	explicit SceneStructure(Storage storage = Storage::Heap);
 
+	/**
+	 * Gets a entity by name from a hashed index.
+	 * @param name The name of the entity.
+	 * @return The first entity added with the name, or null if there is none.
+	 */
 	Entity *GetEntity(const std::string &name) const;
 
+	/**
+	 * Gets the entity a handle refers to.
+	 * @param handle The handle.
+	 * @return The entity, or null if the entity has been destroyed or moved to another structure.
+	 */
+	Entity *GetEntity(const EntityHandle &handle) const;
+
 	/**
 	 * Creates a new entity.
 	 * @return The newly created entity.
@@ -26,6 +62,17 @@ public:
 	 */
 	Entity *CreateEntity(const std::string &filename);
 
+	/**
+	 * Creates many entities from a prefab at once, storage for the entities is reserved up front.
+	 * Each entity's components are added before it joins the structure, so it is placed in its archetype once.
+	 * @param prefab The prefab to copy components from.
+	 * @param count The number of entities to create.
+	 * @param transforms The local transform of each entity, count long, or null to keep the prefab's transform.
+	 * Entities are given a transform if the prefab has none.
+	 * @return The created entities.
+	 */
+	std::vector<Entity *> Instantiate(const EntityPrefab &prefab, std::size_t count, const Transform *transforms = nullptr);
+
 	/**
 	 * Adds a new object to the spatial structure.
 	 * @param object The object to add.
@@ -39,23 +86,49 @@ public:
 	void Add(std::unique_ptr<Entity> object);
 
 	/**
-	 * Removes an object from the spatial structure.
+	 * Removes an object from the spatial structure, the last object takes its place.
+	 * While the structure is updating the removal is recorded and applied at the next sync point.
 	 * @param object The object to remove.
 	 */
 	void Remove(Entity *object);
 
 	/**
 	 * Moves an object to another spatial structure.
+	 * While the structure is updating the move is recorded and applied at the next sync point.
 	 * @param object The object to move.
 	 * @param structure The structure to move to.
 	 */
 	void Move(Entity *object, SceneStructure &structure);
 
 	/**
-	 * Removes all objects from the spatial structure.
+	 * Removes all objects from the spatial structure, and discards any recorded commands.
 	 */
 	void Clear();
 
+	/**
+	 * Applies the commands recorded in {@link SceneStructure#GetCommands}.
+	 * Called at the sync points of {@link SceneStructure#Update}: before updating, after the parallel updates, and after the late updates.
+	 */
+	void Flush();
+
+	/**
+	 * Gets the buffer of changes to apply at the next sync point, changes can be recorded from any thread.
+	 * @return The command buffer.
+	 */
+	EntityCommandBuffer &GetCommands() { return m_commands; }
+
+	/**
+	 * Gets if removing and moving entities and removing components is being recorded instead of applied, because the structure is updating.
+	 * @return If removals are deferred.
+	 */
+	bool IsUpdating() const { return m_updating; }
+
+	/**
+	 * Gets if adding entities and components is being recorded too, because thread safe components are updating in parallel.
+	 * @return If structural changes are deferred.
+	 */
+	bool IsDeferring() const { return m_deferring; }
+
 	/**
 	 * Updates all of the entity.
 	 */
@@ -67,22 +140,100 @@ public:
 	 */
 	uint32_t GetSize() const { return static_cast<uint32_t>(m_objects.size()); }
 
+	Storage GetStorage() const { return m_storage; }
+
+	/**
+	 * Gets every archetype table in this structure, including archetypes that no longer have entities.
+	 * @return The archetypes.
+	 */
+	const std::vector<Archetype *> &GetArchetypes() const { return m_archetypeList; }
+
+	/**
+	 * Gets the cached view of every entity with a component of each type, creating it the first time it is used.
+	 * The view is owned by this structure and kept up to date as entities and components change.
+	 * @tparam Ts The component types.
+	 * @return The view.
+	 */
+	template<typename... Ts>
+	View<Ts...> &GetView() {
+		auto &view = m_views[std::type_index(typeid(View<Ts...>))];
+
+		if (!view) {
+			view = std::make_unique<View<Ts...>>(m_archetypeList);
+		}
+
+		return *static_cast<View<Ts...> *>(view.get());
+	}
+
+	/**
+	 * Calls a function for every entity that has a component of each type, with the entity's first component of each type.
+	 * Uses the view from {@link SceneStructure#GetView}, components must not be added or removed while iterating.
+	 * @tparam Ts The component types.
+	 * @tparam F The function type, called as {@code function(Ts &...)}.
+	 * @param function The function to call.
+	 * @param allowDisabled If disabled components will be included.
+	 */
+	template<typename... Ts, typename F>
+	void ForEach(F &&function, bool allowDisabled = false) {
+		GetView<Ts...>().ForEach(std::forward<F>(function), allowDisabled);
+	}
+
 	/**
 	 * Gets a set of all objects in the spatial structure.
 	 * @return The list specified by of all objects.
 	 */
 	std::vector<Entity *> QueryAll();
 
+	/**
+	 * Recomputes the world transforms that changed since the last call, so reads while rendering never walk up the hierarchy.
+	 * Called by the scenes module each frame, and before thread safe components are updated so they only read clean transforms.
+	 */
+	void UpdateTransforms();
+
+	/**
+	 * Moves entities with a changed transform to their new bounds in the spatial tree, and adds entities with a new transform.
+	 * Called by the scenes module each frame once world transforms are updated, other structures must call this before spatial queries.
+	 */
+	void UpdateBounds();
+
+	/**
+	 * Gets the tree of entity bounds, that can be queried with a callback instead of building a list.
+	 * @return The spatial tree.
+	 */
+	const SpatialTree &GetSpatialTree() const { return m_spatialTree; }
+
 	/**
 	 * Gets a set of all objects in a spatial objects contained in a frustum.
+	 * Only entities with a transform are found, by their bounds as of the last {@link SceneStructure#UpdateBounds}.
 	 * @param range The frustum range of space being queried.
 	 * @return The list of all object in range.
 	 */
 	std::vector<Entity *> QueryFrustum(const Frustum &range);
 
-	//std::vector<Entity *> QuerySphere(const Vector3 &centre, const Vector3 &radius);
+	/**
+	 * Gets a set of all objects with bounds that overlap a sphere.
+	 * @param centre The centre of the sphere.
+	 * @param radius The radius of the sphere.
+	 * @return The list of all object in range.
+	 */
+	std::vector<Entity *> QuerySphere(const Vector3f &centre, float radius);
 
-	//std::vector<Entity *> QueryCube(const Vector3 &min, const Vector3 &max);
+	/**
+	 * Gets a set of all objects with bounds that overlap a box.
+	 * @param min The minimum corner of the box.
+	 * @param max The maximum corner of the box.
+	 * @return The list of all object in range.
+	 */
+	std::vector<Entity *> QueryCube(const Vector3f &min, const Vector3f &max);
+
+	/**
+	 * Gets a set of all objects with bounds that a ray passes through, in no particular order.
+	 * @param origin The start of the ray.
+	 * @param direction The direction of the ray.
+	 * @param maxDistance How far along the ray to search, in lengths of the direction.
+	 * @return The list of all object hit.
+	 */
+	std::vector<Entity *> QueryRay(const Vector3f &origin, const Vector3f &direction, float maxDistance);
 
 	/**
 	 * Returns a set of all components of a type in the spatial structure.
@@ -94,10 +245,16 @@ public:
 	std::vector<T *> QueryComponents(bool allowDisabled = false) {
 		std::vector<T *> components;
 
-		for (auto it = m_objects.begin(); it != m_objects.end(); ++it) {
-			for (const auto &component : (*it)->GetComponents<T>()) {
-				if (component && (component->IsEnabled() || allowDisabled)) {
-					components.emplace_back(component);
+		for (auto archetype : m_archetypeList) {
+			if (archetype->GetSize() == 0 || !archetype->template Contains<T>()) {
+				continue;
+			}
+
+			for (auto entity : archetype->GetEntities()) {
+				for (const auto &component : entity->GetComponents()) {
+					if (auto casted = Component::Cast<T>(component.get()); casted && (component->IsEnabled() || allowDisabled)) {
+						components.emplace_back(casted);
+					}
 				}
 			}
 		}
@@ -113,11 +270,17 @@ public:
 	 */
 	template<typename T>
 	T *GetComponent(bool allowDisabled = false) {
-		for (auto it = m_objects.begin(); it != m_objects.end(); ++it) {
-			auto component = (*it)->GetComponent<T>();
+		for (auto archetype : m_archetypeList) {
+			if (archetype->GetSize() == 0 || !archetype->template Contains<T>()) {
+				continue;
+			}
+
+			for (auto entity : archetype->GetEntities()) {
+				auto component = entity->GetComponent<T>();
 
-			if (component && (component->IsEnabled() || allowDisabled)) {
-				return component;
+				if (component && (component->IsEnabled() || allowDisabled)) {
+					return component;
+				}
 			}
 		}
 
@@ -126,12 +289,84 @@ public:
 
 	/**
 	 * If the structure contains the object.
-	 * @param object The object to check for.
+	 * @param object The object to check for, that must not have been destroyed. Use a handle if it may have been.
 	 * @return If the structure contains the object.
 	 */
 	bool Contains(Entity *object);
 
+	/**
+	 * If the structure contains the entity a handle refers to.
+	 * @param handle The handle.
+	 * @return If the entity is alive and in this structure.
+	 */
+	bool Contains(const EntityHandle &handle) const { return GetEntity(handle) != nullptr; }
+
 private:
+	/**
+	 * Starts tracking a entity that was added to this structure.
+	 * @param object The entity.
+	 */
+	void Attach(Entity *object);
+
+	/**
+	 * Moves a entity to the archetype matching its current components.
+	 * @param object The entity.
+	 */
+	void UpdateArchetype(Entity *object);
+
+	/**
+	 * Renames a entity and moves it in the name index.
+	 * @param object The entity.
+	 * @param name The new name.
+	 */
+	void RenameEntity(Entity *object, const std::string &name);
+
+	void AddName(Entity *object);
+	void RemoveName(Entity *object);
+
+	/**
+	 * Takes a entity out of the list by swapping the last entity into its place, and frees its handle.
+	 * @param index The index of the entity.
+	 * @return The entity.
+	 */
+	std::unique_ptr<Entity> Detach(std::size_t index);
+
+	/**
+	 * Runs the updates of thread safe components, split into chunks on the engine's job system.
+	 */
+	void UpdateParallel();
+
+	/// The number of thread safe components updated by each job.
+	static constexpr uint32_t ParallelChunkSize = 128;
+	/// The number of changed transform subtrees updated by each job.
+	static constexpr uint32_t TransformChunkSize = 64;
+
+	Storage m_storage;
+	std::unique_ptr<ComponentPools> m_pools;
+	// Declared before the objects so entities leave their archetypes before the archetypes are destroyed.
+	std::map<std::vector<TypeId>, std::unique_ptr<Archetype>> m_archetypes;
+	std::vector<Archetype *> m_archetypeList;
+	std::unordered_map<std::type_index, std::unique_ptr<ViewBase>> m_views;
 	std::vector<std::unique_ptr<Entity>> m_objects;
+
+	/**
+	 * @brief A slot in the handle map, the generation changes each time the slot is freed.
+	 */
+	struct Slot {
+		Entity *m_entity = nullptr;
+		uint32_t m_generation = 1;
+	};
+
+	std::vector<Slot> m_slots;
+	std::vector<uint32_t> m_freeSlots;
+	// The first and last entity with each name, entities with the same name are linked between them.
+	std::unordered_map<std::string, std::pair<Entity *, Entity *>> m_names;
+	SpatialTree m_spatialTree;
+
+	EntityCommandBuffer m_commands;
+	// Reused each update, so collecting thread safe components does not allocate.
+	std::vector<Component *> m_parallelComponents;
+	bool m_updating = false;
+	bool m_deferring = false;
 };
 }
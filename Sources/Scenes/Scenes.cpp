@@ -1,5 +1,7 @@
 #include "Scenes.hpp"
 
+#include "Maths/Transform.hpp"
+
 namespace acid {
 Scenes::Scenes() {
 }
@@ -14,11 +16,20 @@ void Scenes::Update() {
 		m_scene->m_started = true;
 	}
 
+	// Snapshots transforms before they are stepped, so rendering can interpolate towards the new state.
+	if (Engine::Get()->IsFixedTimestep() && m_scene->GetStructure()) {
+		m_scene->GetStructure()->ForEach<Transform>([](Transform &transform) {
+			transform.StoreSnapshot();
+		}, true);
+	}
+
 	m_scene->Update();
 	m_scene->GetPhysics()->Update();
 
 	if (m_scene->GetStructure()) {
 		m_scene->GetStructure()->Update();
+		m_scene->GetStructure()->UpdateTransforms();
+		m_scene->GetStructure()->UpdateBounds();
 	}
 
 	if (m_scene->GetCamera()) {
@@ -0,0 +1,271 @@
+#include "SpatialTree.hpp"
+
+namespace acid {
+static float SurfaceArea(const Vector3f &min, const Vector3f &max) {
+	auto size = max - min;
+	return 2.0f * (size.m_x * size.m_y + size.m_y * size.m_z + size.m_z * size.m_x);
+}
+
+SpatialTree::SpatialTree(float margin) :
+	m_margin(margin) {
+}
+
+int32_t SpatialTree::Insert(Entity *entity, const Vector3f &min, const Vector3f &max) {
+	auto proxy = AllocateNode();
+	auto &node = m_nodes[proxy];
+	node.m_min = min - m_margin;
+	node.m_max = max + m_margin;
+	node.m_entity = entity;
+	node.m_height = 0;
+	InsertLeaf(proxy);
+	m_size++;
+	return proxy;
+}
+
+void SpatialTree::Remove(int32_t proxy) {
+	RemoveLeaf(proxy);
+	FreeNode(proxy);
+	m_size--;
+}
+
+bool SpatialTree::Move(int32_t proxy, const Vector3f &min, const Vector3f &max) {
+	auto &node = m_nodes[proxy];
+
+	if (node.m_min.m_x <= min.m_x && node.m_min.m_y <= min.m_y && node.m_min.m_z <= min.m_z &&
+		max.m_x <= node.m_max.m_x && max.m_y <= node.m_max.m_y && max.m_z <= node.m_max.m_z) {
+		return false;
+	}
+
+	RemoveLeaf(proxy);
+	node.m_min = min - m_margin;
+	node.m_max = max + m_margin;
+	InsertLeaf(proxy);
+	return true;
+}
+
+void SpatialTree::Clear() {
+	m_nodes.clear();
+	m_root = NullNode;
+	m_free = NullNode;
+	m_size = 0;
+}
+
+float SpatialTree::SquaredDistance(const Node &node, const Vector3f &point) {
+	float distance = 0.0f;
+
+	for (uint32_t i = 0; i < 3; i++) {
+		auto offset = std::max({node.m_min[i] - point[i], 0.0f, point[i] - node.m_max[i]});
+		distance += offset * offset;
+	}
+
+	return distance;
+}
+
+bool SpatialTree::Overlaps(const Node &node, const Vector3f &min, const Vector3f &max) {
+	return node.m_min.m_x <= max.m_x && min.m_x <= node.m_max.m_x && node.m_min.m_y <= max.m_y && min.m_y <= node.m_max.m_y &&
+		node.m_min.m_z <= max.m_z && min.m_z <= node.m_max.m_z;
+}
+
+bool SpatialTree::RayHits(const Node &node, const Vector3f &origin, const Vector3f &inverse, float maxDistance) {
+	float enter = 0.0f;
+	float exit = maxDistance;
+
+	for (uint32_t i = 0; i < 3; i++) {
+		auto t0 = (node.m_min[i] - origin[i]) * inverse[i];
+		auto t1 = (node.m_max[i] - origin[i]) * inverse[i];
+
+		if (t0 > t1) {
+			std::swap(t0, t1);
+		}
+
+		// A ray parallel to a slab starting on its plane gives NaN, that is treated as a hit by the comparisons.
+		enter = t0 > enter ? t0 : enter;
+		exit = t1 < exit ? t1 : exit;
+
+		if (enter > exit) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+int32_t SpatialTree::AllocateNode() {
+	if (m_free == NullNode) {
+		m_nodes.emplace_back();
+		return static_cast<int32_t>(m_nodes.size() - 1);
+	}
+
+	auto index = m_free;
+	m_free = m_nodes[index].m_parent;
+	m_nodes[index] = {};
+	return index;
+}
+
+void SpatialTree::FreeNode(int32_t index) {
+	auto &node = m_nodes[index];
+	node.m_entity = nullptr;
+	node.m_left = NullNode;
+	node.m_right = NullNode;
+	node.m_height = -1;
+	node.m_parent = m_free;
+	m_free = index;
+}
+
+void SpatialTree::InsertLeaf(int32_t leaf) {
+	if (m_root == NullNode) {
+		m_root = leaf;
+		m_nodes[leaf].m_parent = NullNode;
+		return;
+	}
+
+	auto leafMin = m_nodes[leaf].m_min;
+	auto leafMax = m_nodes[leaf].m_max;
+
+	// Walks down to the sibling where adding the leaf costs the least surface area.
+	auto index = m_root;
+
+	while (!m_nodes[index].IsLeaf()) {
+		const auto &node = m_nodes[index];
+		auto area = SurfaceArea(node.m_min, node.m_max);
+		auto combinedArea = SurfaceArea(node.m_min.Min(leafMin), node.m_max.Max(leafMax));
+
+		// Cost of making a new parent for this node and the leaf, and the cost pushed down to the children.
+		auto cost = 2.0f * combinedArea;
+		auto inheritanceCost = 2.0f * (combinedArea - area);
+
+		auto ChildCost = [&](int32_t child) {
+			const auto &childNode = m_nodes[child];
+			auto childArea = SurfaceArea(childNode.m_min.Min(leafMin), childNode.m_max.Max(leafMax));
+
+			if (childNode.IsLeaf()) {
+				return childArea + inheritanceCost;
+			}
+
+			return childArea - SurfaceArea(childNode.m_min, childNode.m_max) + inheritanceCost;
+		};
+
+		auto leftCost = ChildCost(node.m_left);
+		auto rightCost = ChildCost(node.m_right);
+
+		if (cost < leftCost && cost < rightCost) {
+			break;
+		}
+
+		index = leftCost < rightCost ? node.m_left : node.m_right;
+	}
+
+	auto sibling = index;
+	auto oldParent = m_nodes[sibling].m_parent;
+	auto newParent = AllocateNode();
+	// Allocating may move the nodes, so references are only taken after.
+	m_nodes[newParent].m_parent = oldParent;
+	m_nodes[newParent].m_left = sibling;
+	m_nodes[newParent].m_right = leaf;
+	m_nodes[sibling].m_parent = newParent;
+	m_nodes[leaf].m_parent = newParent;
+
+	if (oldParent == NullNode) {
+		m_root = newParent;
+	} else if (m_nodes[oldParent].m_left == sibling) {
+		m_nodes[oldParent].m_left = newParent;
+	} else {
+		m_nodes[oldParent].m_right = newParent;
+	}
+
+	Refit(newParent);
+}
+
+void SpatialTree::RemoveLeaf(int32_t leaf) {
+	if (leaf == m_root) {
+		m_root = NullNode;
+		return;
+	}
+
+	auto parent = m_nodes[leaf].m_parent;
+	auto grandParent = m_nodes[parent].m_parent;
+	auto sibling = m_nodes[parent].m_left == leaf ? m_nodes[parent].m_right : m_nodes[parent].m_left;
+
+	FreeNode(parent);
+
+	if (grandParent == NullNode) {
+		m_root = sibling;
+		m_nodes[sibling].m_parent = NullNode;
+		return;
+	}
+
+	if (m_nodes[grandParent].m_left == parent) {
+		m_nodes[grandParent].m_left = sibling;
+	} else {
+		m_nodes[grandParent].m_right = sibling;
+	}
+
+	m_nodes[sibling].m_parent = grandParent;
+	Refit(grandParent);
+}
+
+int32_t SpatialTree::Balance(int32_t index) {
+	auto &a = m_nodes[index];
+
+	if (a.IsLeaf()) {
+		return index;
+	}
+
+	auto balance = m_nodes[a.m_right].m_height - m_nodes[a.m_left].m_height;
+
+	if (balance >= -1 && balance <= 1) {
+		return index;
+	}
+
+	// Promotes the taller child, and gives the node the shorter grandchild.
+	auto tallIndex = balance > 1 ? a.m_right : a.m_left;
+	auto &tall = m_nodes[tallIndex];
+	auto keepIndex = m_nodes[tall.m_left].m_height > m_nodes[tall.m_right].m_height ? tall.m_left : tall.m_right;
+	auto giveIndex = keepIndex == tall.m_left ? tall.m_right : tall.m_left;
+
+	tall.m_parent = a.m_parent;
+	a.m_parent = tallIndex;
+
+	if (tall.m_parent == NullNode) {
+		m_root = tallIndex;
+	} else if (m_nodes[tall.m_parent].m_left == index) {
+		m_nodes[tall.m_parent].m_left = tallIndex;
+	} else {
+		m_nodes[tall.m_parent].m_right = tallIndex;
+	}
+
+	if (keepIndex == tall.m_left) {
+		tall.m_right = index;
+	} else {
+		tall.m_left = index;
+	}
+
+	if (tallIndex == a.m_right) {
+		a.m_right = giveIndex;
+	} else {
+		a.m_left = giveIndex;
+	}
+
+	m_nodes[giveIndex].m_parent = index;
+	Combine(index);
+	Combine(tallIndex);
+	return tallIndex;
+}
+
+void SpatialTree::Refit(int32_t index) {
+	while (index != NullNode) {
+		index = Balance(index);
+		Combine(index);
+		index = m_nodes[index].m_parent;
+	}
+}
+
+void SpatialTree::Combine(int32_t index) {
+	auto &node = m_nodes[index];
+	const auto &left = m_nodes[node.m_left];
+	const auto &right = m_nodes[node.m_right];
+	node.m_min = left.m_min.Min(right.m_min);
+	node.m_max = left.m_max.Max(right.m_max);
+	node.m_height = 1 + std::max(left.m_height, right.m_height);
+}
+}
@@ -0,0 +1,206 @@
+#pragma once
+
+#include "Helpers/FrameAllocator.hpp"
+#include "Maths/Vector3.hpp"
+#include "Physics/Frustum.hpp"
+
+namespace acid {
+class Entity;
+
+/**
+ * @brief A dynamic bounding volume tree of entity boxes, used to find entities in a region without visiting every entity.
+ * Each entity is a leaf holding its box grown by a margin, a box that moves inside its grown box needs no change to the tree.
+ * Leaves are inserted next to the sibling that grows the tree's surface area the least, and nodes are rotated to keep the tree balanced.
+ */
+class ACID_EXPORT SpatialTree {
+public:
+	/// The proxy of a entity that is not in the tree.
+	static constexpr int32_t NullNode = -1;
+
+	/**
+	 * Creates a new tree.
+	 * @param margin How far boxes are grown in each direction, so small movements do not change the tree.
+	 */
+	explicit SpatialTree(float margin = 0.1f);
+
+	/**
+	 * Inserts a entity's box.
+	 * @param entity The entity.
+	 * @param min The minimum corner of the box.
+	 * @param max The maximum corner of the box.
+	 * @return The proxy used to move and remove the box.
+	 */
+	int32_t Insert(Entity *entity, const Vector3f &min, const Vector3f &max);
+
+	/**
+	 * Removes a entity's box.
+	 * @param proxy The proxy from {@link SpatialTree#Insert}.
+	 */
+	void Remove(int32_t proxy);
+
+	/**
+	 * Moves a entity's box, the tree only changes if the box leaves its grown box.
+	 * @param proxy The proxy from {@link SpatialTree#Insert}.
+	 * @param min The minimum corner of the box.
+	 * @param max The maximum corner of the box.
+	 * @return If the box was reinserted.
+	 */
+	bool Move(int32_t proxy, const Vector3f &min, const Vector3f &max);
+
+	/**
+	 * Removes every box.
+	 */
+	void Clear();
+
+	Entity *GetEntity(int32_t proxy) const { return m_nodes[proxy].m_entity; }
+
+	/**
+	 * Gets the number of boxes in the tree.
+	 * @return The number of boxes.
+	 */
+	uint32_t GetSize() const { return m_size; }
+
+	/**
+	 * Gets the height of the tree, a leaf has a height of 0.
+	 * @return The height.
+	 */
+	int32_t GetHeight() const { return m_root == NullNode ? 0 : m_nodes[m_root].m_height; }
+
+	/**
+	 * Calls a function for every entity with a grown box that may be inside a frustum.
+	 * @tparam F The function type, called as {@code function(Entity *)}, if it returns a bool returning false stops the query.
+	 * @param frustum The frustum.
+	 * @param function The function to call.
+	 */
+	template<typename F>
+	void QueryFrustum(const Frustum &frustum, F &&function) const {
+		Query([&frustum](const Node &node) {
+			return frustum.CubeInFrustum(node.m_min, node.m_max);
+		}, function);
+	}
+
+	/**
+	 * Calls a function for every entity with a grown box that overlaps a sphere.
+	 * @tparam F The function type, called as {@code function(Entity *)}, if it returns a bool returning false stops the query.
+	 * @param centre The centre of the sphere.
+	 * @param radius The radius of the sphere.
+	 * @param function The function to call.
+	 */
+	template<typename F>
+	void QuerySphere(const Vector3f &centre, float radius, F &&function) const {
+		Query([&centre, radius](const Node &node) {
+			return SquaredDistance(node, centre) <= radius * radius;
+		}, function);
+	}
+
+	/**
+	 * Calls a function for every entity with a grown box that overlaps a box.
+	 * @tparam F The function type, called as {@code function(Entity *)}, if it returns a bool returning false stops the query.
+	 * @param min The minimum corner of the box.
+	 * @param max The maximum corner of the box.
+	 * @param function The function to call.
+	 */
+	template<typename F>
+	void QueryCube(const Vector3f &min, const Vector3f &max, F &&function) const {
+		Query([&min, &max](const Node &node) {
+			return Overlaps(node, min, max);
+		}, function);
+	}
+
+	/**
+	 * Calls a function for every entity with a grown box that a ray passes through, in no particular order.
+	 * @tparam F The function type, called as {@code function(Entity *)}, if it returns a bool returning false stops the query.
+	 * @param origin The start of the ray.
+	 * @param direction The direction of the ray, does not need to be normalized.
+	 * @param maxDistance How far along the ray to search, in lengths of the direction.
+	 * @param function The function to call.
+	 */
+	template<typename F>
+	void QueryRay(const Vector3f &origin, const Vector3f &direction, float maxDistance, F &&function) const {
+		// Infinite inverses for zero components make the slab test treat the ray as parallel to those planes.
+		Vector3f inverse(1.0f / direction.m_x, 1.0f / direction.m_y, 1.0f / direction.m_z);
+		Query([&origin, &inverse, maxDistance](const Node &node) {
+			return RayHits(node, origin, inverse, maxDistance);
+		}, function);
+	}
+
+private:
+	/**
+	 * @brief A branch with two children, or a leaf with a entity. Free nodes use the parent index as the next free node.
+	 */
+	struct Node {
+		bool IsLeaf() const { return m_left == NullNode; }
+
+		Vector3f m_min;
+		Vector3f m_max;
+		Entity *m_entity = nullptr;
+		int32_t m_parent = NullNode;
+		int32_t m_left = NullNode;
+		int32_t m_right = NullNode;
+		// Leaves are 0, free nodes are -1.
+		int32_t m_height = -1;
+	};
+
+	template<typename T, typename F>
+	void Query(T &&test, F &function) const {
+		if (m_root == NullNode) {
+			return;
+		}
+
+		std::pmr::vector<int32_t> stack(&FrameAllocator::Get());
+		stack.reserve(64);
+		stack.emplace_back(m_root);
+
+		while (!stack.empty()) {
+			const auto &node = m_nodes[stack.back()];
+			stack.pop_back();
+
+			if (!test(node)) {
+				continue;
+			}
+
+			if (!node.IsLeaf()) {
+				stack.emplace_back(node.m_left);
+				stack.emplace_back(node.m_right);
+			} else if constexpr (std::is_same_v<std::invoke_result_t<F &, Entity *>, bool>) {
+				if (!function(node.m_entity)) {
+					return;
+				}
+			} else {
+				function(node.m_entity);
+			}
+		}
+	}
+
+	static float SquaredDistance(const Node &node, const Vector3f &point);
+	static bool Overlaps(const Node &node, const Vector3f &min, const Vector3f &max);
+	static bool RayHits(const Node &node, const Vector3f &origin, const Vector3f &inverse, float maxDistance);
+
+	int32_t AllocateNode();
+	void FreeNode(int32_t index);
+
+	void InsertLeaf(int32_t leaf);
+	void RemoveLeaf(int32_t leaf);
+
+	/**
+	 * Rotates the children of a node if one side is more than one level taller than the other.
+	 * @param index The node.
+	 * @return The node now in its place.
+	 */
+	int32_t Balance(int32_t index);
+
+	/**
+	 * Refits the boxes and heights of every node from a node up to the root, balancing on the way.
+	 * @param index The first node to refit.
+	 */
+	void Refit(int32_t index);
+
+	void Combine(int32_t index);
+
+	float m_margin;
+	std::vector<Node> m_nodes;
+	int32_t m_root = NullNode;
+	int32_t m_free = NullNode;
+	uint32_t m_size = 0;
+};
+}
@@ -0,0 +1,162 @@
+#pragma once
+
+#include "Helpers/NonCopyable.hpp"
+#include "Archetype.hpp"
+#include "Entity.hpp"
+
+namespace acid {
+/**
+ * @brief A query over a structure that is kept up to date as archetypes are created.
+ */
+class ACID_EXPORT ViewBase : public virtual NonCopyable {
+public:
+	virtual ~ViewBase() = default;
+
+	/**
+	 * Called when the structure creates a archetype.
+	 * @param archetype The new archetype.
+	 */
+	virtual void AddArchetype(Archetype *archetype) = 0;
+};
+
+/**
+ * @brief A cached query for every entity with a component of each type, get one with {@link SceneStructure#GetView}.
+ * The view remembers which archetypes match and the column of each type in them, entities moving between archetypes as components
+ * are added or removed need no work from the view, so iterating only visits matching entities.
+ * Types are matched by {@link Component#Cast}, so a view of a base type also matches its subclasses.
+ * @tparam Ts The component types.
+ */
+template<typename... Ts>
+class View : public ViewBase {
+	static_assert((std::is_base_of_v<Component, Ts> && ...), "View types must be components");
+public:
+	/**
+	 * Creates a new view.
+	 * @param archetypes The archetypes that already exist in the structure.
+	 */
+	explicit View(const std::vector<Archetype *> &archetypes) {
+		for (auto archetype : archetypes) {
+			AddArchetype(archetype);
+		}
+	}
+
+	void AddArchetype(Archetype *archetype) override {
+		// Matching needs a component of each column, empty archetypes are matched once they have a entity.
+		if (archetype->GetSize() == 0) {
+			m_pending.emplace_back(archetype);
+			return;
+		}
+
+		Columns columns;
+
+		if (FindColumns(*archetype, columns, std::index_sequence_for<Ts...>())) {
+			m_matches.push_back({archetype, columns});
+		}
+	}
+
+	/**
+	 * Calls a function with the first component of each type for every matching entity.
+	 * Components must not be added or removed while iterating.
+	 * @tparam F The function type, called as {@code function(Ts &...)}, if it returns a bool returning false stops iterating.
+	 * @param function The function to call.
+	 * @param allowDisabled If disabled components will be included.
+	 */
+	template<typename F>
+	void ForEach(F &&function, bool allowDisabled = false) {
+		ResolvePending();
+
+		for (const auto &match : m_matches) {
+			if (!ForEachRow(match, function, allowDisabled, std::index_sequence_for<Ts...>())) {
+				return;
+			}
+		}
+	}
+
+	/**
+	 * Gets the number of entities in matching archetypes, including removed entities and disabled components.
+	 * @return The number of entities.
+	 */
+	std::size_t GetSize() {
+		ResolvePending();
+
+		std::size_t size = 0;
+
+		for (const auto &match : m_matches) {
+			size += match.m_archetype->GetSize();
+		}
+
+		return size;
+	}
+
+private:
+	using Columns = std::array<std::size_t, sizeof...(Ts)>;
+
+	struct Match {
+		Archetype *m_archetype;
+		Columns m_columns;
+	};
+
+	template<std::size_t... Is>
+	static bool FindColumns(const Archetype &archetype, Columns &columns, std::index_sequence<Is...>) {
+		return (((columns[Is] = FindColumn<Ts>(archetype)) != Archetype::NoColumn) && ...);
+	}
+
+	template<typename T>
+	static std::size_t FindColumn(const Archetype &archetype) {
+		// The first column of the type or a subclass, columns are in type ID order.
+		for (std::size_t column = 0; column < archetype.GetSignature().size(); column++) {
+			if (Component::Cast<T>(archetype.GetComponents(column).front())) {
+				return column;
+			}
+		}
+
+		return Archetype::NoColumn;
+	}
+
+	template<typename F, std::size_t... Is>
+	static bool ForEachRow(const Match &match, F &function, bool allowDisabled, std::index_sequence<Is...>) {
+		const std::array<const std::vector<Component *> *, sizeof...(Ts)> data = {&match.m_archetype->GetComponents(match.m_columns[Is])...};
+		const auto &entities = match.m_archetype->GetEntities();
+
+		for (std::size_t row = 0; row < entities.size(); row++) {
+			if (entities[row]->IsRemoved()) {
+				continue;
+			}
+
+			if (!(IsUsable((*data[Is])[row], allowDisabled) && ...)) {
+				continue;
+			}
+
+			if constexpr (std::is_same_v<std::invoke_result_t<F &, Ts &...>, bool>) {
+				if (!function(*static_cast<Ts *>((*data[Is])[row])...)) {
+					return false;
+				}
+			} else {
+				function(*static_cast<Ts *>((*data[Is])[row])...);
+			}
+		}
+
+		return true;
+	}
+
+	static bool IsUsable(const Component *component, bool allowDisabled) {
+		return !component->IsRemoved() && (allowDisabled || component->IsEnabled());
+	}
+
+	void ResolvePending() {
+		if (m_pending.empty()) {
+			return;
+		}
+
+		auto pending = std::move(m_pending);
+		m_pending.clear();
+
+		for (auto archetype : pending) {
+			AddArchetype(archetype);
+		}
+	}
+
+	std::vector<Match> m_matches;
+	std::vector<Archetype *> m_pending;
+};
+}
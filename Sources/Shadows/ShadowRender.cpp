@@ -9,6 +9,12 @@ namespace acid {
 ShadowRender::ShadowRender() {
 }
 
+std::unique_ptr<Component> ShadowRender::Clone() const {
+	auto shadowRender = std::make_unique<ShadowRender>();
+	shadowRender->SetEnabled(IsEnabled());
+	return shadowRender;
+}
+
 void ShadowRender::Start() {
 }
 
@@ -23,7 +29,7 @@ bool ShadowRender::CmdRender(const CommandBuffer &commandBuffer, const PipelineG
 	}
 
 	// Update push constants.
-	m_pushObject.Push("mvp", Shadows::Get()->GetShadowBox().GetProjectionViewMatrix() * transform->GetWorldMatrix());
+	m_pushObject.Push("mvp", Shadows::Get()->GetShadowBox().GetProjectionViewMatrix() * transform->GetInterpolatedWorldMatrix(Engine::Get()->GetAlpha()));
 
 	// Gets required components.
 	auto mesh = GetEntity()->GetComponent<Mesh>();
@@ -13,6 +13,8 @@ class ACID_EXPORT ShadowRender : public Component::Registrar<ShadowRender> {
 public:
 	ShadowRender();
 
+	std::unique_ptr<Component> Clone() const override;
+
 	void Start() override;
 	void Update() override;
 
@@ -21,7 +21,7 @@ void MaterialSkybox::CreatePipeline(const Shader::VertexInput &vertexInput, bool
 
 void MaterialSkybox::PushUniforms(UniformHandler &uniformObject, const Transform *transform) {
 	if (transform) {
-		uniformObject.Push("transform", transform->GetWorldMatrix());
+		uniformObject.Push("transform", transform->GetInterpolatedWorldMatrix(Engine::Get()->GetAlpha()));
 		uniformObject.Push("fogLimits", transform->GetScale().m_y * m_fogLimits);
 	}
 	
@@ -13,6 +13,8 @@ class ACID_EXPORT MaterialSkybox : public Material::Registrar<MaterialSkybox> {
 public:
 	explicit MaterialSkybox(std::shared_ptr<ImageCube> image = nullptr, const Colour &baseColour = Colour::White);
 
+	std::unique_ptr<Material> Clone() const override { return std::make_unique<MaterialSkybox>(*this); }
+
 	void CreatePipeline(const Shader::VertexInput &vertexInput, bool animated) override;
 	void PushUniforms(UniformHandler &uniformObject, const Transform *transform) override;
 	void PushDescriptors(DescriptorsHandler &descriptorSet) override;
@@ -17,6 +17,48 @@ Timers::~Timers() {
 }
 
 void Timers::Update() {
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		std::swap(m_mainTicks, m_mainTicksSwap);
+	}
+
+	for (auto &instance : m_mainTicksSwap) {
+		if (!instance->IsDestroyed()) {
+			instance->m_onTick();
+		}
+	}
+
+	m_mainTicksSwap.clear();
+}
+
+std::size_t Timers::GetTimerCount() {
+	std::unique_lock<std::mutex> lock(m_mutex);
+	return m_timers.size();
+}
+
+std::size_t Timers::GetMainTickCount() {
+	std::unique_lock<std::mutex> lock(m_mutex);
+	return m_mainTicks.size();
+}
+
+TimerHandle Timers::Schedule(std::shared_ptr<Timer> &&instance) {
+	TimerHandle handle(instance);
+	std::unique_lock<std::mutex> lock(m_mutex);
+	auto earliest = m_timers.empty() || instance->m_next < m_timers.front()->m_next;
+	m_timers.emplace_back(std::move(instance));
+	std::push_heap(m_timers.begin(), m_timers.end(), CompareNext);
+
+	// The thread only needs to wake if it is sleeping until a later tick.
+	if (earliest) {
+		m_condition.notify_all();
+	}
+
+	return handle;
+}
+
+bool Timers::CompareNext(const std::shared_ptr<Timer> &a, const std::shared_ptr<Timer> &b) {
+	// Reversed so the standard max heap functions keep the earliest timer at the front.
+	return a->m_next > b->m_next;
 }
 
 void Timers::ThreadRun() {
@@ -25,34 +67,50 @@ void Timers::ThreadRun() {
 	while (!m_stop) {
 		if (m_timers.empty()) {
 			m_condition.wait(lock);
+			continue;
+		}
+
+		if (m_timers.front()->IsDestroyed()) {
+			std::pop_heap(m_timers.begin(), m_timers.end(), CompareNext);
+			m_timers.pop_back();
+			continue;
+		}
+
+		auto time = Time::Now();
+
+		if (time < m_timers.front()->m_next) {
+			std::chrono::microseconds timePoint(m_timers.front()->m_next - time);
+			m_condition.wait_for(lock, timePoint);
+			continue;
+		}
+
+		std::pop_heap(m_timers.begin(), m_timers.end(), CompareNext);
+		auto instance = std::move(m_timers.back());
+		m_timers.pop_back();
+
+		if (instance->m_delivery == Timer::Delivery::Main) {
+			m_mainTicks.emplace_back(instance);
 		} else {
-			std::sort(m_timers.begin(), m_timers.end(), [](const std::unique_ptr<Timer> &a, const std::unique_ptr<Timer> &b) {
-				return a->m_next < b->m_next;
-			});
-
-			auto &instance = m_timers.front();
-			auto time = Time::Now();
-
-			if (time >= instance->m_next) {
-				//Log::Error("Timer % error: ", (time - instance->m_next).AsMilliseconds<float>(), "ms\n");
-				lock.unlock();
-				instance->m_onTick();
-				lock.lock();
-
-				instance->m_next += instance->m_interval;
-
-				if (instance->m_repeat) {
-					(*instance->m_repeat)--;
-
-					if (*instance->m_repeat == 0) {
-						m_timers.erase(std::remove(m_timers.begin(), m_timers.end(), instance), m_timers.end());
-					}
-				}
-			} else {
-				std::chrono::microseconds timePoint(instance->m_next - time);
-				m_condition.wait_for(lock, timePoint);
+			// The timer is out of the heap while its callbacks run, so they may schedule or cancel timers.
+			lock.unlock();
+			instance->m_onTick();
+			lock.lock();
+		}
+
+		instance->m_next += instance->m_interval;
+
+		if (instance->m_repeat) {
+			(*instance->m_repeat)--;
+
+			if (*instance->m_repeat == 0) {
+				continue;
 			}
 		}
+
+		if (!instance->IsDestroyed()) {
+			m_timers.emplace_back(std::move(instance));
+			std::push_heap(m_timers.begin(), m_timers.end(), CompareNext);
+		}
 	}
 }
 }
@@ -9,14 +9,26 @@ namespace acid {
 class ACID_EXPORT Timer {
 	friend class Timers;
 public:
-	Timer(const Time &interval, const std::optional<uint32_t> &repeat) :
+	/**
+	 * @brief Represents the thread a timer's callbacks are called on.
+	 */
+	enum class Delivery : uint8_t {
+		/// Called on the timers thread as soon as the timer expires.
+		Thread,
+		/// Queued and called on the main thread when the timers module updates in <seealso cref="Module#Stage#Post"/>.
+		Main
+	};
+
+	Timer(const Time &interval, const std::optional<uint32_t> &repeat, Delivery delivery = Delivery::Thread) :
 		m_interval(interval),
 		m_next(Time::Now() + m_interval),
-		m_repeat(repeat) {
+		m_repeat(repeat),
+		m_delivery(delivery) {
 	}
 
 	const Time &GetInterval() const { return m_interval; }
 	const std::optional<uint32_t> &GetRepeat() const { return m_repeat; }
+	Delivery GetDelivery() const { return m_delivery; }
 	bool IsDestroyed() const { return m_destroyed; }
 	void Destroy() { m_destroyed = true; }
 	Delegate<void()> &OnTick() { return m_onTick; };
@@ -25,12 +37,49 @@ private:
 	Time m_interval;
 	Time m_next;
 	std::optional<uint32_t> m_repeat;
-	bool m_destroyed = false;
+	Delivery m_delivery;
+	std::atomic<bool> m_destroyed = false;
 	Delegate<void()> m_onTick;
 };
 
+/**
+ * @brief A handle to a scheduled timer, that stays safe to use after the timer has finished.
+ */
+class ACID_EXPORT TimerHandle {
+public:
+	TimerHandle() = default;
+
+	explicit TimerHandle(const std::shared_ptr<Timer> &timer) :
+		m_timer(timer) {
+	}
+
+	/**
+	 * Stops the timer, it will not tick again. Does nothing if the timer has already finished.
+	 */
+	void Cancel() {
+		if (auto timer = m_timer.lock()) {
+			timer->Destroy();
+		}
+	}
+
+	/**
+	 * Gets if the timer is still scheduled.
+	 * @return If the timer will tick again.
+	 */
+	bool IsActive() const {
+		auto timer = m_timer.lock();
+		return timer && !timer->IsDestroyed();
+	}
+
+	explicit operator bool() const { return IsActive(); }
+
+private:
+	std::weak_ptr<Timer> m_timer;
+};
+
 /**
  * @brief Module used for timed events.
+ * Timers are kept in a binary heap ordered by their next tick, so scheduling and expiring a timer is O(log n).
  */
 class ACID_EXPORT Timers : public Module::Registrar<Timers> {
 public:
@@ -41,39 +90,64 @@ public:
 	void Update() override;
 
 	template<typename ...Args>
-	Timer *Once(const Time &delay, std::function<void()> &&function, Args ...args) {
-		std::unique_lock<std::mutex> lock(m_mutex);
-		auto instance = std::make_unique<Timer>(delay, 1);
+	TimerHandle Once(const Time &delay, std::function<void()> &&function, Args ...args) {
+		return Once(Timer::Delivery::Thread, delay, std::move(function), args...);
+	}
+
+	template<typename ...Args>
+	TimerHandle Once(Timer::Delivery delivery, const Time &delay, std::function<void()> &&function, Args ...args) {
+		auto instance = std::make_shared<Timer>(delay, 1, delivery);
 		instance->m_onTick.Add(std::move(function), args...);
-		m_timers.emplace_back(std::move(instance));
-		m_condition.notify_all();
-		return instance.get();
+		return Schedule(std::move(instance));
+	}
+
+	template<typename ...Args>
+	TimerHandle Every(const Time &interval, std::function<void()> &&function, Args ...args) {
+		return Every(Timer::Delivery::Thread, interval, std::move(function), args...);
 	}
 
 	template<typename ...Args>
-	Timer *Every(const Time &interval, std::function<void()> &&function, Args ...args) {
-		std::unique_lock<std::mutex> lock(m_mutex);
-		auto instance = std::make_unique<Timer>(interval, std::nullopt);
+	TimerHandle Every(Timer::Delivery delivery, const Time &interval, std::function<void()> &&function, Args ...args) {
+		auto instance = std::make_shared<Timer>(interval, std::nullopt, delivery);
 		instance->m_onTick.Add(std::move(function), args...);
-		m_timers.emplace_back(std::move(instance));
-		m_condition.notify_all();
-		return instance.get();
+		return Schedule(std::move(instance));
 	}
 
 	template<typename ...Args>
-	Timer *Repeat(const Time &interval, uint32_t repeat, std::function<void()> &&function, Args ...args) {
-		std::unique_lock<std::mutex> lock(m_mutex);
-		auto instance = std::make_unique<Timer>(interval, repeat);
+	TimerHandle Repeat(const Time &interval, uint32_t repeat, std::function<void()> &&function, Args ...args) {
+		return Repeat(Timer::Delivery::Thread, interval, repeat, std::move(function), args...);
+	}
+
+	template<typename ...Args>
+	TimerHandle Repeat(Timer::Delivery delivery, const Time &interval, uint32_t repeat, std::function<void()> &&function, Args ...args) {
+		auto instance = std::make_shared<Timer>(interval, repeat, delivery);
 		instance->m_onTick.Add(std::move(function), args...);
-		m_timers.emplace_back(std::move(instance));
-		m_condition.notify_all();
-		return instance.get();
+		return Schedule(std::move(instance));
 	}
 
+	/**
+	 * Gets the number of timers that are scheduled, including cancelled timers that have not been removed yet.
+	 * @return The number of timers.
+	 */
+	std::size_t GetTimerCount();
+
+	/**
+	 * Gets the number of ticks waiting to be delivered by the next {@link Timers#Update}.
+	 * @return The number of ticks.
+	 */
+	std::size_t GetMainTickCount();
+
 private:
+	static bool CompareNext(const std::shared_ptr<Timer> &a, const std::shared_ptr<Timer> &b);
+
+	TimerHandle Schedule(std::shared_ptr<Timer> &&instance);
 	void ThreadRun();
 
-	std::vector<std::unique_ptr<Timer>> m_timers;
+	// A min heap on the next tick, cancelled timers are removed when they reach the top.
+	std::vector<std::shared_ptr<Timer>> m_timers;
+	// Ticks waiting to be delivered on the main thread.
+	std::vector<std::shared_ptr<Timer>> m_mainTicks;
+	std::vector<std::shared_ptr<Timer>> m_mainTicksSwap;
 
 	bool m_stop = false;
 	std::thread m_worker;
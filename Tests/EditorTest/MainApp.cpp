@@ -64,7 +64,7 @@ MainApp::MainApp() :
 	}, this);
 	Input::Get()->GetButton("screenshot")->OnButton().Add([this](InputAction action, BitMask<InputMod> mods) {
 		if (action == InputAction::Press) {
-			Resources::Get()->GetThreadPool().Enqueue([]() {
+			Resources::Get()->GetJobSystem().Run([]() {
 				Graphics::Get()->CaptureScreenshot(Time::GetDateTime("Screenshots/%Y%m%d%H%M%S.png"));
 			});
 		}
@@ -0,0 +1,143 @@
+#include <Engine/Engine.hpp>
+#include <Maths/Transform.hpp>
+#include <Particles/Emitters/EmitterCircle.hpp>
+#include <Particles/ParticleSystem.hpp>
+#include <Physics/Colliders/ColliderCube.hpp>
+#include <Physics/Colliders/ColliderSphere.hpp>
+#include <Physics/Rigidbody.hpp>
+#include <Scenes/Scenes.hpp>
+
+using namespace acid;
+
+namespace test {
+struct Options {
+	bool m_headless = false;
+	uint32_t m_ticks = 1000;
+	uint32_t m_bodies = 1000;
+	uint32_t m_emitters = 16;
+};
+
+/**
+ * A scene of falling spheres and particle emitters, stepped as fast as the engine allows.
+ */
+class SimulationScene : public Scene {
+public:
+	explicit SimulationScene(const Options &options) :
+		Scene(std::make_unique<Camera>()),
+		m_options(options) {
+	}
+
+	void Start() override {
+		auto ground = GetStructure()->CreateEntity();
+		ground->AddComponent<Transform>(Vector3f(0.0f, -0.5f, 0.0f), Vector3f(), Vector3f(200.0f, 1.0f, 200.0f));
+		ground->AddComponent<Rigidbody>(std::make_unique<ColliderCube>(), 0.0f, 0.5f);
+
+		auto side = static_cast<uint32_t>(std::ceil(std::sqrt(static_cast<float>(m_options.m_bodies))));
+
+		for (uint32_t i = 0; i < m_options.m_bodies; i++) {
+			auto sphere = GetStructure()->CreateEntity();
+			sphere->AddComponent<Transform>(Vector3f(static_cast<float>(i % side) * 1.1f, 2.0f + static_cast<float>(i / side % 8), static_cast<float>(i / side) * 1.1f));
+			sphere->AddComponent<Rigidbody>(std::make_unique<ColliderSphere>(), 0.5f);
+		}
+
+		auto particleType = ParticleType::Create(nullptr, 1, Colour::White, 2.0f);
+
+		for (uint32_t i = 0; i < m_options.m_emitters; i++) {
+			std::vector<std::unique_ptr<Emitter>> emitters;
+			emitters.emplace_back(std::make_unique<EmitterCircle>(2.0f));
+
+			auto smoke = GetStructure()->CreateEntity();
+			smoke->AddComponent<Transform>(Vector3f(static_cast<float>(i) * 4.0f, 1.0f, -5.0f));
+			smoke->AddComponent<ParticleSystem>(std::vector<std::shared_ptr<ParticleType>>{particleType}, std::move(emitters), 200.0f, 1.0f, 0.1f);
+		}
+
+		m_start = Time::Now();
+	}
+
+	void Update() override {
+		if (++m_ticks >= m_options.m_ticks) {
+			m_elapsed = Time::Now() - m_start;
+			Engine::Get()->RequestClose();
+		}
+	}
+
+	bool IsPaused() const override { return false; }
+
+	uint32_t GetTicks() const { return m_ticks; }
+	const Time &GetElapsed() const { return m_elapsed; }
+
+private:
+	Options m_options;
+	uint32_t m_ticks = 0;
+	Time m_start;
+	Time m_elapsed;
+};
+
+class MainApp : public App {
+public:
+	explicit MainApp(const Options &options) :
+		App("Test Headless", {1, 0, 0}),
+		m_options(options) {
+	}
+
+	void Start() override {
+		// Ticks as fast as possible, the benchmark measures throughput not pacing.
+		Engine::Get()->SetUpdateInterval(Time::Microseconds(1));
+		Scenes::Get()->SetScene(std::make_unique<SimulationScene>(m_options));
+	}
+
+	void Update() override {
+	}
+
+private:
+	Options m_options;
+};
+}
+
+int main(int argc, char **argv) {
+	using namespace test;
+
+	Options options;
+
+	for (int32_t i = 1; i < argc; i++) {
+		std::string argument(argv[i]);
+
+		if (argument == "--headless") {
+			options.m_headless = true;
+		} else if (argument == "--ticks" && i + 1 < argc) {
+			options.m_ticks = static_cast<uint32_t>(std::stoul(argv[++i]));
+		} else if (argument == "--bodies" && i + 1 < argc) {
+			options.m_bodies = static_cast<uint32_t>(std::stoul(argv[++i]));
+		} else if (argument == "--emitters" && i + 1 < argc) {
+			options.m_emitters = static_cast<uint32_t>(std::stoul(argv[++i]));
+		} else {
+			std::cout << "Usage: " << argv[0] << " [--headless] [--ticks N] [--bodies N] [--emitters N]\n";
+			return EXIT_FAILURE;
+		}
+	}
+
+	// Creates the engine.
+	auto engine = std::make_unique<Engine>(argv[0], false, options.m_headless);
+	engine->SetApp(std::make_unique<MainApp>(options));
+
+	// Runs the game loop.
+	auto exitCode = engine->Run();
+
+	auto scene = dynamic_cast<SimulationScene *>(Scenes::Get()->GetScene());
+	auto elapsed = scene->GetElapsed();
+	Log::Out(options.m_headless ? "Headless: " : "Windowed: ", scene->GetTicks(), " ticks of ", options.m_bodies, " bodies and ", options.m_emitters,
+		" emitters in ", elapsed.AsMilliseconds<float>(), "ms, ", scene->GetTicks() / elapsed.AsSeconds<float>(), " ticks/s\n");
+	Log::Out("Normal stage: ", engine->GetStageGraph(Module::Stage::Normal).GetElapsed().AsMilliseconds<float>(), "ms last tick, ",
+		engine->GetStageGraph(Module::Stage::Normal).GetCriticalPath().AsMilliseconds<float>(), "ms critical path\n");
+	auto frameStats = FrameAllocator::GetFrameStats();
+	Log::Out("Frame allocator: ", frameStats.m_allocations, " allocations, ", frameStats.m_bytes, " bytes, ", frameStats.m_blocks, " heap blocks last frame\n");
+	Scenes::Get()->SetScene(nullptr);
+
+	if (!options.m_headless) {
+		// Pauses the console.
+		std::cout << "Press enter to continue...";
+		std::cin.get();
+	}
+
+	return exitCode;
+}
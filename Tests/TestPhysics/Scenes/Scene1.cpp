@@ -75,7 +75,7 @@ Scene1::Scene1() :
 
 	Input::Get()->GetButton("save")->OnButton().Add([this](InputAction action, BitMask<InputMod> mods) {
 		if (action == InputAction::Press) {
-			Resources::Get()->GetThreadPool().Enqueue([this]() {
+			Resources::Get()->GetJobSystem().Run([this]() {
 				File sceneFile("Scene1.json");
 
 				auto entitiesNode = (*sceneFile.GetNode())["entities"];
@@ -0,0 +1,157 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <thread>
+
+#include <Helpers/Delegate.hpp>
+
+TEST(Delegate, observersExpire) {
+	acid::Delegate<void(int32_t)> delegate;
+	int32_t total = 0;
+	auto observer = std::make_unique<acid::Observer>();
+
+	delegate.Add([&total](int32_t value) {
+		total += value;
+	});
+	delegate.Add([&total](int32_t value) {
+		total += value * 10;
+	}, observer.get());
+
+	delegate(1);
+	EXPECT_EQ(total, 11);
+
+	observer.reset();
+	delegate(1);
+	EXPECT_EQ(total, 12);
+	EXPECT_EQ(delegate.GetSize(), 1u);
+}
+
+TEST(Delegate, removeObservers) {
+	acid::Delegate<void()> delegate;
+	int32_t calls = 0;
+	auto a = std::make_unique<acid::Observer>();
+	auto b = std::make_unique<acid::Observer>();
+
+	delegate.Add([&calls]() {
+		calls += 1;
+	}, a.get(), b.get());
+	delegate.Add([&calls]() {
+		calls += 10;
+	}, a.get());
+	delegate.Add([&calls]() {
+		calls += 100;
+	});
+
+	// Only the function tied to nothing but a is removed.
+	delegate.RemoveObservers(a.get());
+	EXPECT_EQ(delegate.GetSize(), 2u);
+	delegate();
+	EXPECT_EQ(calls, 101);
+
+	// The first function is no longer tied to a, but still expires with b.
+	a.reset();
+	delegate();
+	EXPECT_EQ(calls, 202);
+	b.reset();
+	delegate();
+	EXPECT_EQ(calls, 302);
+	EXPECT_EQ(delegate.GetSize(), 1u);
+}
+
+TEST(Delegate, modifyWhileInvoking) {
+	acid::Delegate<void()> delegate;
+	uint32_t calls = 0;
+
+	delegate.Add([&]() {
+		if (++calls == 1) {
+			delegate.Add([&calls]() {
+				calls += 100;
+			});
+		}
+	});
+
+	// Functions added while invoking are called from the next invoke.
+	delegate();
+	EXPECT_EQ(calls, 1u);
+	EXPECT_EQ(delegate.GetSize(), 2u);
+	delegate();
+	EXPECT_EQ(calls, 102u);
+
+	delegate.Add([&]() {
+		delegate.Clear();
+	});
+	delegate();
+	EXPECT_EQ(calls, 203u);
+	EXPECT_EQ(delegate.GetSize(), 0u);
+}
+
+TEST(Delegate, returnValues) {
+	acid::Delegate<int32_t(int32_t)> delegate;
+	delegate.Add([](int32_t value) { return value; });
+	delegate.Add([](int32_t value) { return value * 2; });
+
+	EXPECT_EQ(delegate(3), (std::vector<int32_t>{3, 6}));
+}
+
+TEST(Delegate, reclaimWhileReadersOverlap) {
+	acid::Delegate<void()> delegate;
+	std::array<std::atomic<uint32_t>, 2> started = {}, entered = {}, released = {}, finished = {};
+	std::atomic<bool> stop = false;
+	static thread_local uint32_t reader = 0;
+
+	// Blocks each invoke until the main thread releases it, so the two readers can be made to overlap.
+	delegate.Add([&]() {
+		auto run = ++entered[reader];
+		while (released[reader].load() < run) {
+			std::this_thread::yield();
+		}
+	});
+
+	auto read = [&](uint32_t index) {
+		reader = index;
+		for (uint32_t run = 1;; run++) {
+			while (started[index].load() < run) {
+				if (stop) {
+					return;
+				}
+				std::this_thread::yield();
+			}
+			delegate();
+			finished[index]++;
+		}
+	};
+	std::array<std::thread, 2> readers;
+	for (uint32_t i = 0; i < 2; i++) {
+		readers[i] = std::thread(read, i);
+	}
+
+	std::size_t maxRetired = 0;
+
+	for (uint32_t i = 0; i < 200; i++) {
+		auto index = i % 2;
+		started[index]++;
+		while (entered[index].load() < started[index].load()) {
+			std::this_thread::yield();
+		}
+
+		// The previous reader finishes while this one is still invoking, so a reader is always active.
+		released[1 - index].store(started[1 - index].load());
+		while (finished[1 - index].load() < started[1 - index].load()) {
+			std::this_thread::yield();
+		}
+
+		delegate.Add([]() {});
+		maxRetired = std::max(maxRetired, delegate.GetRetiredCount());
+	}
+
+	released[0].store(started[0].load());
+	released[1].store(started[1].load());
+	stop = true;
+	for (auto &reader : readers) {
+		reader.join();
+	}
+
+	EXPECT_LE(maxRetired, 2u);
+	delegate.Add([]() {});
+	EXPECT_EQ(delegate.GetRetiredCount(), 0u);
+}
@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <Files/FileObserver.hpp>
+
+using namespace acid;
+using namespace std::chrono_literals;
+
+namespace {
+class FileObserverTest : public testing::Test {
+protected:
+	void SetUp() override {
+		m_path = std::filesystem::temp_directory_path() / ("Acid_FileObserver_" + std::to_string(reinterpret_cast<std::uintptr_t>(this)));
+		std::filesystem::remove_all(m_path);
+		std::filesystem::create_directories(m_path / "Textures");
+	}
+
+	void TearDown() override {
+		std::filesystem::remove_all(m_path);
+	}
+
+	void Write(const std::filesystem::path &filename, const std::string &contents) {
+		std::ofstream(m_path / filename) << contents;
+	}
+
+	/**
+	 * Waits until a number of changes have been reported, or a second has passed.
+	 */
+	std::vector<std::pair<std::filesystem::path, FileObserver::Status>> WaitForChanges(std::size_t count) {
+		auto start = Time::Now();
+
+		while (Time::Now() - start < 1s) {
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+
+				if (m_changes.size() >= count) {
+					break;
+				}
+			}
+
+			std::this_thread::sleep_for(1ms);
+		}
+
+		// Gives a burst time to report changes it should not have.
+		std::this_thread::sleep_for(100ms);
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return std::exchange(m_changes, {});
+	}
+
+	std::filesystem::path m_path;
+	std::mutex m_mutex;
+	std::vector<std::pair<std::filesystem::path, FileObserver::Status>> m_changes;
+};
+}
+
+TEST_F(FileObserverTest, CoalescesBursts) {
+	FileObserver observer(m_path);
+
+	if (!observer.IsNotifying()) {
+		GTEST_SKIP() << "Polling fallback";
+	}
+
+	observer.OnChange().Add([this](std::filesystem::path path, FileObserver::Status status) {
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_changes.emplace_back(path.lexically_relative(m_path), status);
+	});
+
+	// Created and written many times, reported once.
+	for (int i = 0; i < 10; i++) {
+		Write("Textures/a.png", std::to_string(i));
+	}
+
+	auto changes = WaitForChanges(1);
+	ASSERT_EQ(changes.size(), 1);
+	EXPECT_EQ(changes[0].first, std::filesystem::path("Textures/a.png"));
+	EXPECT_EQ(changes[0].second, FileObserver::Status::Created);
+
+	// Replaced by renaming a new file over it, the temporary file is never reported.
+	Write("Textures/a.png.tmp", "new");
+	std::filesystem::rename(m_path / "Textures/a.png.tmp", m_path / "Textures/a.png");
+	changes = WaitForChanges(1);
+	ASSERT_EQ(changes.size(), 1);
+	EXPECT_EQ(changes[0].first, std::filesystem::path("Textures/a.png"));
+}
+
+TEST_F(FileObserverTest, WatchesNewDirectories) {
+	FileObserver observer(m_path);
+
+	if (!observer.IsNotifying()) {
+		GTEST_SKIP() << "Polling fallback";
+	}
+
+	observer.OnChange().Add([this](std::filesystem::path path, FileObserver::Status status) {
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_changes.emplace_back(path.lexically_relative(m_path), status);
+	});
+
+	std::filesystem::create_directories(m_path / "Shaders/Includes");
+	Write("Shaders/Includes/Lighting.glsl", "");
+	EXPECT_EQ(WaitForChanges(3).size(), 3);
+
+	// Files in the new directory are watched.
+	Write("Shaders/Includes/Lighting.glsl", "void main() {}");
+	auto changes = WaitForChanges(1);
+	ASSERT_EQ(changes.size(), 1);
+	EXPECT_EQ(changes[0].first, std::filesystem::path("Shaders/Includes/Lighting.glsl"));
+	EXPECT_EQ(changes[0].second, FileObserver::Status::Modified);
+
+	std::filesystem::remove(m_path / "Shaders/Includes/Lighting.glsl");
+	changes = WaitForChanges(1);
+	ASSERT_EQ(changes.size(), 1);
+	EXPECT_EQ(changes[0].second, FileObserver::Status::Erased);
+}
@@ -0,0 +1,61 @@
+#include <gtest/gtest.h>
+
+#include <Helpers/FrameAllocator.hpp>
+
+TEST(FrameAllocator, alignedAllocations) {
+	auto &allocator = acid::FrameAllocator::Get();
+
+	for (std::size_t alignment : {1, 4, 16, 64}) {
+		auto ptr = allocator.allocate(3, alignment);
+		EXPECT_EQ(reinterpret_cast<std::uintptr_t>(ptr) % alignment, 0u);
+		allocator.deallocate(ptr, 3, alignment);
+	}
+}
+
+TEST(FrameAllocator, growsAndRewindsEachFrame) {
+	acid::FrameAllocator::NextFrame();
+	{
+		std::pmr::vector<uint32_t> values(&acid::FrameAllocator::Get());
+
+		for (uint32_t i = 0; i < 100000; i++) {
+			values.emplace_back(i);
+		}
+
+		EXPECT_EQ(values[99999], 99999u);
+	}
+
+	auto capacity = acid::FrameAllocator::Get().GetCapacity();
+	acid::FrameAllocator::NextFrame();
+	EXPECT_GT(acid::FrameAllocator::GetFrameStats().m_allocations, 0u);
+	EXPECT_GT(acid::FrameAllocator::GetFrameStats().m_blocks, 1u);
+
+	// The blocks from last frame are merged, so the same work needs no new blocks.
+	EXPECT_EQ(acid::FrameAllocator::Get().GetUsed(), 0u);
+	{
+		std::pmr::vector<uint32_t> values(&acid::FrameAllocator::Get());
+		values.reserve(100000);
+	}
+
+	EXPECT_EQ(acid::FrameAllocator::Get().GetCapacity(), capacity);
+	acid::FrameAllocator::NextFrame();
+	EXPECT_EQ(acid::FrameAllocator::GetFrameStats().m_blocks, 1u);
+}
+
+TEST(FrameAllocator, keepsLiveMemoryAcrossFrames) {
+	acid::FrameAllocator::NextFrame();
+	auto kept = std::make_unique<std::pmr::vector<uint32_t>>(std::initializer_list<uint32_t>{1, 2, 3}, &acid::FrameAllocator::Get());
+
+	// A job still holding frame memory when the frame ends is not overwritten by its next allocations.
+	acid::FrameAllocator::NextFrame();
+	{
+		std::pmr::vector<uint32_t> values(64, 7, &acid::FrameAllocator::Get());
+		EXPECT_EQ(*kept, std::pmr::vector<uint32_t>({1, 2, 3}));
+	}
+
+	EXPECT_GT(acid::FrameAllocator::Get().GetUsed(), 0u);
+
+	// Once released the blocks are rewound on the next use.
+	kept.reset();
+	EXPECT_EQ(acid::FrameAllocator::Get().GetLive(), 0u);
+	EXPECT_EQ(acid::FrameAllocator::Get().GetUsed(), 0u);
+}
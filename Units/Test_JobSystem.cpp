@@ -0,0 +1,61 @@
+#include <gtest/gtest.h>
+
+#include <Helpers/JobSystem.hpp>
+
+TEST(JobSystem, parallelFor) {
+	acid::JobSystem jobSystem(4);
+	std::vector<uint32_t> values(10000, 1);
+	std::atomic<uint64_t> sum = 0;
+
+	jobSystem.ParallelFor(static_cast<uint32_t>(values.size()), 128, [&](uint32_t begin, uint32_t end) {
+		uint64_t local = 0;
+		for (auto i = begin; i < end; i++) {
+			local += values[i];
+		}
+		sum += local;
+	});
+
+	EXPECT_EQ(sum, values.size());
+}
+
+TEST(JobSystem, childrenFinishBeforeParent) {
+	acid::JobSystem jobSystem(4);
+	acid::JobCounter counter;
+	std::atomic<uint32_t> children = 0;
+
+	jobSystem.Run([&](acid::Job &parent) {
+		for (uint32_t i = 0; i < 64; i++) {
+			jobSystem.Run(jobSystem.CreateChild(parent, [&children]() {
+				children++;
+			}));
+		}
+	}, &counter);
+
+	jobSystem.Wait(counter);
+	EXPECT_EQ(children, 64u);
+	EXPECT_TRUE(counter.IsDone());
+}
+
+TEST(JobSystem, enqueueFuture) {
+	acid::JobSystem jobSystem(2);
+	auto result = jobSystem.Enqueue([](int32_t a, int32_t b) {
+		return a + b;
+	}, 2, 3);
+
+	EXPECT_EQ(result.get(), 5);
+}
+
+TEST(JobSystem, exhaustedCapacity) {
+	acid::JobSystem jobSystem(2, 8);
+	acid::JobCounter counter;
+	std::atomic<uint32_t> count = 0;
+
+	for (uint32_t i = 0; i < 1000; i++) {
+		jobSystem.Run([&count]() {
+			count++;
+		}, &counter);
+	}
+
+	jobSystem.Wait(counter);
+	EXPECT_EQ(count, 1000u);
+}
@@ -0,0 +1,260 @@
+#include <gtest/gtest.h>
+
+#include <Helpers/JobSystem.hpp>
+#include <Resources/Resources.hpp>
+
+using namespace acid;
+
+namespace {
+class Texture : public Resource {
+};
+
+class Sound : public Resource {
+};
+
+class Mesh : public Resource {
+public:
+	explicit Mesh(std::string filename) :
+		m_filename(std::move(filename)) {
+	}
+
+	static std::shared_ptr<Mesh> Create(const Node &node) {
+		if (node["filename"].Get<std::string>() == "missing.obj") {
+			throw std::runtime_error("Could not open missing.obj");
+		}
+
+		return std::make_shared<Mesh>(node["filename"].Get<std::string>());
+	}
+
+	static std::shared_ptr<Mesh> CreatePlaceholder() {
+		return std::make_shared<Mesh>("cube");
+	}
+
+	std::string m_filename;
+};
+
+class Image : public Resource {
+public:
+	explicit Image(std::size_t gpuSize) {
+		m_gpuSize = gpuSize;
+	}
+};
+
+class ShaderFile : public Resource {
+public:
+	void Reload() override {
+		m_reloads++;
+	}
+
+	uint32_t m_reloads = 0;
+};
+
+class Reentrant : public Resource {
+public:
+	Reentrant(Resources &resources, std::size_t &sizeOnDestroy) :
+		m_resources(resources),
+		m_sizeOnDestroy(sizeOnDestroy) {
+	}
+
+	~Reentrant() {
+		m_sizeOnDestroy = m_resources.GetSize();
+	}
+
+	Resources &m_resources;
+	std::size_t &m_sizeOnDestroy;
+};
+
+Node CreateNode(const std::string &filename) {
+	Node node;
+	node["filename"] = filename;
+	node["mipmap"] = true;
+	return node;
+}
+}
+
+TEST(Resources, HashMatchesEquality) {
+	auto a = CreateNode("a.png");
+	auto b = CreateNode("a.png");
+	EXPECT_EQ(a, b);
+	EXPECT_EQ(a.GetHash(), b.GetHash());
+
+	b["mipmap"] = false;
+	EXPECT_NE(a, b);
+	EXPECT_NE(a.GetHash(), b.GetHash());
+}
+
+TEST(Resources, FindsByNodeAndType) {
+	Resources resources;
+	auto texture = std::make_shared<Texture>();
+	auto sound = std::make_shared<Sound>();
+	resources.Add(CreateNode("a.png"), texture);
+	resources.Add(CreateNode("a.png"), sound);
+	EXPECT_EQ(resources.GetSize(), 2);
+
+	// Equal nodes in different registries find different resources.
+	EXPECT_EQ(resources.Find<Texture>(CreateNode("a.png")), texture);
+	EXPECT_EQ(resources.Find<Sound>(CreateNode("a.png")), sound);
+	EXPECT_EQ(resources.Find<Texture>(CreateNode("b.png")), nullptr);
+
+	// Adding an equal node keeps the first resource.
+	resources.Add(CreateNode("a.png"), std::make_shared<Texture>());
+	EXPECT_EQ(resources.Find<Texture>(CreateNode("a.png")), texture);
+
+	resources.Remove(texture);
+	EXPECT_EQ(resources.Find<Texture>(CreateNode("a.png")), nullptr);
+	EXPECT_EQ(resources.GetSize(), 1);
+}
+
+TEST(Resources, FindOrAddAgreesOnOneResource) {
+	Resources resources;
+	std::atomic<uint32_t> added = 0;
+	std::vector<std::shared_ptr<Texture>> found(8);
+	std::vector<std::thread> threads;
+
+	// Every thread misses the find, only one of the textures they create is added.
+	for (std::size_t i = 0; i < found.size(); i++) {
+		threads.emplace_back([&, i]() {
+			auto texture = std::make_shared<Texture>();
+			found[i] = resources.FindOrAdd(CreateNode("a.png"), texture);
+
+			if (found[i] == texture) {
+				added++;
+			}
+		});
+	}
+
+	for (auto &thread : threads) {
+		thread.join();
+	}
+
+	EXPECT_EQ(added, 1);
+	EXPECT_EQ(std::count(found.begin(), found.end(), found[0]), found.size());
+	EXPECT_EQ(resources.Find<Texture>(CreateNode("a.png")), found[0]);
+	EXPECT_EQ(resources.GetSize(), 1);
+}
+
+TEST(Resources, LoadAsyncGivesPlaceholderUntilLoaded) {
+	JobSystem jobSystem(2);
+	Resources resources(&jobSystem);
+	EXPECT_EQ(resources.GetPlaceholder<Texture>(), nullptr);
+
+	std::vector<std::string> loaded;
+	std::vector<ResourceHandle<Mesh>> handles;
+
+	for (int i = 0; i < 8; i++) {
+		handles.emplace_back(resources.LoadAsync<Mesh>(CreateNode(std::to_string(i) + ".obj"), [&loaded](const std::shared_ptr<Mesh> &mesh) {
+			loaded.emplace_back(mesh->m_filename);
+		}));
+	}
+
+	// Handles are only completed by the update on the main thread, even once the loading jobs have finished.
+	jobSystem.Wait();
+	EXPECT_EQ(resources.GetLoadingCount(), 0);
+
+	for (const auto &handle : handles) {
+		EXPECT_FALSE(handle.IsReady());
+		EXPECT_EQ(handle.Get(), resources.GetPlaceholder<Mesh>());
+	}
+
+	resources.Update();
+	EXPECT_EQ(loaded.size(), 8);
+
+	for (const auto &handle : handles) {
+		EXPECT_TRUE(handle.IsReady());
+		EXPECT_NE(handle.Get()->m_filename, "cube");
+	}
+
+	EXPECT_EQ(handles[3].Get()->m_filename, "3.obj");
+}
+
+TEST(Resources, LoadAsyncFailureKeepsPlaceholder) {
+	JobSystem jobSystem(2);
+	Resources resources(&jobSystem);
+	bool called = false;
+	auto handle = resources.LoadAsync<Mesh>(CreateNode("missing.obj"), [&called](const std::shared_ptr<Mesh> &) {
+		called = true;
+	});
+
+	jobSystem.Wait();
+	resources.Update();
+	EXPECT_TRUE(handle.IsReady());
+	EXPECT_EQ(handle.Get(), resources.GetPlaceholder<Mesh>());
+	EXPECT_FALSE(called);
+}
+
+TEST(Resources, ReloadsOnlyDependents) {
+	Resources resources;
+	auto shader = std::make_shared<ShaderFile>();
+	auto other = std::make_shared<ShaderFile>();
+	resources.AddDependency(*shader, "Shaders/Default.frag");
+	resources.AddDependency(*shader, "Shaders/Lighting.glsl");
+	resources.AddDependency(*other, "Shaders/Other.frag");
+
+	// Resources not owned by a shared pointer are not tracked.
+	ShaderFile local;
+	resources.AddDependency(local, "Shaders/Lighting.glsl");
+
+	// Changed paths are matched by the dependency they end with, a resource is reloaded once for many changed files.
+	EXPECT_EQ(resources.Reload({"Resources/Engine/Shaders/Lighting.glsl", "Resources/Engine/Shaders/./Default.frag"}), 1);
+	EXPECT_EQ(shader->m_reloads, 1);
+	EXPECT_EQ(other->m_reloads, 0);
+	EXPECT_EQ(local.m_reloads, 0);
+
+	EXPECT_EQ(resources.Reload({"Resources/Engine/Other.frag"}), 0);
+
+	other.reset();
+	EXPECT_EQ(resources.Reload({"Shaders/Other.frag"}), 0);
+}
+
+TEST(Resources, EvictsLeastRecentlyUsedOverBudget) {
+	Resources resources;
+	resources.SetBudget<Image>(Resources::Budget{std::numeric_limits<std::size_t>::max(), 300});
+
+	for (int i = 0; i < 4; i++) {
+		resources.Add(CreateNode(std::to_string(i) + ".png"), std::make_shared<Image>(100));
+	}
+
+	// Images in use are never evicted, and count as used at every trim.
+	auto used = resources.Find<Image>(CreateNode("0.png"));
+	EXPECT_NE(resources.Find<Image>(CreateNode("2.png")), nullptr);
+	EXPECT_EQ(resources.Find<Image>(CreateNode("4.png")), nullptr);
+
+	auto stats = resources.GetStats<Image>();
+	EXPECT_EQ(stats.m_hits, 2);
+	EXPECT_EQ(stats.m_misses, 1);
+	EXPECT_EQ(stats.m_count, 4);
+	EXPECT_EQ(stats.m_gpuBytes, 400);
+
+	// 1.png was used least recently of the unused images.
+	resources.Trim();
+	EXPECT_NE(resources.Find<Image>(CreateNode("0.png")), nullptr);
+	EXPECT_EQ(resources.Find<Image>(CreateNode("1.png")), nullptr);
+	EXPECT_NE(resources.Find<Image>(CreateNode("2.png")), nullptr);
+	EXPECT_NE(resources.Find<Image>(CreateNode("3.png")), nullptr);
+
+	// Under budget unused images stay cached.
+	resources.Trim();
+	stats = resources.GetStats<Image>();
+	EXPECT_EQ(stats.m_evictions, 1);
+	EXPECT_EQ(stats.m_count, 3);
+	EXPECT_EQ(stats.m_gpuBytes, 300);
+
+	// Types without a budget release every unused resource.
+	resources.Add(CreateNode("a.wav"), std::make_shared<Sound>());
+	resources.SetBudget<Image>(std::nullopt);
+	resources.Trim();
+	EXPECT_EQ(resources.GetSize(), 1);
+	EXPECT_EQ(resources.GetStats<Image>().m_evictions, 3);
+	EXPECT_EQ(resources.GetStats<Sound>().m_evictions, 1);
+	EXPECT_EQ(resources.Find<Image>(CreateNode("0.png")), used);
+}
+
+TEST(Resources, TrimDestroysOutsideTheLock) {
+	Resources resources;
+	std::size_t sizeOnDestroy = 1;
+	resources.Add(CreateNode("a.bin"), std::make_shared<Reentrant>(resources, sizeOnDestroy));
+
+	// The destructor uses the registries, which would deadlock if it ran while trimming holds the lock.
+	resources.Trim();
+	EXPECT_EQ(sizeOnDestroy, 0);
+}
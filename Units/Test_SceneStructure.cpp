@@ -0,0 +1,547 @@
+#include <gtest/gtest.h>
+
+#include <Files/File.hpp>
+#include <Files/Json/Json.hpp>
+#include <Maths/Transform.hpp>
+#include <Meshes/Mesh.hpp>
+#include <Physics/Colliders/ColliderSphere.hpp>
+#include <Physics/Rigidbody.hpp>
+#include <Scenes/EntityPrefab.hpp>
+#include <Scenes/SceneSnapshot.hpp>
+#include <Scenes/SceneStructure.hpp>
+
+using namespace acid;
+
+namespace {
+class Position : public Component::Registrar<Position> {
+public:
+	explicit Position(float x = 0.0f) :
+		m_x(x) {
+	}
+
+	float m_x;
+};
+
+class Velocity : public Component::Registrar<Velocity> {
+public:
+	explicit Velocity(float x = 0.0f) :
+		m_x(x) {
+	}
+
+	friend const Node &operator>>(const Node &node, Velocity &velocity) {
+		node["x"].Get(velocity.m_x);
+		return node;
+	}
+
+	friend Node &operator<<(Node &node, const Velocity &velocity) {
+		node["x"].Set(velocity.m_x);
+		return node;
+	}
+
+	static bool registered;
+
+	float m_x;
+};
+
+bool Velocity::registered = Register("velocity");
+}
+
+class SceneStructureTest : public testing::TestWithParam<SceneStructure::Storage> {
+};
+
+TEST_P(SceneStructureTest, ForEachMatchesArchetypes) {
+	SceneStructure structure(GetParam());
+
+	for (int32_t i = 0; i < 100; i++) {
+		auto entity = structure.CreateEntity();
+		entity->AddComponent<Position>(static_cast<float>(i));
+
+		if (i % 2 == 0) {
+			entity->AddComponent<Velocity>(1.0f);
+		}
+	}
+
+	// Entities with and without a velocity are in different archetypes.
+	EXPECT_EQ(structure.GetArchetypes().size(), 3);
+
+	structure.ForEach<Position, Velocity>([](Position &position, Velocity &velocity) {
+		position.m_x += velocity.m_x;
+	});
+
+	float sum = 0.0f;
+	uint32_t count = 0;
+	structure.ForEach<Position>([&](Position &position) {
+		sum += position.m_x;
+		count++;
+	});
+	EXPECT_EQ(count, 100);
+	EXPECT_FLOAT_EQ(sum, 4950.0f + 50.0f);
+}
+
+TEST_P(SceneStructureTest, ArchetypesFollowComponentChanges) {
+	SceneStructure structure(GetParam());
+	auto a = structure.CreateEntity();
+	auto b = structure.CreateEntity();
+	a->AddComponent<Position>();
+	b->AddComponent<Position>();
+	auto velocity = a->AddComponent<Velocity>();
+
+	EXPECT_NE(a->GetArchetype(), b->GetArchetype());
+
+	a->RemoveComponent(velocity);
+	EXPECT_EQ(a->GetArchetype(), b->GetArchetype());
+	EXPECT_EQ(a->GetArchetype()->GetSize(), 2);
+
+	structure.Remove(a);
+	EXPECT_EQ(b->GetArchetype()->GetSize(), 1);
+
+	uint32_t count = 0;
+	structure.ForEach<Velocity>([&](Velocity &) {
+		count++;
+	});
+	EXPECT_EQ(count, 0);
+
+	b->GetComponent<Position>()->SetEnabled(false);
+	structure.ForEach<Position>([&](Position &) {
+		count++;
+	});
+	EXPECT_EQ(count, 0);
+	structure.ForEach<Position>([&](Position &) {
+		count++;
+	}, true);
+	EXPECT_EQ(count, 1);
+}
+
+INSTANTIATE_TEST_CASE_P(Storage, SceneStructureTest, testing::Values(SceneStructure::Storage::Heap, SceneStructure::Storage::Pooled));
+
+namespace {
+class Shape : public Component::Registrar<Shape> {
+};
+
+class Circle : public Shape {
+};
+
+class Health : public Component {
+public:
+	float m_value = 100.0f;
+};
+
+class Armour : public Component {
+public:
+	int32_t m_value = 3;
+};
+}
+
+TEST(ComponentTest, CastMatchesSubclasses) {
+	SceneStructure structure;
+	auto entity = structure.CreateEntity();
+	auto circle = entity->AddComponent<Circle>();
+	entity->AddComponent<Position>();
+
+	// The second lookups use the cached relation instead of a dynamic_cast.
+	for (int32_t i = 0; i < 2; i++) {
+		EXPECT_EQ(entity->GetComponent<Shape>(), circle);
+		EXPECT_EQ(entity->GetComponent<Circle>(), circle);
+		EXPECT_EQ(entity->GetComponent<Velocity>(), nullptr);
+		EXPECT_EQ(structure.QueryComponents<Shape>().size(), 1);
+		EXPECT_EQ(structure.QueryComponents<Velocity>().size(), 0);
+	}
+
+	// Circle is not a registrar, its type ID still comes from its own type so a shape is not cast to a circle.
+	EXPECT_NE(circle->GetTypeId(), TypeInfo<Component>::GetTypeId<Shape>());
+	auto shape = structure.CreateEntity()->AddComponent<Shape>();
+	EXPECT_EQ(Component::Cast<Circle>(shape), nullptr);
+	EXPECT_EQ(Component::Cast<Shape>(shape), shape);
+	EXPECT_EQ(structure.QueryComponents<Shape>().size(), 2);
+}
+
+TEST(ComponentTest, UnregisteredTypesHaveTheirOwnColumns) {
+	SceneStructure structure;
+	auto entity = structure.CreateEntity();
+	auto health = entity->AddComponent<Health>();
+	auto armour = entity->AddComponent<Armour>();
+
+	EXPECT_NE(health->GetTypeId(), armour->GetTypeId());
+	EXPECT_EQ(entity->GetComponent<Health>(), health);
+	EXPECT_EQ(entity->GetComponent<Armour>(), armour);
+
+	uint32_t count = 0;
+	structure.ForEach<Health, Armour>([&](Health &h, Armour &a) {
+		EXPECT_EQ(&h, health);
+		EXPECT_EQ(&a, armour);
+		count++;
+	});
+	EXPECT_EQ(count, 1);
+}
+
+TEST(ViewTest, FollowsComponentChanges) {
+	SceneStructure structure;
+	auto &view = structure.GetView<Position, Velocity>();
+	EXPECT_EQ(view.GetSize(), 0);
+
+	auto a = structure.CreateEntity();
+	a->AddComponent<Position>();
+	auto velocity = a->AddComponent<Velocity>();
+	auto b = structure.CreateEntity();
+	b->AddComponent<Position>();
+	EXPECT_EQ(view.GetSize(), 1);
+
+	b->AddComponent<Velocity>();
+	a->RemoveComponent(velocity);
+	uint32_t count = 0;
+	view.ForEach([&](Position &, Velocity &) {
+		count++;
+	});
+	EXPECT_EQ(count, 1);
+
+	// Views created later match archetypes that already exist, and a view of a base type matches subclasses.
+	b->AddComponent<Circle>();
+	count = 0;
+	structure.ForEach<Shape, Velocity>([&](Shape &, Velocity &) {
+		count++;
+		return false;
+	});
+	EXPECT_EQ(count, 1);
+	auto &found = structure.GetView<Position, Velocity>();
+	EXPECT_EQ(&found, &view);
+}
+
+namespace {
+class Spawner : public Component::Registrar<Spawner> {
+public:
+	void Update() override {
+		// Deferred while thread safe components update.
+		m_deferred = GetEntity()->GetStructure()->IsDeferring();
+		// Transforms are recomputed before thread safe components update, so reading one never writes a shared parent.
+		auto transform = GetEntity()->GetComponent<Transform>();
+		m_transformsClean = !transform || (!transform->IsDirty() && !transform->GetParent()->IsDirty());
+		GetEntity()->AddComponent<Velocity>();
+		GetEntity()->GetStructure()->CreateEntity()->AddComponent<Position>();
+		// Renames move the entity in the structure's name index, so are deferred too.
+		GetEntity()->SetName("Spawner");
+		m_renameDeferred = GetEntity()->GetName().empty();
+	}
+
+	void LateUpdate() override {
+		m_velocities = GetEntity()->GetComponents<Velocity>().size();
+	}
+
+	bool IsThreadSafe() const override { return true; }
+
+	bool m_deferred = false;
+	bool m_transformsClean = false;
+	bool m_renameDeferred = false;
+	std::size_t m_velocities = 0;
+};
+}
+
+TEST(SceneStructureUpdateTest, ParallelChangesAreDeferred) {
+	SceneStructure structure;
+	auto parent = structure.CreateEntity()->AddComponent<Transform>();
+	auto entity = structure.CreateEntity();
+	entity->AddComponent<Transform>()->SetParent(parent);
+	auto spawner = entity->AddComponent<Spawner>();
+	structure.Update();
+
+	EXPECT_TRUE(spawner->m_deferred);
+	EXPECT_TRUE(spawner->m_transformsClean);
+	EXPECT_TRUE(spawner->m_renameDeferred);
+	EXPECT_EQ(structure.GetEntity("Spawner"), entity);
+	EXPECT_FALSE(structure.IsDeferring());
+	// Applied before late updates.
+	EXPECT_EQ(spawner->m_velocities, 1);
+	EXPECT_EQ(structure.GetSize(), 3);
+	EXPECT_EQ(structure.GetView<Position>().GetSize(), 1);
+}
+
+TEST(EntityCommandBufferTest, AppliesAtSyncPoint) {
+	SceneStructure structure;
+	SceneStructure other;
+	std::vector<Entity *> entities;
+
+	for (int32_t i = 0; i < 1000; i++) {
+		auto entity = structure.CreateEntity();
+		entity->AddComponent<Position>(static_cast<float>(i));
+		entities.emplace_back(entity);
+	}
+
+	auto &commands = structure.GetCommands();
+
+	// Destroys every other entity, recording the same entity twice is allowed.
+	for (std::size_t i = 0; i < entities.size(); i += 2) {
+		commands.Destroy(entities[i]);
+		commands.Destroy(entities[i]);
+	}
+
+	commands.AddComponent<Velocity>(entities[1], 2.0f);
+	commands.RemoveComponent(entities[3], entities[3]->GetComponent<Position>());
+	commands.Move(entities[5], other);
+	commands.CreateEntity()->AddComponent<Position>();
+
+	// Nothing changes until the commands are applied.
+	EXPECT_EQ(structure.GetSize(), 1000);
+	EXPECT_EQ(entities[1]->GetComponent<Velocity>(), nullptr);
+
+	structure.Flush();
+	EXPECT_TRUE(commands.IsEmpty());
+	EXPECT_EQ(structure.GetSize(), 500);
+	EXPECT_EQ(other.GetSize(), 1);
+	EXPECT_EQ(entities[5]->GetStructure(), &other);
+	EXPECT_NE(entities[1]->GetComponent<Velocity>(), nullptr);
+	EXPECT_EQ(entities[3]->GetComponentCount(), 0);
+	EXPECT_EQ(structure.GetView<Position>().GetSize(), 499);
+	EXPECT_TRUE(structure.Contains(entities[999]));
+}
+
+namespace {
+class Despawner : public Component::Registrar<Despawner> {
+public:
+	void Update() override {
+		// Removing the entity being updated is deferred until the end of the update.
+		GetEntity()->GetStructure()->Remove(GetEntity());
+		m_updated = true;
+	}
+
+	bool m_updated = false;
+};
+}
+
+TEST(EntityCommandBufferTest, RemovalsDuringUpdateAreDeferred) {
+	SceneStructure structure;
+	auto despawner = structure.CreateEntity()->AddComponent<Despawner>();
+	auto kept = structure.CreateEntity();
+	kept->AddComponent<Position>();
+
+	structure.Update();
+	EXPECT_EQ(structure.GetSize(), 1);
+	EXPECT_TRUE(structure.Contains(kept));
+	(void)despawner;
+}
+
+TEST(EntityHandleTest, DetectsDestroyedEntities) {
+	SceneStructure structure;
+	auto entity = structure.CreateEntity();
+	auto handle = entity->GetHandle();
+	EXPECT_TRUE(handle);
+	EXPECT_EQ(structure.GetEntity(handle), entity);
+
+	structure.Remove(entity);
+	EXPECT_FALSE(structure.Contains(handle));
+
+	// The slot is reused with a new generation, so the old handle stays dangling.
+	auto reused = structure.CreateEntity();
+	EXPECT_EQ(reused->GetHandle().GetIndex(), handle.GetIndex());
+	EXPECT_NE(reused->GetHandle(), handle);
+	EXPECT_EQ(structure.GetEntity(handle), nullptr);
+
+	structure.GetCommands().Destroy(handle);
+	structure.Flush();
+	EXPECT_EQ(structure.GetSize(), 1);
+
+	auto reusedHandle = reused->GetHandle();
+	structure.Clear();
+	EXPECT_EQ(structure.GetEntity(reusedHandle), nullptr);
+	EXPECT_EQ(structure.GetEntity(EntityHandle()), nullptr);
+}
+
+TEST(EntityHandleTest, FindsEntitiesByName) {
+	SceneStructure structure;
+	auto a = structure.CreateEntity();
+	auto b = structure.CreateEntity();
+	auto c = structure.CreateEntity();
+	a->SetName("Player");
+	b->SetName("Player");
+	c->SetName("Light");
+
+	EXPECT_EQ(structure.GetEntity("Player"), a);
+	EXPECT_EQ(structure.GetEntity("Light"), c);
+	EXPECT_EQ(structure.GetEntity("Camera"), nullptr);
+
+	structure.Remove(a);
+	EXPECT_EQ(structure.GetEntity("Player"), b);
+
+	b->SetName("Enemy");
+	EXPECT_EQ(structure.GetEntity("Player"), nullptr);
+	EXPECT_EQ(structure.GetEntity("Enemy"), b);
+}
+
+TEST(SpatialTreeTest, QueriesMatchLinearSearch) {
+	SceneStructure structure;
+	std::vector<Transform *> transforms;
+
+	for (int i = 0; i < 1000; i++) {
+		auto entity = structure.CreateEntity();
+		auto transform = entity->AddComponent<Transform>(Vector3f(static_cast<float>(i % 37), static_cast<float>(i % 11), static_cast<float>(i / 37)));
+		transform->SetLocalBounds(Vector3f(-0.5f), Vector3f(0.5f));
+		transforms.emplace_back(transform);
+	}
+
+	auto linearCube = [&](const Vector3f &min, const Vector3f &max) {
+		std::size_t count = 0;
+
+		for (auto transform : transforms) {
+			auto &worldMin = transform->GetWorldMin();
+			auto &worldMax = transform->GetWorldMax();
+
+			if (worldMin.m_x <= max.m_x && min.m_x <= worldMax.m_x && worldMin.m_y <= max.m_y && min.m_y <= worldMax.m_y &&
+				worldMin.m_z <= max.m_z && min.m_z <= worldMax.m_z) {
+				count++;
+			}
+		}
+
+		return count;
+	};
+
+	structure.UpdateBounds();
+	EXPECT_EQ(structure.GetSpatialTree().GetSize(), 1000);
+	// Balanced trees stay close to log2 of the number of boxes.
+	EXPECT_LE(structure.GetSpatialTree().GetHeight(), 20);
+
+	// Boxes are grown by a margin, so the query boxes sit between the grid points.
+	EXPECT_EQ(structure.QueryCube(Vector3f(2.2f, 2.2f, 2.2f), Vector3f(8.8f, 4.8f, 10.8f)).size(), linearCube({2.2f, 2.2f, 2.2f}, {8.8f, 4.8f, 10.8f}));
+	EXPECT_EQ(structure.QuerySphere(Vector3f(10.0f, 6.0f, 10.0f), 0.2f).size(), 1);
+	// Along the x axis at y and z of 0 are the entities 0, 11, 22, and 33.
+	EXPECT_EQ(structure.QueryRay(Vector3f(-5.0f, 0.0f, 0.0f), Vector3f(1.0f, 0.0f, 0.0f), 100.0f).size(), 4);
+	EXPECT_EQ(structure.QueryRay(Vector3f(-5.0f, 0.0f, 0.0f), Vector3f(1.0f, 0.0f, 0.0f), 10.0f).size(), 1);
+
+	// Moved and removed entities follow on the next update.
+	for (int i = 0; i < 1000; i += 2) {
+		transforms[i]->SetLocalPosition(transforms[i]->GetLocalPosition() + Vector3f(0.0f, 100.0f, 0.0f));
+	}
+
+	structure.Remove(transforms[1]->GetEntity());
+	transforms.erase(transforms.begin() + 1);
+	structure.UpdateBounds();
+	EXPECT_EQ(structure.GetSpatialTree().GetSize(), 999);
+	EXPECT_EQ(structure.QueryCube(Vector3f(-1.0f), Vector3f(40.0f, 12.0f, 40.0f)).size(), 499);
+	EXPECT_EQ(structure.QueryCube(Vector3f(-1.0f), Vector3f(40.0f, 12.0f, 40.0f)).size(), linearCube(Vector3f(-1.0f), {40.0f, 12.0f, 40.0f}));
+}
+
+TEST(EntityPrefabTest, InstantiatesCopiesOfTemplates) {
+	auto filename = std::filesystem::temp_directory_path() / "Test_EntityPrefab.json";
+	{
+		auto node = std::make_unique<Json>();
+		(*node)["transform"] << Transform(Vector3f(1.0f, 2.0f, 3.0f));
+		(*node)["velocity"] << Velocity(4.0f);
+		File(filename, std::move(node)).Write();
+	}
+
+	EntityPrefab prefab(filename);
+	EXPECT_EQ(prefab.GetComponentCount(), 2);
+
+	SceneStructure structure;
+	std::vector<Transform> transforms;
+
+	for (int i = 0; i < 100; i++) {
+		transforms.emplace_back(Vector3f(static_cast<float>(i), 0.0f, 0.0f));
+	}
+
+	auto entities = structure.Instantiate(prefab, transforms.size(), transforms.data());
+	ASSERT_EQ(entities.size(), 100);
+	EXPECT_EQ(structure.GetSize(), 100);
+	EXPECT_EQ((structure.GetView<Transform, Velocity>().GetSize()), 100);
+
+	// Transforms are cloned from the template and given their own position, other components are decoded from the node.
+	auto transform = entities[42]->GetComponent<Transform>();
+	EXPECT_EQ(transform->GetLocalPosition(), Vector3f(42.0f, 0.0f, 0.0f));
+	EXPECT_EQ(transform->GetEntity(), entities[42]);
+	EXPECT_EQ(entities[42]->GetComponent<Velocity>()->m_x, 4.0f);
+	EXPECT_NE(transform->m_valid, entities[41]->GetComponent<Transform>()->m_valid);
+
+	auto copy = structure.Instantiate(prefab, 1);
+	EXPECT_EQ(copy.front()->GetComponent<Transform>()->GetLocalPosition(), Vector3f(1.0f, 2.0f, 3.0f));
+
+	std::filesystem::remove(filename);
+}
+
+TEST(EntityPrefabTest, ClonesEngineComponents) {
+	auto filename = std::filesystem::temp_directory_path() / "Test_EntityPrefabPhysics.json";
+	{
+		std::ofstream stream(filename);
+		stream << R"({"mesh": {}, "rigidbody": {"mass": 3, "friction": 0.5, "colliders": [{"type": "sphere", "radius": 2}]}})";
+	}
+
+	EntityPrefab prefab(filename);
+	ASSERT_EQ(prefab.GetComponentCount(), 2);
+
+	SceneStructure structure;
+	auto entities = structure.Instantiate(prefab, 10);
+	ASSERT_EQ(entities.size(), 10);
+	EXPECT_EQ((structure.GetView<Mesh, Rigidbody>().GetSize()), 10);
+
+	// Each instance gets its own colliders, rebuilt from the template dimensions.
+	std::vector<Collider *> colliders;
+
+	for (auto entity : entities) {
+		auto rigidbody = entity->GetComponent<Rigidbody>();
+		ASSERT_NE(rigidbody, nullptr);
+		EXPECT_EQ(rigidbody->GetMass(), 3.0f);
+		EXPECT_EQ(rigidbody->GetFriction(), 0.5f);
+		ASSERT_EQ(rigidbody->GetColliders().size(), 1);
+
+		auto sphere = dynamic_cast<ColliderSphere *>(rigidbody->GetColliders().front().get());
+		ASSERT_NE(sphere, nullptr);
+		EXPECT_EQ(sphere->GetRadius(), 2.0f);
+		EXPECT_EQ(std::find(colliders.begin(), colliders.end(), sphere), colliders.end());
+		colliders.emplace_back(sphere);
+	}
+
+	EXPECT_NE(entities.front()->GetComponent<Mesh>()->Clone(), nullptr);
+	EXPECT_NE(entities.front()->GetComponent<Rigidbody>()->Clone(), nullptr);
+
+	// Snapshots capture the same clones and encode them later.
+	auto buffer = SceneSnapshot(structure).Encode();
+	SceneStructure loaded;
+	ASSERT_TRUE(SceneSnapshot::Load(loaded, buffer.data(), buffer.size()));
+	EXPECT_EQ((loaded.GetView<Mesh, Rigidbody>().GetSize()), 10);
+	auto rigidbody = loaded.QueryAll().front()->GetComponent<Rigidbody>();
+	ASSERT_EQ(rigidbody->GetColliders().size(), 1);
+	EXPECT_EQ(dynamic_cast<ColliderSphere *>(rigidbody->GetColliders().front().get())->GetRadius(), 2.0f);
+
+	std::filesystem::remove(filename);
+}
+
+TEST(SceneSnapshotTest, RoundTripsEntities) {
+	SceneStructure structure;
+
+	for (int i = 0; i < 50; i++) {
+		auto entity = structure.CreateEntity();
+		entity->SetName("Entity" + std::to_string(i % 10));
+		entity->AddComponent<Transform>(Vector3f(static_cast<float>(i), 1.0f, 2.0f));
+
+		if (i % 2 == 0) {
+			entity->AddComponent<Velocity>(static_cast<float>(i) * 0.5f);
+		}
+	}
+
+	SceneSnapshot snapshot(structure);
+	EXPECT_EQ(snapshot.GetEntityCount(), 50);
+
+	// Changes after capturing are not in the snapshot.
+	structure.QueryAll().front()->GetComponent<Transform>()->SetLocalPosition(Vector3f(-1.0f));
+	auto buffer = snapshot.Encode();
+
+	SceneStructure loaded;
+	ASSERT_TRUE(SceneSnapshot::Load(loaded, buffer.data(), buffer.size()));
+	EXPECT_EQ(loaded.GetSize(), 50);
+	EXPECT_EQ(loaded.GetView<Transform>().GetSize(), 50);
+	EXPECT_EQ((loaded.GetView<Transform, Velocity>().GetSize()), 25);
+
+	auto entities = loaded.QueryAll();
+	std::sort(entities.begin(), entities.end(), [](Entity *a, Entity *b) {
+		return a->GetComponent<Transform>()->GetLocalPosition().m_x < b->GetComponent<Transform>()->GetLocalPosition().m_x;
+	});
+	EXPECT_EQ(entities[0]->GetComponent<Transform>()->GetLocalPosition(), Vector3f(0.0f, 1.0f, 2.0f));
+	EXPECT_EQ(entities[14]->GetName(), "Entity4");
+	EXPECT_EQ(entities[14]->GetComponent<Velocity>()->m_x, 7.0f);
+	EXPECT_EQ(entities[15]->GetComponent<Velocity>(), nullptr);
+
+	// A damaged buffer adds nothing.
+	SceneStructure damaged;
+	EXPECT_FALSE(SceneSnapshot::Load(damaged, buffer.data(), buffer.size() / 2));
+	buffer.resize(buffer.size() - 8);
+	auto size = static_cast<uint32_t>(buffer.size());
+	std::memcpy(buffer.data() + 8, &size, sizeof(uint32_t));
+	EXPECT_FALSE(SceneSnapshot::Load(damaged, buffer.data(), buffer.size()));
+	EXPECT_EQ(damaged.GetSize(), 0);
+}
@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+
+#include <Timers/Timers.hpp>
+
+using namespace std::chrono_literals;
+
+/**
+ * Waits until a condition is met, the timeout is generous so a loaded machine does not fail the test.
+ */
+template<typename F>
+static bool WaitFor(F &&condition, std::chrono::milliseconds timeout = 5s) {
+	auto end = std::chrono::steady_clock::now() + timeout;
+
+	while (!condition()) {
+		if (std::chrono::steady_clock::now() > end) {
+			return false;
+		}
+
+		std::this_thread::sleep_for(1ms);
+	}
+
+	return true;
+}
+
+TEST(Timers, repeatAndCancel) {
+	acid::Timers timers;
+	std::atomic<uint32_t> repeats = 0;
+	std::atomic<uint32_t> cancelled = 0;
+
+	auto repeat = timers.Repeat(1ms, 3, [&]() {
+		repeats++;
+	});
+	auto cancel = timers.Once(50ms, [&]() {
+		cancelled++;
+	});
+	cancel.Cancel();
+
+	// A finished timer is released after its last tick, and the cancelled timer is only removed once it is due.
+	ASSERT_TRUE(WaitFor([&]() {
+		return !repeat.IsActive() && timers.GetTimerCount() == 0;
+	}));
+	EXPECT_EQ(repeats, 3u);
+	EXPECT_EQ(cancelled, 0u);
+	EXPECT_FALSE(cancel.IsActive());
+}
+
+TEST(Timers, mainThreadDelivery) {
+	acid::Timers timers;
+	auto mainThread = std::this_thread::get_id();
+	std::atomic<uint32_t> ticks = 0;
+
+	timers.Once(acid::Timer::Delivery::Main, 1ms, [&]() {
+		EXPECT_EQ(std::this_thread::get_id(), mainThread);
+		ticks++;
+	});
+
+	ASSERT_TRUE(WaitFor([&]() {
+		return timers.GetMainTickCount() != 0;
+	}));
+	EXPECT_EQ(ticks, 0u);
+	timers.Update();
+	EXPECT_EQ(ticks, 1u);
+	EXPECT_EQ(timers.GetMainTickCount(), 0u);
+}
@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+
+#include <Maths/Maths.hpp>
+#include <Maths/Transform.hpp>
+
+using namespace acid;
+
+TEST(TransformTest, ChildrenFollowParentChanges) {
+	Transform parent({1.0f, 2.0f, 3.0f}, {}, {2.0f, 2.0f, 2.0f});
+	Transform child({1.0f, 0.0f, 0.0f});
+	child.SetParent(&parent);
+
+	EXPECT_EQ(child.GetPosition(), Vector3f(3.0f, 2.0f, 3.0f));
+	EXPECT_EQ(child.GetScale(), Vector3f(2.0f, 2.0f, 2.0f));
+	EXPECT_FALSE(parent.IsDirty());
+	EXPECT_FALSE(child.IsDirty());
+
+	parent.SetLocalPosition({});
+	EXPECT_TRUE(child.IsDirty());
+	EXPECT_EQ(child.GetPosition(), Vector3f(2.0f, 0.0f, 0.0f));
+
+	child.SetParent(static_cast<Transform *>(nullptr));
+	EXPECT_EQ(child.GetPosition(), Vector3f(1.0f, 0.0f, 0.0f));
+}
+
+TEST(TransformTest, CopiesKeepLocalBounds) {
+	Transform original({1.0f, 0.0f, 0.0f});
+	original.SetLocalBounds({-1.0f, -1.0f, -1.0f}, {1.0f, 1.0f, 1.0f});
+
+	Transform constructed(original);
+	Transform assigned;
+	assigned = original;
+
+	for (const auto &copy : {&constructed, &assigned}) {
+		EXPECT_EQ(copy->GetLocalMin(), original.GetLocalMin());
+		EXPECT_EQ(copy->GetLocalMax(), original.GetLocalMax());
+	}
+}
+
+TEST(TransformTest, UpdateHierarchyCleansSubtree) {
+	Transform root;
+	std::vector<std::unique_ptr<Transform>> chain;
+	auto parent = &root;
+
+	for (int i = 0; i < 8; i++) {
+		auto &transform = chain.emplace_back(std::make_unique<Transform>(Vector3f(1.0f, 0.0f, 0.0f)));
+		transform->SetParent(parent);
+		parent = transform.get();
+	}
+
+	root.UpdateHierarchy();
+
+	for (const auto &transform : chain) {
+		EXPECT_FALSE(transform->IsDirty());
+	}
+
+	EXPECT_EQ(chain.back()->GetPosition(), Vector3f(8.0f, 0.0f, 0.0f));
+
+	// Assigning keeps the hierarchy and dirties everything below.
+	*chain[3] = Transform({2.0f, 0.0f, 0.0f});
+	EXPECT_FALSE(chain[2]->IsDirty());
+	EXPECT_TRUE(chain.back()->IsDirty());
+	chain[3]->UpdateHierarchy();
+	EXPECT_EQ(chain.back()->GetPosition(), Vector3f(9.0f, 0.0f, 0.0f));
+	EXPECT_EQ(chain.back()->GetParent(), chain[6].get());
+}
+
+TEST(TransformTest, InterpolatesAlongShortestArc) {
+	Transform parent({0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, Maths::Radians(359.0f)});
+	Transform child({2.0f, 0.0f, 0.0f});
+	child.SetParent(&parent);
+	parent.StoreSnapshot();
+	child.StoreSnapshot();
+
+	parent.SetLocalRotation({0.0f, 0.0f, Maths::Radians(1.0f)});
+
+	// Halfway between 359 and 1 degrees is 0, not 180.
+	auto matrix = child.GetInterpolatedWorldMatrix(0.5f);
+	auto position = matrix.Transform(Vector4f(0.0f, 0.0f, 0.0f, 1.0f));
+	EXPECT_NEAR(position.m_x, 2.0f, 1e-3f);
+	EXPECT_NEAR(position.m_y, 0.0f, 1e-3f);
+	EXPECT_NEAR(matrix[0][0], 1.0f, 1e-3f);
+
+	// The ends match the snapshot and the current world matrix.
+	auto start = child.GetInterpolatedWorldMatrix(0.0f);
+	parent.SetLocalRotation({0.0f, 0.0f, Maths::Radians(359.0f)});
+
+	for (uint32_t i = 0; i < 4; i++) {
+		for (uint32_t j = 0; j < 4; j++) {
+			EXPECT_NEAR(start[i][j], child.GetWorldMatrix()[i][j], 1e-3f);
+		}
+	}
+
+	EXPECT_EQ(&child.GetInterpolatedWorldMatrix(1.0f), &child.GetWorldMatrix());
+}